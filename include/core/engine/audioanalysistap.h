@@ -0,0 +1,125 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fycore_export.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace Fooyin {
+class AudioBuffer;
+
+/*!
+ * Per-channel levels of one or more played buffers, as linear amplitudes.
+ */
+struct AudioLevels
+{
+    static constexpr int MaxChannels = 20;
+
+    int channelCount{0};
+    int sampleRate{0};
+    std::array<float, MaxChannels> peak{};
+    std::array<float, MaxChannels> rms{};
+};
+
+/*!
+ * Analyses each played buffer once, on the engine thread, for any number of visualisation widgets.
+ * The results of the most recent buffers are published to a lock-free history which readers poll
+ * at their own rate, typically from a paint or update timer, without ever blocking the engine.
+ * A mono downmix of the played samples is also kept for stages such as FFTs which need the signal itself.
+ * Each stage is skipped entirely while it has no readers.
+ */
+class FYCORE_EXPORT AudioAnalysisTap
+{
+public:
+    static constexpr int HistorySize       = 32;
+    static constexpr int SampleHistorySize = 1 << 16;
+
+    AudioAnalysisTap();
+    ~AudioAnalysisTap();
+
+    AudioAnalysisTap(const AudioAnalysisTap&)            = delete;
+    AudioAnalysisTap& operator=(const AudioAnalysisTap&) = delete;
+
+    /** Registers a reader; buffers are only analysed while at least one is registered. */
+    void addReader();
+    void removeReader();
+    [[nodiscard]] bool hasReaders() const;
+
+    /** Registers a reader of the mono sample history. */
+    void addSampleReader();
+    void removeSampleReader();
+
+    /** Analyses @p buffer. Must only be called from a single (engine) thread. */
+    void process(const AudioBuffer& buffer);
+
+    /** Returns the sequence number of the last analysed buffer. */
+    [[nodiscard]] uint64_t sequence() const;
+
+    /*!
+     * Combines the levels of every buffer analysed after @p sequence into @p levels (the maximum of each),
+     * and updates @p sequence to the last buffer read.
+     * Buffers which have already dropped out of the history are skipped.
+     * @returns true if any buffers were read.
+     */
+    bool readSince(uint64_t& sequence, AudioLevels& levels) const;
+
+    /** Returns the total number of mono samples written to the sample history. */
+    [[nodiscard]] uint64_t samplePosition() const;
+    /** Returns the sample rate of the most recently written samples. */
+    [[nodiscard]] int sampleRate() const;
+
+    /*!
+     * Copies up to samples.size() mono samples, starting at @p position, into @p samples.
+     * If the reader has fallen more than SampleHistorySize samples behind, the oldest samples are skipped.
+     * @p position is advanced past the samples read.
+     * @returns the number of samples copied.
+     */
+    size_t readSamples(uint64_t& position, std::span<float> samples) const;
+
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> version{0};
+        std::atomic<int> channelCount{0};
+        std::atomic<int> sampleRate{0};
+        std::array<std::atomic<float>, AudioLevels::MaxChannels> peak{};
+        std::array<std::atomic<float>, AudioLevels::MaxChannels> rms{};
+    };
+
+    bool readSlot(uint64_t sequence, AudioLevels& levels) const;
+    void writeLevels(const AudioBuffer& samples);
+    void writeSamples(const AudioBuffer& samples);
+
+    std::atomic<int> m_readers;
+    std::atomic<uint64_t> m_sequence;
+    std::array<Slot, HistorySize> m_history;
+
+    std::atomic<int> m_sampleReaders;
+    std::atomic<int> m_sampleRate;
+    std::atomic<uint64_t> m_samplePosition;
+    std::atomic<uint64_t> m_sampleWriteEnd;
+    std::unique_ptr<std::atomic<float>[]> m_samples;
+};
+} // namespace Fooyin
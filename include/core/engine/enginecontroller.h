@@ -21,6 +21,7 @@
 
 #include "fycore_export.h"
 
+#include <core/engine/audioanalysistap.h>
 #include <core/engine/audioengine.h>
 #include <core/engine/audiooutput.h>
 
@@ -54,6 +55,12 @@ public:
      */
     virtual void addOutput(const QString& name, OutputCreator output) = 0;
 
+    /*!
+     * Returns the shared analysis of played buffers.
+     * Visualisations should prefer this over analysing bufferPlayed themselves.
+     */
+    [[nodiscard]] virtual AudioAnalysisTap* analysisTap() const = 0;
+
 signals:
     void outputChanged(const QString& output, const QString& device);
     void deviceChanged(const QString& device);
@@ -0,0 +1,106 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fycore_export.h"
+
+#include <core/engine/audioformat.h>
+#include <core/track.h>
+
+#include <QObject>
+
+#include <span>
+
+namespace Fooyin {
+class AudioLoader;
+class LibraryAnalyserPrivate;
+class MusicLibrary;
+class SettingsManager;
+
+/*!
+ * The analysis of a single track by an AnalysisStage.
+ * Created, fed and finished on an analysis thread.
+ */
+class FYCORE_EXPORT TrackAnalysis
+{
+public:
+    virtual ~TrackAnalysis() = default;
+
+    /** Processes the next interleaved frames of the track, in the format passed to AnalysisStage::analyse. */
+    virtual void process(std::span<const float> samples) = 0;
+
+    /*!
+     * Called once the whole track has been decoded.
+     * Only the duration and ReplayGain info of @p track are saved to the library.
+     * @returns true if @p track was modified and should be saved to the library.
+     */
+    virtual bool finish(Track& track) = 0;
+};
+
+/*!
+ * A consumer of decoded audio registered with the LibraryAnalyser.
+ * Every stage is fed from the same decode of each track, so a file is only read once
+ * however many stages need it.
+ */
+class FYCORE_EXPORT AnalysisStage
+{
+public:
+    virtual ~AnalysisStage() = default;
+
+    [[nodiscard]] virtual QString name() const = 0;
+
+    /*!
+     * Returns a new analysis for @p track, decoded as @p format (always SampleFormat::F32),
+     * or nullptr if the track does not need analysing by this stage.
+     * @note this is called from an analysis thread.
+     */
+    [[nodiscard]] virtual std::unique_ptr<TrackAnalysis> analyse(const Track& track, const AudioFormat& format) = 0;
+};
+using AnalysisStagePtr = std::shared_ptr<AnalysisStage>;
+
+/*!
+ * Optional post-scan stage which decodes each newly added library track once and feeds every
+ * registered AnalysisStage from the same buffers. The decoded duration is also verified against
+ * the duration read from the file's tags.
+ * Modified tracks are saved to the library database once analysed.
+ */
+class FYCORE_EXPORT LibraryAnalyser : public QObject
+{
+    Q_OBJECT
+
+public:
+    LibraryAnalyser(std::shared_ptr<AudioLoader> audioLoader, MusicLibrary* library, SettingsManager* settings,
+                    QObject* parent = nullptr);
+    ~LibraryAnalyser() override;
+
+    /** Registers @p stage. Stages must be added before any analysis starts, i.e. when plugins are initialised. */
+    void addStage(const AnalysisStagePtr& stage);
+
+    /** Queues @p tracks for analysis, regardless of the AnalyseNewTracks setting. */
+    void analyseTracks(const TrackList& tracks);
+
+signals:
+    void analysisProgress(int current, int total);
+    void tracksAnalysed(const Fooyin::TrackList& tracks);
+
+private:
+    std::unique_ptr<LibraryAnalyserPrivate> p;
+};
+} // namespace Fooyin
@@ -169,5 +169,7 @@ signals:
     void tracksUpdated(const Fooyin::TrackList& tracks);
     void tracksDeleted(const Fooyin::TrackList& tracks);
     void tracksSorted(const Fooyin::TrackList& tracks);
+
+    void directoriesChanged(const QStringList& dirs);
 };
 } // namespace Fooyin
@@ -24,7 +24,6 @@
 #include <core/scripting/scriptparser.h>
 #include <core/track.h>
 
-#include <QCollator>
 #include <QString>
 
 #include <mutex>
@@ -66,6 +65,37 @@ public:
      */
     static TrackList sortTracks(const TrackList& tracks, Qt::SortOrder order = Qt::AscendingOrder);
 
+    /*!
+     * Calculates the sort order of @p tracks using the @p sort script without modifying them.
+     * @param sort the sort script as a string
+     * @param tracks the tracks to sort
+     * @param order the order in which to sort the tracks
+     * @returns the indexes of @p tracks in sorted order
+     */
+    std::vector<int> sortPermutation(const QString& sort, const TrackList& tracks,
+                                     Qt::SortOrder order = Qt::AscendingOrder);
+
+    /*!
+     * Calculates the sort order of @p tracks using the parsed @p sortScript without modifying them.
+     * @param sortScript the parsed sort script
+     * @param tracks the tracks to sort
+     * @param order the order in which to sort the tracks
+     * @returns the indexes of @p tracks in sorted order
+     */
+    std::vector<int> sortPermutation(const ParsedScript& sortScript, const TrackList& tracks,
+                                     Qt::SortOrder order = Qt::AscendingOrder);
+
+    /*!
+     * Calculates the order of @p sortFields using numeric collation.
+     * Sort keys are generated once per field and large inputs are sorted in parallel.
+     * The sort is stable; equal fields retain their relative order.
+     * @param sortFields the evaluated sort strings
+     * @param order the order in which to sort the fields
+     * @returns the indexes of @p sortFields in sorted order
+     */
+    static std::vector<int> sortPermutation(const std::vector<QString>& sortFields,
+                                            Qt::SortOrder order = Qt::AscendingOrder);
+
     /*!
      * Calculates the sort fields and then sorts @p tracks
      * @param sort the sort script as a string
@@ -126,18 +156,36 @@ public:
         return calculatedTracks;
     }
 
-    template <typename Container, typename SortScript, typename SortExtractor, typename Extractor>
-    Container calcSortTracks(const SortScript& sort, const Container& items, SortExtractor sortExtractor,
-                             Extractor extractor, Qt::SortOrder order = Qt::AscendingOrder)
+    /*!
+     * Evaluates the @p sort script for each of @p items into a separate list,
+     * leaving the tracks untouched.
+     */
+    template <typename Container, typename SortScript, typename Extractor>
+    std::vector<QString> calcSortKeys(const SortScript& sort, const Container& items, Extractor extractor)
     {
-        Container sortedTracks = calcSortFields(sort, items, sortExtractor);
-        sortTracks(sortedTracks, extractor, order);
-        return sortedTracks;
+        std::vector<QString> sortFields;
+        sortFields.reserve(items.size());
+
+        const std::scoped_lock lock{m_parserGuard};
+
+        for(const auto& item : items) {
+            sortFields.push_back(m_parser.evaluate(sort, extractor(item)));
+        }
+
+        return sortFields;
     }
 
-    template <typename Container, typename SortScript, typename SortExtractor, typename Extractor>
+    template <typename Container, typename SortScript, typename Extractor>
+    Container calcSortTracks(const SortScript& sort, const Container& items, Extractor extractor,
+                             Qt::SortOrder order = Qt::AscendingOrder)
+    {
+        const auto permutation = sortPermutation(calcSortKeys(sort, items, extractor), order);
+        return applyPermutation(items, permutation);
+    }
+
+    template <typename Container, typename SortScript, typename Extractor>
     Container calcSortTracks(const SortScript& sortScript, const Container& items, const std::vector<int>& indexes,
-                             SortExtractor sortExtractor, Extractor extractor, Qt::SortOrder order = Qt::AscendingOrder)
+                             Extractor extractor, Qt::SortOrder order = Qt::AscendingOrder)
     {
         Container sortedTracks{items};
         Container tracksToSort;
@@ -150,42 +198,32 @@ public:
             tracksToSort.push_back(items.at(index));
         }
 
-        Container sortedSubTracks = calcSortFields(sortScript, tracksToSort, sortExtractor);
-        sortTracks(sortedSubTracks, extractor, order);
+        const auto permutation = sortPermutation(calcSortKeys(sortScript, tracksToSort, extractor), order);
 
         for(auto i{0}; const int index : validIndexes) {
-            sortedTracks[index] = sortedSubTracks.at(i++);
+            sortedTracks[index] = tracksToSort.at(permutation.at(i++));
         }
 
         return sortedTracks;
     }
 
-private:
-    ParsedScript parseScript(const QString& sort);
-
-    template <typename Container, typename Extractor>
-    static void sortTracks(Container& tracks, Extractor extractor, Qt::SortOrder order = Qt::AscendingOrder)
+    /** Returns a copy of @p items reordered by @p permutation. */
+    template <typename Container>
+    static Container applyPermutation(const Container& items, const std::vector<int>& permutation)
     {
-        QCollator collator;
-        collator.setNumericMode(true);
-
-        std::ranges::stable_sort(tracks, [order, collator, extractor](const auto& lhs, const auto& rhs) {
-            const Track& leftTrack  = extractor(lhs);
-            const Track& rightTrack = extractor(rhs);
+        Container sortedItems;
+        sortedItems.reserve(permutation.size());
 
-            const auto cmp = collator.compare(leftTrack.sort(), rightTrack.sort());
-
-            if(cmp == 0) {
-                return false;
-            }
+        for(const int index : permutation) {
+            sortedItems.push_back(items.at(index));
+        }
 
-            if(order == Qt::AscendingOrder) {
-                return cmp < 0;
-            }
-            return cmp > 0;
-        });
+        return sortedItems;
     }
 
+private:
+    ParsedScript parseScript(const QString& sort);
+
     ScriptParser m_parser;
     std::mutex m_parserGuard;
 };
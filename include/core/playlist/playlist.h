@@ -31,6 +31,10 @@ class PlaylistPrivate;
 struct PlaylistTrack;
 class SettingsManager;
 
+namespace Testing {
+class PlaylistTest;
+} // namespace Testing
+
 using PlaylistTrackList = std::vector<PlaylistTrack>;
 
 struct FYCORE_EXPORT PlaylistTrack
@@ -154,6 +158,7 @@ public:
 private:
     friend class PlaylistHandler;
     friend class PlaylistHandlerPrivate;
+    friend class Testing::PlaylistTest;
 
     static std::unique_ptr<Playlist> create(const QString& name, SettingsManager* settings);
     static std::unique_ptr<Playlist> create(int dbId, const QString& name, int index, SettingsManager* settings);
@@ -170,6 +175,11 @@ private:
     void replaceTracks(const TrackList& tracks);
     void appendTracks(const TrackList& tracks);
     void updateTrackAtIndex(int index, const Track& track);
+    /*!
+     * Replaces any tracks in this playlist which share an id with a track in @p tracks.
+     * @returns the sorted indexes of all tracks which were updated.
+     */
+    std::vector<int> updateTracks(const TrackList& tracks);
     std::vector<int> removeTracks(const std::vector<int>& indexes);
 
     std::unique_ptr<PlaylistPrivate> p;
@@ -24,6 +24,7 @@
 namespace Fooyin {
 class AudioLoader;
 class EngineController;
+class LibraryAnalyser;
 class LibraryManager;
 class MusicLibrary;
 class NetworkAccessManager;
@@ -40,7 +41,7 @@ struct CorePluginContext
     CorePluginContext(EngineController* engine_, PlayerController* playerController_, LibraryManager* libraryManager_,
                       MusicLibrary* library_, PlaylistHandler* playlistHandler_, SettingsManager* settingsManager_,
                       std::shared_ptr<AudioLoader> audioLoader_, SortingRegistry* sortingRegistry_,
-                      std::shared_ptr<NetworkAccessManager> networkAccess_)
+                      std::shared_ptr<NetworkAccessManager> networkAccess_, LibraryAnalyser* libraryAnalyser_)
         : playerController{playerController_}
         , libraryManager{libraryManager_}
         , library{library_}
@@ -50,6 +51,7 @@ struct CorePluginContext
         , audioLoader{std::move(audioLoader_)}
         , sortingRegistry{sortingRegistry_}
         , networkAccess{std::move(networkAccess_)}
+        , libraryAnalyser{libraryAnalyser_}
     { }
 
     PlayerController* playerController;
@@ -61,5 +63,6 @@ struct CorePluginContext
     std::shared_ptr<AudioLoader> audioLoader;
     SortingRegistry* sortingRegistry;
     std::shared_ptr<NetworkAccessManager> networkAccess;
+    LibraryAnalyser* libraryAnalyser;
 };
 } // namespace Fooyin
@@ -66,6 +66,8 @@ struct FuncValue
 {
     QString name;
     ExpressionList args;
+    // Source text of the call, identifying identical calls across scripts
+    QString source;
 };
 
 using ExpressionValue = std::variant<QString, FuncValue, ExpressionList>;
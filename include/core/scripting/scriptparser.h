@@ -39,6 +39,27 @@ struct ScriptError
 };
 using ErrorList = std::vector<ScriptError>;
 
+struct ScriptCacheStats
+{
+    uint64_t hits{0};
+    uint64_t misses{0};
+    uint64_t evictions{0};
+    size_t entries{0};
+    size_t memoryUsage{0};
+};
+
+struct ScriptMemoStats
+{
+    uint64_t hits{0};
+    uint64_t misses{0};
+
+    [[nodiscard]] double hitRate() const
+    {
+        const uint64_t total = hits + misses;
+        return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
+};
+
 struct ParsedScript
 {
     QString input;
@@ -82,10 +103,31 @@ public:
     PlaylistTrackList filter(const QString& input, const PlaylistTrackList& tracks);
     PlaylistTrackList filter(const ParsedScript& input, const PlaylistTrackList& tracks);
 
+    /*!
+     * Scripts are cached in a process-wide cache shared by all parsers.
+     * Queries may depend on the current date, so are cached per parser instead,
+     * and these functions only apply to that cache.
+     */
     [[nodiscard]] int cacheLimit() const;
     void setCacheLimit(int limit);
     void clearCache();
 
+    /** Returns usage statistics of the script cache shared by all parsers. */
+    static ScriptCacheStats sharedCacheStats();
+    /** Sets the approximate memory budget in bytes of the script cache shared by all parsers. */
+    static void setSharedCacheMemoryLimit(size_t bytes);
+
+    /*!
+     * Caches the results of function calls evaluated for a single track, so identical
+     * calls shared between scripts (e.g. columns and group headers) are only evaluated once.
+     * Results are discarded when a different track is evaluated or @fn clearMemo is called.
+     * @note calls depending on player or registry state are never cached.
+     */
+    void setMemoiseFunctions(bool enabled);
+    void clearMemo();
+    [[nodiscard]] ScriptMemoStats memoStats() const;
+    void resetMemoStats();
+
 private:
     std::unique_ptr<ScriptParserPrivate> p;
 };
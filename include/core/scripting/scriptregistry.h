@@ -47,6 +47,10 @@ public:
     [[nodiscard]] virtual bool isVariable(const QString& var, const Track& track) const;
     [[nodiscard]] virtual bool isVariable(const QString& var, const TrackList& tracks) const;
     [[nodiscard]] virtual bool isFunction(const QString& func) const;
+    /** Returns @c true if the value of @p var depends on player or registry state rather than just the track. */
+    [[nodiscard]] virtual bool isStateVariable(const QString& var) const;
+    /** Returns @c true if @p func may return a different result for the same arguments. */
+    [[nodiscard]] virtual bool isStateFunction(const QString& func) const;
 
     [[nodiscard]] virtual ScriptResult value(const QString& var, const Track& track) const;
     [[nodiscard]] virtual ScriptResult value(const QString& var, const TrackList& tracks) const;
@@ -105,10 +105,22 @@ public:
     [[nodiscard]] QPixmap trackCoverThumbnail(const Track& track, const QSize& size,
                                               Track::Cover type = Track::Cover::Front) const;
 
+    /*!
+     * Cancels covers requested through this provider which haven't started loading yet.
+     * Views should call this when scrolled and then repaint, so covers which are still visible
+     * are requested again ahead of those which scrolled out of view.
+     * @returns true if any requests were cancelled.
+     */
+    bool cancelPendingRequests();
+
     /** Returns an equivalent thumbnail size for the given @p size */
     static ThumbnailSize findThumbnailSize(const QSize& size);
     /** Clears the QPixmapCache as well as the on-disk cache. */
     static void clearCache();
+    /** Forgets which covers were found in @p dirs, so they are searched again on the next request. */
+    static void invalidateDirectories(const QStringList& dirs);
+    /** Forgets which covers were found in @p root and every directory below it. */
+    static void invalidateDirectoryTree(const QString& root);
     /** Removes all covers of the @p track from the cache. */
     static void removeFromCache(const Track& track);
 
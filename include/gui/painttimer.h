@@ -0,0 +1,45 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fygui_export.h"
+
+#include <chrono>
+
+namespace Fooyin {
+/*!
+ * Times a widget's paint pass for the GUI stall detector.
+ * Create one at the start of paintEvent; it does nothing unless stall detection is enabled.
+ */
+class FYGUI_EXPORT PaintTimer
+{
+public:
+    explicit PaintTimer(const char* widget);
+    ~PaintTimer();
+
+    PaintTimer(const PaintTimer&)            = delete;
+    PaintTimer& operator=(const PaintTimer&) = delete;
+
+private:
+    const char* m_widget;
+    std::chrono::steady_clock::time_point m_start;
+    bool m_active;
+};
+} // namespace Fooyin
@@ -21,7 +21,31 @@
 
 #include "fyutils_export.h"
 
+#include <algorithm>
+#include <limits>
+#include <span>
+
 namespace Fooyin::Audio {
 FYUTILS_EXPORT double dbToVolume(double db);
 FYUTILS_EXPORT double volumeToDb(double volume);
+
+struct ChannelStats
+{
+    float min{std::numeric_limits<float>::max()};
+    float max{std::numeric_limits<float>::lowest()};
+    double sumSquares{0.0};
+
+    [[nodiscard]] float peak() const
+    {
+        return min > max ? 0.0F : std::max(-min, max);
+    }
+};
+
+/*!
+ * Accumulates the min, max and sum of squares of each channel of interleaved F32 @p samples into @p stats.
+ * All channels are processed in a single pass; the samples are folded into independent lanes so the
+ * inner loop vectorises without relying on floating point reassociation.
+ * @note @p samples should contain whole frames, and @p stats must hold at least @p channels entries.
+ */
+FYUTILS_EXPORT void accumulateFrames(std::span<const float> samples, int channels, std::span<ChannelStats> stats);
 } // namespace Fooyin::Audio
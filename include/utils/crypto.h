@@ -30,6 +30,34 @@ namespace Fooyin {
 using Md5Hash = QByteArray;
 
 namespace Utils {
+/*!
+ * Fast, non-cryptographic 128-bit hash for keys which only need to be unique within
+ * the application, such as tree node keys. Input isn't converted to UTF-8 first.
+ */
+class FYUTILS_EXPORT FastHash
+{
+public:
+    void addData(QByteArrayView data);
+    [[nodiscard]] QByteArray result() const;
+
+private:
+    void round(uint64_t word);
+
+    uint64_t m_lo{0x9E3779B185EBCA87ULL};
+    uint64_t m_hi{0xC2B2AE3D27D4EB4FULL};
+    uint64_t m_length{0};
+};
+
+inline void addDataToHash(FastHash& hash, const QString& arg)
+{
+    hash.addData(QByteArrayView{reinterpret_cast<const char*>(arg.utf16()), arg.size() * 2});
+}
+
+inline void addDataToHash(FastHash& hash, const QByteArray& arg)
+{
+    hash.addData(arg);
+}
+
 template <typename T>
 void addDataToHash(QCryptographicHash& hash, const T& arg)
 {
@@ -59,6 +87,14 @@ Md5Hash generateMd5Hash(const Args&... args)
     return hash.result();
 }
 
+template <typename... Args>
+Md5Hash generateFastHash(const Args&... args)
+{
+    FastHash hash;
+    (addDataToHash(hash, args), ...);
+    return hash.result();
+}
+
 FYUTILS_EXPORT QString generateUniqueHash();
 } // namespace Utils
 } // namespace Fooyin
@@ -0,0 +1,137 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fyutils_export.h"
+
+#include <QString>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace Fooyin {
+class IoSchedulerPrivate;
+
+/*!
+ * Arbitrates disk access between the library scanner, analysis, artwork loading and file operations.
+ *
+ * Requests are grouped by the mount they touch, and each mount has a concurrency limit based on
+ * whether it is backed by solid state, rotational or network storage. When a slot frees up,
+ * waiting requests are started in path and inode order (an elevator) so reads on rotational
+ * disks stay sequential rather than thrashing between files.
+ *
+ * Playback requests never wait. While playback is reading from a rotational or network mount,
+ * background requests share it on a duty cycle: a background holder gives up its slot at the first
+ * Lease::yield() after a short slice, and no background request starts again until playback has had
+ * the mount to itself for a short window. Long-running holders should call Lease::yield() between reads so playback and
+ * waiting higher priority requests can run.
+ *
+ * @note a thread must not hold more than one lease on the same mount, as the second may never be granted.
+ */
+class FYUTILS_EXPORT IoScheduler
+{
+public:
+    enum class Priority : uint8_t
+    {
+        Playback = 0,
+        Interactive,
+        Background,
+    };
+
+    enum class StorageType : uint8_t
+    {
+        Solid = 0,
+        Rotational,
+        Network,
+    };
+
+    using CancelCheck = std::function<bool()>;
+
+    /*!
+     * Grants access to a mount until released or destroyed.
+     */
+    class FYUTILS_EXPORT Lease
+    {
+    public:
+        Lease() = default;
+        ~Lease();
+
+        Lease(const Lease&)            = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+
+        [[nodiscard]] bool isValid() const;
+
+        /*!
+         * Gives up the slot if a higher priority request is waiting on the same mount (or, for background
+         * requests, playback is reading from a rotational or network mount), and blocks until it can be reacquired.
+         * @returns false if @p cancelled returned true while waiting, leaving the lease invalid.
+         */
+        bool yield(const CancelCheck& cancelled = {});
+        void release();
+
+    private:
+        friend class IoScheduler;
+
+        Lease(IoSchedulerPrivate* scheduler, int mount, Priority priority, QString path);
+
+        IoSchedulerPrivate* m_scheduler{nullptr};
+        int m_mount{-1};
+        Priority m_priority{Priority::Background};
+        QString m_path;
+        std::chrono::steady_clock::time_point m_granted;
+    };
+
+    IoScheduler();
+    ~IoScheduler();
+
+    IoScheduler(const IoScheduler&)            = delete;
+    IoScheduler& operator=(const IoScheduler&) = delete;
+
+    /** Returns the scheduler shared by the whole application. */
+    static IoScheduler* instance();
+
+    /*!
+     * Blocks until @p path may be read or written with @p priority.
+     * @returns an invalid lease if @p cancelled returned true while waiting.
+     */
+    [[nodiscard]] Lease acquire(const QString& path, Priority priority = Priority::Background,
+                                const CancelCheck& cancelled = {});
+
+    [[nodiscard]] QString mountPoint(const QString& path) const;
+    [[nodiscard]] StorageType storageType(const QString& path) const;
+    /** Returns the number of requests which may access the mount of @p path at once. */
+    [[nodiscard]] int concurrency(const QString& path) const;
+    /** Returns the number of requests currently waiting for the mount of @p path. */
+    [[nodiscard]] int waiting(const QString& path) const;
+
+    /** Overrides the detected storage type of the mount at @p mountPoint. */
+    void setMountStorageType(const QString& mountPoint, StorageType type);
+    /** Overrides the default concurrency of all mounts of @p type. A @p limit of 0 restores the default. */
+    void setConcurrency(StorageType type, int limit);
+    /** Overrides the concurrency of the mount at @p mountPoint. A @p limit of 0 removes the override. */
+    void setMountConcurrency(const QString& mountPoint, int limit);
+
+private:
+    std::unique_ptr<IoSchedulerPrivate> p;
+};
+} // namespace Fooyin
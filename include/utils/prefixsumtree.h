@@ -0,0 +1,138 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <vector>
+
+namespace Fooyin {
+/*!
+ * Fenwick (binary indexed) tree over a sequence of non-negative values.
+ * Point updates, prefix sums and position lookups are all O(log n).
+ */
+class PrefixSumTree
+{
+public:
+    PrefixSumTree() = default;
+
+    explicit PrefixSumTree(const std::vector<int>& values)
+    {
+        build(values);
+    }
+
+    /** Replaces the contents with @p values in O(n). */
+    void build(const std::vector<int>& values)
+    {
+        m_values = values;
+        m_tree.assign(values.size() + 1, 0);
+
+        const std::size_t count = m_tree.size();
+        for(std::size_t i{1}; i < count; ++i) {
+            m_tree[i] += values[i - 1];
+            const std::size_t parent = i + (i & -i);
+            if(parent < count) {
+                m_tree[parent] += m_tree[i];
+            }
+        }
+    }
+
+    void clear()
+    {
+        m_values.clear();
+        m_tree.clear();
+    }
+
+    [[nodiscard]] int size() const
+    {
+        return static_cast<int>(m_values.size());
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_values.empty();
+    }
+
+    [[nodiscard]] int value(int index) const
+    {
+        return m_values.at(index);
+    }
+
+    void set(int index, int value)
+    {
+        const int delta = value - m_values.at(index);
+        if(delta == 0) {
+            return;
+        }
+
+        m_values[index] = value;
+
+        const std::size_t count = m_tree.size();
+        for(auto i = static_cast<std::size_t>(index) + 1; i < count; i += (i & -i)) {
+            m_tree[i] += delta;
+        }
+    }
+
+    /** Returns the sum of the first @p count values. */
+    [[nodiscard]] int prefix(int count) const
+    {
+        int sum{0};
+        for(auto i = static_cast<std::size_t>(std::min(count, size())); i > 0; i -= (i & -i)) {
+            sum += m_tree[i];
+        }
+        return sum;
+    }
+
+    [[nodiscard]] int total() const
+    {
+        return prefix(size());
+    }
+
+    /*!
+     * Returns the index of the value covering @p position, i.e. the first index
+     * whose running total exceeds it, or -1 if @p position is beyond the total.
+     */
+    [[nodiscard]] int indexAt(int position) const
+    {
+        const std::size_t count = m_values.size();
+        if(count == 0) {
+            return -1;
+        }
+
+        std::size_t index{0};
+        int remaining{position};
+
+        for(std::size_t step = std::bit_floor(count); step > 0; step >>= 1) {
+            const std::size_t next = index + step;
+            if(next <= count && m_tree[next] <= remaining) {
+                index = next;
+                remaining -= m_tree[next];
+            }
+        }
+
+        return index < count ? static_cast<int>(index) : -1;
+    }
+
+private:
+    std::vector<int> m_values;
+    std::vector<int> m_tree;
+};
+} // namespace Fooyin
@@ -0,0 +1,133 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <unordered_map>
+#include <vector>
+
+namespace Fooyin {
+/*!
+ * The rows which change when turning one sequence into another.
+ * Removing @c removed from the old sequence and then inserting @c inserted
+ * (in ascending order) yields the new sequence.
+ */
+struct SequenceDiff
+{
+    std::vector<int> removed;  // Indexes into the old sequence, ascending
+    std::vector<int> inserted; // Indexes into the new sequence, ascending
+
+    [[nodiscard]] bool empty() const
+    {
+        return removed.empty() && inserted.empty();
+    }
+
+    /** Returns the number of contiguous runs in @p indexes. */
+    [[nodiscard]] static int rangeCount(const std::vector<int>& indexes)
+    {
+        int count{0};
+        for(std::size_t i{0}; i < indexes.size(); ++i) {
+            if(i == 0 || indexes[i] != indexes[i - 1] + 1) {
+                ++count;
+            }
+        }
+        return count;
+    }
+};
+
+/*!
+ * Diffs two sequences of unique keys in O(n log n).
+ * Items common to both are kept in place if they form part of the longest run in
+ * matching relative order; all other common items are reported as a remove and insert (a move).
+ */
+template <typename Key, typename Hash = std::hash<Key>>
+SequenceDiff diffSequences(const std::vector<Key>& oldKeys, const std::vector<Key>& newKeys)
+{
+    SequenceDiff diff;
+
+    std::unordered_map<Key, int, Hash> newPositions;
+    newPositions.reserve(newKeys.size());
+    for(int i{0}; const Key& key : newKeys) {
+        newPositions.emplace(key, i++);
+    }
+
+    // Positions in the new sequence of each common item, in old order
+    std::vector<int> commonOld;
+    std::vector<int> commonNew;
+    for(int i{0}; const Key& key : oldKeys) {
+        const auto it = newPositions.find(key);
+        if(it == newPositions.cend()) {
+            diff.removed.push_back(i);
+        }
+        else {
+            commonOld.push_back(i);
+            commonNew.push_back(it->second);
+        }
+        ++i;
+    }
+
+    // Longest increasing subsequence of commonNew (patience sorting)
+    const auto commonCount = static_cast<int>(commonNew.size());
+    std::vector<int> tails;
+    std::vector<int> previous(commonNew.size(), -1);
+
+    for(int i{0}; i < commonCount; ++i) {
+        const auto tail = std::lower_bound(tails.cbegin(), tails.cend(), commonNew[i],
+                                           [&commonNew](int index, int value) { return commonNew[index] < value; });
+        const auto pos  = static_cast<std::size_t>(tail - tails.cbegin());
+        if(pos > 0) {
+            previous[i] = tails[pos - 1];
+        }
+        if(pos == tails.size()) {
+            tails.push_back(i);
+        }
+        else {
+            tails[pos] = i;
+        }
+    }
+
+    std::vector<bool> kept(commonNew.size(), false);
+    for(int i = tails.empty() ? -1 : tails.back(); i >= 0; i = previous[i]) {
+        kept[i] = true;
+    }
+
+    std::vector<bool> newKept(newKeys.size(), false);
+    for(int i{0}; i < commonCount; ++i) {
+        if(kept[i]) {
+            newKept[commonNew[i]] = true;
+        }
+        else {
+            diff.removed.push_back(commonOld[i]);
+        }
+    }
+    std::ranges::sort(diff.removed);
+
+    for(int i{0}; std::cmp_less(i, newKeys.size()); ++i) {
+        if(!newKept[i]) {
+            diff.inserted.push_back(i);
+        }
+    }
+
+    return diff;
+}
+} // namespace Fooyin
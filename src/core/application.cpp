@@ -40,12 +40,15 @@
 #include <core/coresettings.h>
 #include <core/engine/audioloader.h>
 #include <core/engine/outputplugin.h>
+#include <core/library/libraryanalyser.h>
 #include <core/network/networkaccessmanager.h>
 #include <core/player/playercontroller.h>
 #include <core/playlist/playlisthandler.h>
 #include <core/plugins/coreplugin.h>
+#include <core/scripting/scriptparser.h>
 #include <utils/database/dbconnectionprovider.h>
 #include <utils/enum.h>
+#include <utils/ioscheduler.h>
 #include <utils/settings/settingsmanager.h>
 
 #include <QBasicTimer>
@@ -104,6 +107,8 @@ public:
 
     void loadDatabaseSettings() const;
     void saveDatabaseSettings() const;
+    void loadIoSettings() const;
+    void loadScriptSettings() const;
 
     Application* m_self;
 
@@ -120,6 +125,7 @@ public:
     PlaylistHandler* m_playlistHandler;
     SortingRegistry* m_sortingRegistry;
     std::shared_ptr<NetworkAccessManager> m_networkManager;
+    LibraryAnalyser* m_libraryAnalyser;
 
     PluginManager m_pluginManager;
     CorePluginContext m_corePluginContext;
@@ -145,12 +151,17 @@ ApplicationPrivate::ApplicationPrivate(Application* self_)
                                             m_settings, m_self)}
     , m_sortingRegistry{new SortingRegistry(m_settings, m_self)}
     , m_networkManager{new NetworkAccessManager(m_settings, m_self)}
+    , m_libraryAnalyser{new LibraryAnalyser(m_audioLoader, m_library, m_settings, m_self)}
     , m_pluginManager{m_settings}
-    , m_corePluginContext{&m_engine,  m_playerController, m_libraryManager,  m_library,       m_playlistHandler,
-                          m_settings, m_audioLoader,      m_sortingRegistry, m_networkManager}
+    , m_corePluginContext{&m_engine,        m_playerController, m_libraryManager,
+                          m_library,        m_playlistHandler,  m_settings,
+                          m_audioLoader,    m_sortingRegistry,  m_networkManager,
+                          m_libraryAnalyser}
 {
     m_translations.initialiseTranslations(m_settings->value<Settings::Core::Language>());
     loadDatabaseSettings();
+    loadIoSettings();
+    loadScriptSettings();
 }
 
 void ApplicationPrivate::initialise()
@@ -402,6 +413,35 @@ void ApplicationPrivate::saveDatabaseSettings() const
     settingsDb.set(u"Version"_s, QString::fromLatin1(VERSION));
 }
 
+void ApplicationPrivate::loadIoSettings() const
+{
+    using namespace Settings::Core::Internal;
+
+    // Not exposed in the UI; these only exist to correct storage which is misdetected
+    auto* scheduler = IoScheduler::instance();
+
+    scheduler->setConcurrency(IoScheduler::StorageType::Solid, m_settings->fileValue(IoSolidConcurrency, 0).toInt());
+    scheduler->setConcurrency(IoScheduler::StorageType::Rotational,
+                              m_settings->fileValue(IoRotationalConcurrency, 0).toInt());
+    scheduler->setConcurrency(IoScheduler::StorageType::Network,
+                              m_settings->fileValue(IoNetworkConcurrency, 0).toInt());
+
+    const auto mounts = m_settings->fileValue(IoMountConcurrency).toMap();
+    for(auto it = mounts.cbegin(); it != mounts.cend(); ++it) {
+        scheduler->setMountConcurrency(it.key(), it.value().toInt());
+    }
+}
+
+void ApplicationPrivate::loadScriptSettings() const
+{
+    using namespace Settings::Core::Internal;
+
+    // Not exposed in the UI; the budget (in MiB) of the script cache shared by all parsers
+    if(const int limit = m_settings->fileValue(ScriptCacheMemoryLimit, 0).toInt(); limit > 0) {
+        ScriptParser::setSharedCacheMemoryLimit(static_cast<size_t>(limit) * 1024 * 1024);
+    }
+}
+
 Application::Application(QObject* parent)
     : QObject{parent}
     , p{std::make_unique<ApplicationPrivate>(this)}
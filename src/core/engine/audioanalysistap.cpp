@@ -0,0 +1,256 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/engine/audioanalysistap.h>
+
+#include <core/engine/audiobuffer.h>
+#include <core/engine/audioconverter.h>
+#include <utils/audioutils.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Fooyin {
+AudioAnalysisTap::AudioAnalysisTap()
+    : m_readers{0}
+    , m_sequence{0}
+    , m_sampleReaders{0}
+    , m_sampleRate{0}
+    , m_samplePosition{0}
+    , m_sampleWriteEnd{0}
+    , m_samples{std::make_unique<std::atomic<float>[]>(SampleHistorySize)}
+{ }
+
+AudioAnalysisTap::~AudioAnalysisTap() = default;
+
+void AudioAnalysisTap::addReader()
+{
+    m_readers.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioAnalysisTap::removeReader()
+{
+    m_readers.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool AudioAnalysisTap::hasReaders() const
+{
+    return m_readers.load(std::memory_order_relaxed) > 0;
+}
+
+void AudioAnalysisTap::addSampleReader()
+{
+    m_sampleReaders.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioAnalysisTap::removeSampleReader()
+{
+    m_sampleReaders.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void AudioAnalysisTap::process(const AudioBuffer& buffer)
+{
+    const bool levels  = hasReaders();
+    const bool samples = m_sampleReaders.load(std::memory_order_relaxed) > 0;
+
+    if((!levels && !samples) || !buffer.isValid()) {
+        return;
+    }
+
+    AudioFormat format = buffer.format();
+    const int channels = format.channelCount();
+    if(channels <= 0 || channels > AudioLevels::MaxChannels || buffer.frameCount() <= 0) {
+        return;
+    }
+
+    AudioBuffer floatBuffer;
+    if(format.sampleFormat() != SampleFormat::F32) {
+        format.setSampleFormat(SampleFormat::F32);
+        floatBuffer = Audio::convert(buffer, format);
+        if(!floatBuffer.isValid()) {
+            return;
+        }
+    }
+    const AudioBuffer& floatSamples = floatBuffer.isValid() ? floatBuffer : buffer;
+
+    if(levels) {
+        writeLevels(floatSamples);
+    }
+    if(samples) {
+        writeSamples(floatSamples);
+    }
+}
+
+uint64_t AudioAnalysisTap::sequence() const
+{
+    return m_sequence.load(std::memory_order_acquire);
+}
+
+bool AudioAnalysisTap::readSince(uint64_t& sequence, AudioLevels& levels) const
+{
+    const uint64_t latest = m_sequence.load(std::memory_order_acquire);
+    if(latest <= sequence) {
+        return false;
+    }
+
+    const uint64_t oldest = latest >= HistorySize ? latest - HistorySize + 1 : 1;
+
+    bool read{false};
+    for(uint64_t current{std::max(sequence + 1, oldest)}; current <= latest; ++current) {
+        read |= readSlot(current, levels);
+    }
+
+    sequence = latest;
+    return read;
+}
+
+uint64_t AudioAnalysisTap::samplePosition() const
+{
+    return m_samplePosition.load(std::memory_order_acquire);
+}
+
+int AudioAnalysisTap::sampleRate() const
+{
+    return m_sampleRate.load(std::memory_order_relaxed);
+}
+
+size_t AudioAnalysisTap::readSamples(uint64_t& position, std::span<float> samples) const
+{
+    const uint64_t latest = m_samplePosition.load(std::memory_order_acquire);
+    if(latest <= position) {
+        return 0;
+    }
+
+    if(latest - position > SampleHistorySize) {
+        position = latest - SampleHistorySize;
+    }
+
+    size_t count = std::min(static_cast<size_t>(latest - position), samples.size());
+    for(size_t i{0}; i < count; ++i) {
+        samples[i] = m_samples[(position + i) % SampleHistorySize].load(std::memory_order_relaxed);
+    }
+
+    // Drop any samples the engine overwrote while we were copying
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t current = m_sampleWriteEnd.load(std::memory_order_relaxed);
+    if(current > position + SampleHistorySize) {
+        const auto overwritten = std::min(static_cast<size_t>(current - position - SampleHistorySize), count);
+        std::copy(samples.begin() + static_cast<std::ptrdiff_t>(overwritten),
+                  samples.begin() + static_cast<std::ptrdiff_t>(count), samples.begin());
+        position += overwritten;
+        count -= overwritten;
+    }
+
+    position += count;
+    return count;
+}
+
+void AudioAnalysisTap::writeLevels(const AudioBuffer& samples)
+{
+    const AudioFormat format = samples.format();
+    const int channels       = format.channelCount();
+    const int frames         = samples.frameCount();
+
+    const std::span<const float> data{reinterpret_cast<const float*>(samples.data()),
+                                      static_cast<size_t>(samples.sampleCount())};
+
+    std::array<Audio::ChannelStats, AudioLevels::MaxChannels> stats;
+    Audio::accumulateFrames(data, channels, stats);
+
+    const uint64_t sequence = m_sequence.load(std::memory_order_relaxed) + 1;
+    Slot& slot              = m_history.at(sequence % HistorySize);
+
+    // Seqlock: an odd version marks the slot as being written
+    slot.version.store((sequence * 2) - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.channelCount.store(channels, std::memory_order_relaxed);
+    slot.sampleRate.store(format.sampleRate(), std::memory_order_relaxed);
+    for(int channel{0}; channel < channels; ++channel) {
+        const auto& channelStats = stats.at(channel);
+        const auto meanSquare    = channelStats.sumSquares / static_cast<double>(frames);
+        slot.peak.at(channel).store(channelStats.peak(), std::memory_order_relaxed);
+        slot.rms.at(channel).store(static_cast<float>(std::sqrt(meanSquare)), std::memory_order_relaxed);
+    }
+
+    slot.version.store(sequence * 2, std::memory_order_release);
+    m_sequence.store(sequence, std::memory_order_release);
+}
+
+void AudioAnalysisTap::writeSamples(const AudioBuffer& samples)
+{
+    const int channels = samples.format().channelCount();
+    const int skipped  = std::max(0, samples.frameCount() - SampleHistorySize);
+    const int frames   = samples.frameCount() - skipped;
+    const auto* data   = reinterpret_cast<const float*>(samples.data()) + static_cast<ptrdiff_t>(skipped) * channels;
+    const float scale  = 1.0F / static_cast<float>(channels);
+
+    const uint64_t position = m_samplePosition.load(std::memory_order_relaxed);
+
+    // Readers compare against this to detect samples overwritten while they were copying
+    m_sampleWriteEnd.store(position + frames, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for(int frame{0}; frame < frames; ++frame) {
+        const float* frameData = data + static_cast<ptrdiff_t>(frame) * channels;
+
+        float sum{0.0F};
+        for(int channel{0}; channel < channels; ++channel) {
+            sum += frameData[channel];
+        }
+        m_samples[(position + frame) % SampleHistorySize].store(sum * scale, std::memory_order_relaxed);
+    }
+
+    m_sampleRate.store(samples.format().sampleRate(), std::memory_order_relaxed);
+    m_samplePosition.store(position + frames, std::memory_order_release);
+}
+
+bool AudioAnalysisTap::readSlot(uint64_t sequence, AudioLevels& levels) const
+{
+    const Slot& slot = m_history.at(sequence % HistorySize);
+
+    const uint64_t version = slot.version.load(std::memory_order_acquire);
+    if(version != sequence * 2) {
+        // Being written, or already overwritten by a newer buffer
+        return false;
+    }
+
+    AudioLevels slotLevels;
+    slotLevels.channelCount = slot.channelCount.load(std::memory_order_relaxed);
+    slotLevels.sampleRate   = slot.sampleRate.load(std::memory_order_relaxed);
+    for(int channel{0}; channel < slotLevels.channelCount; ++channel) {
+        slotLevels.peak.at(channel) = slot.peak.at(channel).load(std::memory_order_relaxed);
+        slotLevels.rms.at(channel)  = slot.rms.at(channel).load(std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(slot.version.load(std::memory_order_relaxed) != version) {
+        return false;
+    }
+
+    levels.channelCount = slotLevels.channelCount;
+    levels.sampleRate   = slotLevels.sampleRate;
+    for(int channel{0}; channel < slotLevels.channelCount; ++channel) {
+        levels.peak.at(channel) = std::max(levels.peak.at(channel), slotLevels.peak.at(channel));
+        levels.rms.at(channel)  = std::max(levels.rms.at(channel), slotLevels.rms.at(channel));
+    }
+
+    return true;
+}
+} // namespace Fooyin
@@ -351,6 +351,7 @@ void AudioPlaybackEngine::pause()
     const auto pauseEngine = [this](const uint64_t delay) {
         QTimer::singleShot(delay, this, [this]() {
             m_bufferTimer.stop();
+            m_ioLease.release();
             if(playbackState() != PlaybackState::Stopped) {
                 updateState(PlaybackState::Paused);
             }
@@ -555,6 +556,7 @@ AudioFormat AudioPlaybackEngine::loadPreparedTrack()
 void AudioPlaybackEngine::resetWorkers(bool resetFade)
 {
     m_bufferTimer.stop();
+    m_ioLease.release();
     m_clock.setPaused(true);
     QMetaObject::invokeMethod(&m_renderer, [this, resetFade]() { m_renderer.reset(resetFade); });
     m_totalBufferTime = 0;
@@ -565,6 +567,7 @@ void AudioPlaybackEngine::stopWorkers(bool full)
     m_bufferTimer.stop();
     m_posTimer.stop();
     m_bitrateTimer.stop();
+    m_ioLease.release();
 
     m_clock.setPaused(true);
     m_clock.sync();
@@ -685,7 +688,13 @@ void AudioPlaybackEngine::readNextBuffer()
         = std::min(bytesToEnd, static_cast<size_t>(m_format.bytesForDuration(m_bufferLength - m_totalBufferTime)));
     const auto maxBytes = std::min(bytesLeft, static_cast<size_t>(m_format.bytesForDuration(MaxDecodeLength)));
 
-    const auto buffer = m_decoder->readBuffer(maxBytes);
+    // Held until the track is decoded (or playback pauses/stops) rather than taken for every buffer
+    if(!m_ioLease.isValid()) {
+        m_ioLease = IoScheduler::instance()->acquire(m_currentTrack.filepath(), IoScheduler::Priority::Playback);
+    }
+
+    const AudioBuffer buffer = m_decoder->readBuffer(maxBytes);
+
     if(buffer.isValid()) {
         m_totalBufferTime += buffer.duration();
         QMetaObject::invokeMethod(&m_renderer, [this, buffer]() { m_renderer.queueBuffer(buffer); });
@@ -695,6 +704,7 @@ void AudioPlaybackEngine::readNextBuffer()
 
     if(!buffer.isValid() || endOfCueTrack) {
         m_bufferTimer.stop();
+        m_ioLease.release();
         QMetaObject::invokeMethod(&m_renderer, [this]() { m_renderer.queueBuffer({}); });
         m_ending = true;
         emit trackAboutToFinish();
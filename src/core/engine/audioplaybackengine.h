@@ -26,6 +26,7 @@
 #include <core/engine/audioengine.h>
 #include <core/engine/audioloader.h>
 #include <core/track.h>
+#include <utils/ioscheduler.h>
 
 #include <QBasicTimer>
 #include <QFile>
@@ -118,6 +119,7 @@ private:
     AudioSource m_nextSource;
     std::unique_ptr<QFile> m_file;
     std::unique_ptr<QFile> m_nextFile;
+    IoScheduler::Lease m_ioLease;
 
     QThread* m_outputThread;
     AudioRenderer m_renderer;
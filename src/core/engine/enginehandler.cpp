@@ -55,6 +55,7 @@ public:
     PlayerController* m_playerController;
     SettingsManager* m_settings;
 
+    AudioAnalysisTap m_analysisTap;
     QThread m_engineThread;
     AudioEngine* m_engine;
 
@@ -89,6 +90,9 @@ EngineHandlerPrivate::EngineHandlerPrivate(EngineHandler* self, std::shared_ptr<
                      [this](AudioEngine::PlaybackState state) { handleStateChange(state); });
     QObject::connect(m_engine, &AudioEngine::deviceError, m_self, &EngineController::engineError);
     QObject::connect(m_engine, &AudioEngine::bufferPlayed, m_self, &EngineController::bufferPlayed);
+    QObject::connect(
+        m_engine, &AudioEngine::bufferPlayed, m_engine,
+        [this](const AudioBuffer& buffer) { m_analysisTap.process(buffer); }, Qt::DirectConnection);
     QObject::connect(m_engine, &AudioEngine::trackChanged, m_self, &EngineController::trackChanged);
     QObject::connect(m_engine, &AudioEngine::trackStatusChanged, m_self,
                      [this](AudioEngine::TrackStatus status) { handleTrackStatus(status); });
@@ -264,6 +268,11 @@ AudioEngine::PlaybackState EngineHandler::engineState() const
     return p->m_engine->playbackState();
 }
 
+AudioAnalysisTap* EngineHandler::analysisTap() const
+{
+    return &p->m_analysisTap;
+}
+
 OutputNames EngineHandler::getAllOutputs() const
 {
     OutputNames outputs;
@@ -66,25 +66,66 @@
 #include <QMimeDatabase>
 #include <QPixmap>
 
+#include <cstring>
 #include <set>
 
 Q_LOGGING_CATEGORY(TAGLIB, "fy.taglib")
 
 using namespace Qt::StringLiterals;
 
-constexpr auto BufferSize = 1024;
+// Used when a tag no longer fits and the rest of the file has to be shifted
+constexpr auto BufferSize = 1024 * 1024;
 
 namespace {
 class IODeviceStream : public TagLib::IOStream
 {
 public:
-    IODeviceStream(QIODevice* input, const QString& filename)
+    enum class Mode : uint8_t
+    {
+        // Writes go straight to the device
+        Direct = 0,
+        // Writes are held until commit(), and any write which would change the size of the file is refused
+        InPlace,
+    };
+
+    IODeviceStream(QIODevice* input, const QString& filename, Mode mode = Mode::Direct)
         : m_input{input}
         , m_fileName{filename.toLocal8Bit()}
+        , m_mode{mode}
+        , m_needsResize{false}
     {
         m_input->seek(0);
     }
 
+    /*!
+     * Returns @c true if an InPlace write was refused because the file would have needed resizing.
+     * Nothing will have been written to the device in this case.
+     */
+    [[nodiscard]] bool needsResize() const
+    {
+        return m_needsResize;
+    }
+
+    /** Writes any held InPlace writes to the device. */
+    bool commit()
+    {
+        if(m_needsResize) {
+            return false;
+        }
+
+        for(const auto& [pos, data] : m_pendingWrites) {
+            if(!m_input->seek(pos) || m_input->write(data) != data.size()) {
+                return false;
+            }
+        }
+        m_pendingWrites.clear();
+
+        if(auto* file = qobject_cast<QFileDevice*>(m_input)) {
+            return file->flush();
+        }
+        return true;
+    }
+
     [[nodiscard]] TagLib::FileName name() const override
     {
         return m_fileName.constData();
@@ -101,12 +142,25 @@ public:
             return {};
         }
 
+        const qint64 start = m_input->pos();
+
         std::vector<char> data(length);
         const auto lenRead = m_input->read(data.data(), static_cast<qint64>(length));
         if(lenRead < 0) {
             m_input->close();
             return {};
         }
+
+        // Reads after a held write must see the written data
+        for(const auto& [pos, pending] : m_pendingWrites) {
+            const qint64 overlapStart = std::max(start, pos);
+            const qint64 overlapEnd   = std::min(start + lenRead, pos + pending.size());
+            if(overlapStart < overlapEnd) {
+                std::memcpy(data.data() + (overlapStart - start), pending.constData() + (overlapStart - pos),
+                            static_cast<size_t>(overlapEnd - overlapStart));
+            }
+        }
+
         return TagLib::ByteVector{data.data(), static_cast<unsigned int>(lenRead)};
     }
 
@@ -122,6 +176,18 @@ public:
             return;
         }
 
+        if(m_mode == Mode::InPlace) {
+            const qint64 pos  = m_input->pos();
+            const auto length = static_cast<qint64>(data.size());
+            if(pos + length > m_input->size()) {
+                m_needsResize = true;
+                return;
+            }
+            m_pendingWrites.emplace_back(pos, QByteArray{data.data(), length});
+            m_input->seek(pos + length);
+            return;
+        }
+
         m_input->write(data.data(), data.size());
     }
 
@@ -147,6 +213,11 @@ public:
             return;
         }
 
+        if(m_mode == Mode::InPlace) {
+            m_needsResize = true;
+            return;
+        }
+
         if(data.size() < replace) {
             seek(start, Beginning);
             writeBlock(data);
@@ -201,6 +272,13 @@ public:
             return;
         }
 
+        if(m_mode == Mode::InPlace) {
+            if(length > 0) {
+                m_needsResize = true;
+            }
+            return;
+        }
+
         QByteArray buffer(BufferSize, 0);
 
         auto readPosition  = static_cast<qint64>(start) + static_cast<qint64>(length);
@@ -305,6 +383,13 @@ public:
             return;
         }
 
+        if(m_mode == Mode::InPlace) {
+            if(length != m_input->size()) {
+                m_needsResize = true;
+            }
+            return;
+        }
+
         const auto currPos = m_input->pos();
 
         if(auto* file = qobject_cast<QFile*>(m_input)) {
@@ -328,6 +413,9 @@ public:
 private:
     QIODevice* m_input;
     QByteArray m_fileName;
+    Mode m_mode;
+    bool m_needsResize;
+    std::vector<std::pair<qint64, QByteArray>> m_pendingWrites;
 };
 
 constexpr std::array mp4ToTag{
@@ -2630,13 +2718,10 @@ QByteArray TagLibReader::readCover(const AudioSource& source, const Track& track
     return {};
 }
 
-bool TagLibReader::writeTrack(const AudioSource& source, const Track& track, AudioReader::WriteOptions options)
+namespace {
+bool saveTrack(IODeviceStream& stream, const AudioSource& source, const Track& track,
+               AudioReader::WriteOptions options)
 {
-    IODeviceStream stream{source.device, track.filepath()};
-    if(!stream.isOpen() || stream.readOnly()) {
-        return false;
-    }
-
     const auto writeProperties = [&track](TagLib::File& file, bool skipExtra = false) {
         auto savedProperties = file.properties();
         writeGenericProperties(savedProperties, track, skipExtra);
@@ -2797,6 +2882,30 @@ bool TagLibReader::writeTrack(const AudioSource& source, const Track& track, Aud
 
     return true;
 }
+} // namespace
+
+bool TagLibReader::writeTrack(const AudioSource& source, const Track& track, AudioReader::WriteOptions options)
+{
+    {
+        // Most edits fit within the existing tag and its padding, so try that first and
+        // only touch the bytes which changed rather than shifting the rest of the file
+        IODeviceStream stream{source.device, track.filepath(), IODeviceStream::Mode::InPlace};
+        if(!stream.isOpen() || stream.readOnly()) {
+            return false;
+        }
+        if(!saveTrack(stream, source, track, options)) {
+            return false;
+        }
+        if(!stream.needsResize()) {
+            return stream.commit();
+        }
+    }
+
+    qCDebug(TAGLIB) << "Tags don't fit in place, rewriting" << source.filepath;
+
+    IODeviceStream stream{source.device, track.filepath()};
+    return saveTrack(stream, source, track, options);
+}
 
 bool TagLibReader::writeCover(const AudioSource& source, const Track& track, const TrackCovers& covers)
 {
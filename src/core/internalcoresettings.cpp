@@ -76,6 +76,7 @@ CoreSettings::CoreSettings(SettingsManager* settingsManager)
     m_settings->createSetting<ProxyMode>(static_cast<int>(NetworkAccessManager::Mode::None), u"Networking/ProxyMode"_s);
     m_settings->createSetting<ProxyConfig>(QVariant{}, u"Networking/ProxyConfig"_s);
     m_settings->createSetting<UseVariousForCompilations>(false, u"Library/UseVariousArtistsForCompilations"_s);
+    m_settings->createSetting<AnalyseNewTracks>(false, u"Library/AnalyseNewTracks"_s);
     m_settings->createSetting<ShuffleAlbumsGroupScript>(u"%albumartist% - %date% - %album%"_s,
                                                         u"Playback/ShuffleAlbumsGroupScript"_s);
     m_settings->createSetting<ShuffleAlbumsSortScript>(u"%disc% - %track% - %title%"_s,
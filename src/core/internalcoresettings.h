@@ -83,6 +83,11 @@ constexpr auto LibraryExcludeTypes     = "Library/ExcludeTypes";
 constexpr auto ExternalRestrictTypes   = "Library/ExternalRestrictTypes";
 constexpr auto ExternalExcludeTypes    = "Library/ExternalExcludeTypes";
 constexpr auto FFmpegAllExtensions     = "Engine/FFmpegAllExtensions";
+constexpr auto IoSolidConcurrency      = "IO/SolidConcurrency";
+constexpr auto IoRotationalConcurrency = "IO/RotationalConcurrency";
+constexpr auto IoNetworkConcurrency    = "IO/NetworkConcurrency";
+constexpr auto IoMountConcurrency      = "IO/MountConcurrency";
+constexpr auto ScriptCacheMemoryLimit  = "Scripting/CacheMemoryLimit";
 
 enum CoreInternalSettings : uint32_t
 {
@@ -0,0 +1,239 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "analysisworker.h"
+
+#include <core/engine/audioconverter.h>
+#include <core/engine/audioloader.h>
+#include <utils/ioscheduler.h>
+
+#include <QFile>
+#include <QLoggingCategory>
+
+#include <bit>
+#include <cstdlib>
+#include <utility>
+
+Q_LOGGING_CATEGORY(ANALYSIS, "fy.analysis")
+
+// Large enough for the stages to process whole blocks at a time
+constexpr auto BufferSize = 65536;
+// Decoded durations which differ from the tagged duration by more than this are corrected
+constexpr auto DurationTolerance = 1000;
+// Number of analysed tracks to save to the library at once
+constexpr auto BatchSize = 50;
+
+namespace Fooyin {
+AnalysisWorker::AnalysisWorker(std::shared_ptr<AudioLoader> audioLoader, QObject* parent)
+    : Worker{parent}
+    , m_audioLoader{std::move(audioLoader)}
+{ }
+
+void AnalysisWorker::analyse(const TrackList& tracks, const std::vector<AnalysisStagePtr>& stages)
+{
+    if(closing() || stages.empty()) {
+        emit tracksProcessed(static_cast<int>(tracks.size()));
+        return;
+    }
+
+    setState(Running);
+
+    TrackList originalTracks;
+    TrackList analysedTracks;
+
+    for(const Track& track : tracks) {
+        if(!mayRun()) {
+            break;
+        }
+
+        Track analysedTrack{track};
+        if(analyseTrack(analysedTrack, stages)) {
+            originalTracks.push_back(track);
+            analysedTracks.push_back(analysedTrack);
+        }
+
+        emit tracksProcessed(1);
+
+        if(std::cmp_greater_equal(analysedTracks.size(), BatchSize)) {
+            emit tracksAnalysed(originalTracks, analysedTracks);
+            originalTracks.clear();
+            analysedTracks.clear();
+        }
+    }
+
+    if(!analysedTracks.empty()) {
+        emit tracksAnalysed(originalTracks, analysedTracks);
+    }
+
+    m_audioLoader->destroyThreadInstance();
+    m_convertBuffer = {};
+
+    if(!closing()) {
+        setState(Idle);
+    }
+    emit finished();
+}
+
+bool AnalysisWorker::analyseTrack(Track& track, const std::vector<AnalysisStagePtr>& stages)
+{
+    if(!track.isValid() || (!track.isInArchive() && !QFile::exists(track.filepath()))) {
+        return false;
+    }
+
+    auto* decoder = m_audioLoader->decoderForTrack(track);
+    if(!decoder) {
+        return false;
+    }
+
+    const auto cancelled = [this]() {
+        return !mayRun();
+    };
+
+    auto lease = IoScheduler::instance()->acquire(track.filepath(), IoScheduler::Priority::Background, cancelled);
+    if(!lease.isValid()) {
+        return false;
+    }
+
+    AudioSource source;
+    source.filepath = track.filepath();
+
+    QFile file;
+    if(!track.isInArchive()) {
+        file.setFileName(track.filepath());
+        if(!file.open(QIODevice::ReadOnly)) {
+            qCWarning(ANALYSIS) << "Failed to open" << track.filepath();
+            return false;
+        }
+        source.device = &file;
+    }
+
+    const auto format = decoder->init(source, track, AudioDecoder::NoSeeking | AudioDecoder::NoInfiniteLooping);
+    if(!format) {
+        return false;
+    }
+
+    AudioFormat floatFormat{format.value()};
+    floatFormat.setSampleFormat(SampleFormat::F32);
+
+    std::vector<std::unique_ptr<TrackAnalysis>> analyses;
+    for(const auto& stage : stages) {
+        if(auto analysis = stage->analyse(track, floatFormat)) {
+            analyses.push_back(std::move(analysis));
+        }
+    }
+
+    if(analyses.empty()) {
+        // Every stage already has what it needs, so avoid decoding the file at all
+        decoder->stop();
+        return false;
+    }
+
+    decoder->start();
+    if(track.offset() > 0) {
+        decoder->seek(track.offset());
+    }
+
+    // Cue tracks share a file, so stop at the end of this track rather than the file
+    const bool hasEnd       = track.hasCue();
+    const int64_t endFrames = hasEnd ? format->framesForDuration(track.duration()) : 0;
+    int64_t frames{0};
+
+    while(mayRun() && lease.yield(cancelled)) {
+        int bytesToRead{BufferSize};
+        if(hasEnd) {
+            const int64_t remaining = endFrames - frames;
+            if(remaining <= 0) {
+                break;
+            }
+            const auto remainingFrames = static_cast<int>(std::min<int64_t>(remaining, BufferSize));
+            bytesToRead                = std::min(bytesToRead, format->bytesForFrames(remainingFrames));
+        }
+
+        AudioBuffer buffer = decoder->readBuffer(static_cast<size_t>(bytesToRead));
+        if(!buffer.isValid()) {
+            break;
+        }
+
+        frames += buffer.frameCount();
+
+        // Converted into a buffer reused for the whole batch, unless the decoder already produces floats
+        const std::byte* data = buffer.constData().data();
+        if(buffer.format().sampleFormat() != SampleFormat::F32) {
+            m_convertBuffer.resize(static_cast<size_t>(floatFormat.bytesForFrames(buffer.frameCount())));
+            if(!Audio::convert(buffer.format(), data, floatFormat, m_convertBuffer.data(), buffer.frameCount())) {
+                break;
+            }
+            data = m_convertBuffer.data();
+        }
+
+        const std::span<const float> samples{std::bit_cast<const float*>(data),
+                                             static_cast<size_t>(buffer.frameCount() * floatFormat.channelCount())};
+        for(const auto& analysis : analyses) {
+            analysis->process(samples);
+        }
+    }
+
+    decoder->stop();
+
+    if(!mayRun()) {
+        return false;
+    }
+
+    bool modified{false};
+
+    if(!hasEnd && format->sampleRate() > 0) {
+        const auto decodedDuration = static_cast<uint64_t>(frames * 1000 / format->sampleRate());
+        const auto difference      = static_cast<int64_t>(decodedDuration) - static_cast<int64_t>(track.duration());
+        if(decodedDuration > 0 && std::abs(difference) > DurationTolerance) {
+            qCInfo(ANALYSIS) << "Correcting duration of" << track.filepath() << "from" << track.duration() << "to"
+                             << decodedDuration;
+            track.setDuration(decodedDuration);
+            modified = true;
+        }
+    }
+
+    for(const auto& analysis : analyses) {
+        modified |= analysis->finish(track);
+    }
+
+    return modified;
+}
+
+bool AnalysisWorker::applyAnalysis(const Track& original, const Track& analysed, Track& track)
+{
+    bool applied{false};
+
+    const auto apply = [&applied](auto originalValue, auto analysedValue, auto setter) {
+        if(analysedValue != originalValue) {
+            setter(analysedValue);
+            applied = true;
+        }
+    };
+
+    apply(original.duration(), analysed.duration(), [&track](uint64_t duration) { track.setDuration(duration); });
+    apply(original.rgTrackGain(), analysed.rgTrackGain(), [&track](float gain) { track.setRGTrackGain(gain); });
+    apply(original.rgTrackPeak(), analysed.rgTrackPeak(), [&track](float peak) { track.setRGTrackPeak(peak); });
+    apply(original.rgAlbumGain(), analysed.rgAlbumGain(), [&track](float gain) { track.setRGAlbumGain(gain); });
+    apply(original.rgAlbumPeak(), analysed.rgAlbumPeak(), [&track](float peak) { track.setRGAlbumPeak(peak); });
+
+    return applied;
+}
+} // namespace Fooyin
+
+#include "moc_analysisworker.cpp"
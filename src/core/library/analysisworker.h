@@ -0,0 +1,58 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fycore_export.h"
+
+#include <core/library/libraryanalyser.h>
+#include <core/track.h>
+#include <utils/worker.h>
+
+namespace Fooyin {
+class AudioLoader;
+
+class FYCORE_EXPORT AnalysisWorker : public Worker
+{
+    Q_OBJECT
+
+public:
+    explicit AnalysisWorker(std::shared_ptr<AudioLoader> audioLoader, QObject* parent = nullptr);
+
+    void analyse(const TrackList& tracks, const std::vector<AnalysisStagePtr>& stages);
+
+    /*!
+     * Copies the fields an analysis changed from @p original to @p analysed onto @p track,
+     * leaving anything else changed in the meantime untouched.
+     * @returns true if any field was copied.
+     */
+    static bool applyAnalysis(const Track& original, const Track& analysed, Track& track);
+
+signals:
+    void tracksProcessed(int count);
+    /** Emitted in batches with the tracks as they were before analysis, and after. */
+    void tracksAnalysed(const Fooyin::TrackList& originalTracks, const Fooyin::TrackList& analysedTracks);
+
+private:
+    bool analyseTrack(Track& track, const std::vector<AnalysisStagePtr>& stages);
+
+    std::shared_ptr<AudioLoader> m_audioLoader;
+    std::vector<std::byte> m_convertBuffer;
+};
+} // namespace Fooyin
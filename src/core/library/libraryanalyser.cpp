@@ -0,0 +1,141 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/library/libraryanalyser.h>
+
+#include "analysisworker.h"
+
+#include <core/coresettings.h>
+#include <core/library/musiclibrary.h>
+#include <utils/settings/settingsmanager.h>
+
+#include <QThread>
+
+namespace Fooyin {
+class LibraryAnalyserPrivate
+{
+public:
+    LibraryAnalyserPrivate(LibraryAnalyser* self, std::shared_ptr<AudioLoader> audioLoader, MusicLibrary* library,
+                           SettingsManager* settings);
+
+    void tracksProcessed(int count);
+    void tracksAnalysed(const TrackList& originalTracks, const TrackList& analysedTracks);
+
+    LibraryAnalyser* m_self;
+    MusicLibrary* m_library;
+    SettingsManager* m_settings;
+
+    QThread m_thread;
+    AnalysisWorker m_worker;
+    std::vector<AnalysisStagePtr> m_stages;
+
+    int m_total{0};
+    int m_current{0};
+};
+
+LibraryAnalyserPrivate::LibraryAnalyserPrivate(LibraryAnalyser* self, std::shared_ptr<AudioLoader> audioLoader,
+                                               MusicLibrary* library, SettingsManager* settings)
+    : m_self{self}
+    , m_library{library}
+    , m_settings{settings}
+    , m_worker{std::move(audioLoader)}
+{
+    m_worker.moveToThread(&m_thread);
+    m_thread.start(QThread::LowestPriority);
+}
+
+void LibraryAnalyserPrivate::tracksProcessed(int count)
+{
+    m_current += count;
+    emit m_self->analysisProgress(m_current, m_total);
+
+    if(m_current >= m_total) {
+        m_current = 0;
+        m_total   = 0;
+    }
+}
+
+void LibraryAnalyserPrivate::tracksAnalysed(const TrackList& originalTracks, const TrackList& analysedTracks)
+{
+    // The tracks may have been edited while they were analysed, so only the analysed fields are applied
+    // to the library's current copy rather than saving the copies taken when analysis started
+    TrackList tracksToSave;
+
+    for(size_t i{0}; i < analysedTracks.size(); ++i) {
+        const Track& analysedTrack = analysedTracks.at(i);
+
+        Track track = m_library->trackForId(analysedTrack.id());
+        if(track.isValid() && AnalysisWorker::applyAnalysis(originalTracks.at(i), analysedTrack, track)) {
+            tracksToSave.push_back(track);
+        }
+    }
+
+    if(!tracksToSave.empty()) {
+        m_library->updateTrackMetadata(tracksToSave);
+        emit m_self->tracksAnalysed(tracksToSave);
+    }
+}
+
+LibraryAnalyser::LibraryAnalyser(std::shared_ptr<AudioLoader> audioLoader, MusicLibrary* library,
+                                 SettingsManager* settings, QObject* parent)
+    : QObject{parent}
+    , p{std::make_unique<LibraryAnalyserPrivate>(this, std::move(audioLoader), library, settings)}
+{
+    QObject::connect(&p->m_worker, &AnalysisWorker::tracksProcessed, this,
+                     [this](int count) { p->tracksProcessed(count); });
+    QObject::connect(&p->m_worker, &AnalysisWorker::tracksAnalysed, this,
+                     [this](const TrackList& originalTracks, const TrackList& analysedTracks) {
+                         p->tracksAnalysed(originalTracks, analysedTracks);
+                     });
+
+    QObject::connect(p->m_library, &MusicLibrary::tracksAdded, this, [this](const TrackList& tracks) {
+        if(p->m_settings->value<Settings::Core::AnalyseNewTracks>()) {
+            analyseTracks(tracks);
+        }
+    });
+}
+
+LibraryAnalyser::~LibraryAnalyser()
+{
+    p->m_worker.closeThread();
+    p->m_thread.quit();
+    p->m_thread.wait();
+}
+
+void LibraryAnalyser::addStage(const AnalysisStagePtr& stage)
+{
+    if(stage) {
+        p->m_stages.push_back(stage);
+    }
+}
+
+void LibraryAnalyser::analyseTracks(const TrackList& tracks)
+{
+    if(tracks.empty() || p->m_stages.empty()) {
+        return;
+    }
+
+    p->m_total += static_cast<int>(tracks.size());
+
+    QMetaObject::invokeMethod(&p->m_worker,
+                              [this, tracks, stages = p->m_stages]() { p->m_worker.analyse(tracks, stages); });
+}
+} // namespace Fooyin
+
+#include "core/library/moc_libraryanalyser.cpp"
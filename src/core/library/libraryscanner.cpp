@@ -32,6 +32,7 @@
 #include <utils/database/dbconnectionhandler.h>
 #include <utils/database/dbconnectionpool.h>
 #include <utils/fileutils.h>
+#include <utils/ioscheduler.h>
 #include <utils/timer.h>
 #include <utils/utils.h>
 
@@ -329,6 +330,12 @@ void LibraryScannerPrivate::removeMissingTrack(const Track& track)
 
 TrackList LibraryScannerPrivate::readTracks(const QString& filepath)
 {
+    const auto lease = IoScheduler::instance()->acquire(filepath, IoScheduler::Priority::Background,
+                                                        [this]() { return !m_self->mayRun(); });
+    if(!lease.isValid()) {
+        return {};
+    }
+
     if(m_audioLoader->isArchive(filepath)) {
         return readArchiveTracks(filepath);
     }
@@ -419,6 +419,7 @@ LibraryThreadHandler::LibraryThreadHandler(DbConnectionPoolPtr dbPool, MusicLibr
     QObject::connect(&p->m_scanner, &LibraryScanner::directoriesChanged, this,
                      [this](const LibraryInfo& libraryInfo, const QStringList& dirs) {
                          p->addDirectoryScanRequest(libraryInfo, dirs);
+                         emit directoriesChanged(dirs);
                      });
 
     QMetaObject::invokeMethod(&p->m_scanner, &Worker::initialiseThread);
@@ -74,6 +74,7 @@ signals:
     void scanUpdate(const Fooyin::ScanResult& result);
     void tracksUpdated(const Fooyin::TrackList& tracks);
     void tracksStatsUpdated(const Fooyin::TrackList& tracks);
+    void directoriesChanged(const QStringList& dirs);
 
     void gotTracks(const Fooyin::TrackList& result);
 
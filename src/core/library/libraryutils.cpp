@@ -19,22 +19,34 @@
 
 #include "libraryutils.h"
 
+#include <unordered_map>
+
 namespace Fooyin::Utils {
 std::vector<int> updateCommonTracks(TrackList& tracks, const TrackList& updatedTracks, CommonOperation operation)
 {
     std::vector<int> indexes;
 
+    std::unordered_map<int, const Track*> updatedIds;
+    updatedIds.reserve(updatedTracks.size());
+    for(const Track& track : updatedTracks) {
+        if(track.isInDatabase()) {
+            updatedIds.emplace(track.id(), &track);
+        }
+    }
+
+    if(updatedIds.empty()) {
+        return indexes;
+    }
+
     Fooyin::TrackList result;
     result.reserve(tracks.size());
 
     for(auto trackIt{tracks.begin()}; trackIt != tracks.end(); ++trackIt) {
-        auto updatedIt = std::ranges::find_if(updatedTracks, [&trackIt](const Fooyin::Track& updatedTrack) {
-            return updatedTrack.isInDatabase() && trackIt->id() == updatedTrack.id();
-        });
-        if(updatedIt != updatedTracks.end()) {
+        const auto updatedIt = updatedIds.find(trackIt->id());
+        if(updatedIt != updatedIds.cend()) {
             indexes.push_back(static_cast<int>(std::distance(tracks.begin(), trackIt)));
             if(operation == CommonOperation::Update) {
-                result.push_back(*updatedIt);
+                result.push_back(*updatedIt->second);
             }
         }
         else {
@@ -0,0 +1,190 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "tagwritejournal.h"
+
+#include <algorithm>
+
+#if defined(Q_OS_UNIX)
+#include <unistd.h>
+#elif defined(Q_OS_WIN)
+#include <io.h>
+#endif
+
+// Each line is either a pending write, "<kind> <id> <options> <filepath>", or a finished write, "D <kind> <id>"
+constexpr auto MetadataMarker = 'W';
+constexpr auto CoverMarker    = 'C';
+constexpr auto FinishedMarker = 'D';
+
+namespace {
+char kindMarker(Fooyin::TagWriteJournal::Kind kind)
+{
+    return kind == Fooyin::TagWriteJournal::Kind::Cover ? CoverMarker : MetadataMarker;
+}
+
+bool syncToDisk(QFile& file)
+{
+    if(!file.flush()) {
+        return false;
+    }
+
+#if defined(Q_OS_UNIX)
+    return ::fsync(file.handle()) == 0;
+#elif defined(Q_OS_WIN)
+    return ::_commit(file.handle()) == 0;
+#else
+    return true;
+#endif
+}
+} // namespace
+
+namespace Fooyin {
+TagWriteJournal::TagWriteJournal(QString filepath)
+    : m_filepath{std::move(filepath)}
+    , m_file{m_filepath}
+    , m_outstanding{0}
+{ }
+
+TagWriteJournal::Entries TagWriteJournal::pending() const
+{
+    QFile file{m_filepath};
+    if(!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    Entries entries;
+
+    while(!file.atEnd()) {
+        QByteArray data = file.readLine();
+        if(!data.endsWith('\n')) {
+            // Torn by a crash part way through writing the line
+            continue;
+        }
+        data.chop(1);
+
+        const QString line = QString::fromUtf8(data);
+        if(line.size() < 3) {
+            continue;
+        }
+
+        const auto marker = line.at(0).toLatin1();
+
+        if(marker == FinishedMarker) {
+            const QStringList fields = line.split(u' ');
+            if(fields.size() < 3 || fields.at(1).size() != 1) {
+                continue;
+            }
+
+            const Kind kind   = fields.at(1).at(0).toLatin1() == CoverMarker ? Kind::Cover : Kind::Metadata;
+            const int trackId = fields.at(2).toInt();
+
+            auto it = std::ranges::find_if(
+                entries, [kind, trackId](const Entry& entry) { return entry.kind == kind && entry.trackId == trackId; });
+            if(it != entries.end()) {
+                entries.erase(it);
+            }
+            continue;
+        }
+
+        if(marker != MetadataMarker && marker != CoverMarker) {
+            continue;
+        }
+
+        const QStringList fields = line.split(u' ');
+        if(fields.size() < 4) {
+            continue;
+        }
+
+        Entry entry;
+        entry.kind     = marker == CoverMarker ? Kind::Cover : Kind::Metadata;
+        entry.trackId  = fields.at(1).toInt();
+        entry.options  = AudioReader::WriteOptions::fromInt(fields.at(2).toInt());
+        entry.filepath = line.section(u' ', 3);
+        entries.push_back(entry);
+    }
+
+    return entries;
+}
+
+bool TagWriteJournal::begin(const Entries& entries)
+{
+    if(entries.empty()) {
+        return true;
+    }
+
+    QByteArray data;
+    for(const Entry& entry : entries) {
+        data.append(kindMarker(entry.kind));
+        data.append(' ');
+        data.append(QByteArray::number(entry.trackId));
+        data.append(' ');
+        data.append(QByteArray::number(entry.options.toInt()));
+        data.append(' ');
+        data.append(entry.filepath.toUtf8());
+        data.append('\n');
+    }
+
+    const std::scoped_lock lock{m_mutex};
+
+    // Synced rather than just flushed, so the entries are on disk before any file is touched
+    if(!append(data) || !syncToDisk(m_file)) {
+        return false;
+    }
+
+    m_outstanding += static_cast<int>(entries.size());
+    return true;
+}
+
+void TagWriteJournal::finish(Kind kind, int trackId)
+{
+    const std::scoped_lock lock{m_mutex};
+
+    if(m_outstanding <= 0) {
+        return;
+    }
+
+    if(--m_outstanding == 0) {
+        m_file.close();
+        QFile::remove(m_filepath);
+        return;
+    }
+
+    append(QByteArray{1, FinishedMarker} + ' ' + kindMarker(kind) + ' ' + QByteArray::number(trackId) + '\n');
+}
+
+void TagWriteJournal::clear()
+{
+    const std::scoped_lock lock{m_mutex};
+
+    m_outstanding = 0;
+    m_file.close();
+    QFile::remove(m_filepath);
+}
+
+bool TagWriteJournal::append(const QByteArray& data)
+{
+    if(!m_file.isOpen() && !m_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        return false;
+    }
+
+    // Flushed straight away so the entry survives the application crashing.
+    // A finished write that is lost only means the file is written again on the next start.
+    return m_file.write(data) == data.size() && m_file.flush();
+}
+} // namespace Fooyin
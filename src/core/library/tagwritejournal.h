@@ -0,0 +1,74 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <core/engine/audioinput.h>
+
+#include <QFile>
+
+#include <mutex>
+
+namespace Fooyin {
+/*!
+ * Records batches of tag writes so a batch interrupted by a crash can be
+ * reported and finished on the next start.
+ *
+ * Each write is recorded before the batch starts and marked once it has finished,
+ * whether or not it succeeded. The journal is removed when nothing is left outstanding.
+ */
+class TagWriteJournal
+{
+public:
+    enum class Kind : uint8_t
+    {
+        Metadata = 0,
+        Cover,
+    };
+
+    struct Entry
+    {
+        Kind kind{Kind::Metadata};
+        int trackId{-1};
+        AudioReader::WriteOptions options;
+        QString filepath;
+    };
+    using Entries = std::vector<Entry>;
+
+    explicit TagWriteJournal(QString filepath);
+
+    /** Returns the writes of previous batches which never finished. */
+    [[nodiscard]] Entries pending() const;
+
+    /** Records that the writes in @p entries are about to start. */
+    bool begin(const Entries& entries);
+    /** Records that the @p kind write of @p trackId has finished. This may be called from any thread. */
+    void finish(Kind kind, int trackId);
+    /** Removes the journal, discarding anything still outstanding. */
+    void clear();
+
+private:
+    bool append(const QByteArray& data);
+
+    QString m_filepath;
+    std::mutex m_mutex;
+    QFile m_file;
+    int m_outstanding;
+};
+} // namespace Fooyin
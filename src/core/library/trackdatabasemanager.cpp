@@ -27,13 +27,21 @@
 #include <core/library/musiclibrary.h>
 #include <core/track.h>
 #include <utils/database/dbconnectionhandler.h>
+#include <utils/ioscheduler.h>
+#include <utils/paths.h>
 #include <utils/settings/settingsmanager.h>
 
 #include <QFileInfo>
 #include <QLoggingCategory>
+#include <QtConcurrentMap>
+
+#include <map>
+#include <unordered_map>
 
 Q_LOGGING_CATEGORY(TRK_DBMAN, "fy.trackdbmanager")
 
+using namespace Qt::StringLiterals;
+
 namespace {
 Fooyin::Track extractTrackById(Fooyin::TrackList& tracks, int id)
 {
@@ -46,6 +54,12 @@ Fooyin::Track extractTrackById(Fooyin::TrackList& tracks, int id)
 
     return {};
 }
+
+void updateModifiedTime(Fooyin::Track& track)
+{
+    const QDateTime modifiedTime = QFileInfo{track.filepath()}.lastModified();
+    track.setModifiedTime(modifiedTime.isValid() ? modifiedTime.toMSecsSinceEpoch() : 0);
+}
 } // namespace
 
 namespace Fooyin {
@@ -55,6 +69,7 @@ TrackDatabaseManager::TrackDatabaseManager(DbConnectionPoolPtr dbPool, std::shar
     , m_dbPool{std::move(dbPool)}
     , m_audioLoader{std::move(audioLoader)}
     , m_settings{settings}
+    , m_journal{Utils::statePath() + "/tagwrites.journal"_L1}
 {
     m_settings->subscribe<Settings::Core::ActiveTrackId>(this, &TrackDatabaseManager::writePending);
 }
@@ -79,6 +94,8 @@ void TrackDatabaseManager::getAllTracks()
 
     emit gotTracks(tracks);
 
+    resumeInterruptedWrites(tracks);
+
     setState(Idle);
 }
 
@@ -89,9 +106,8 @@ void TrackDatabaseManager::updateTracks(const TrackList& tracks, bool write)
     TrackList tracksToUpdate{tracks};
     TrackList tracksUpdated;
 
-    AudioReader::WriteOptions options;
-
     if(write) {
+        AudioReader::WriteOptions options;
         if(m_settings->value<Settings::Core::SaveRatingToMetadata>()) {
             options |= AudioReader::Rating;
         }
@@ -103,28 +119,18 @@ void TrackDatabaseManager::updateTracks(const TrackList& tracks, bool write)
         if(activeTrack.isValid() && m_audioLoader->canWriteMetadata(activeTrack)) {
             m_pendingUpdate = activeTrack;
         }
-    }
-
-    for(const Track& track : std::as_const(tracksToUpdate)) {
-        if(!mayRun()) {
-            break;
-        }
-
-        Track updatedTrack{track};
 
-        if(write) {
-            if(m_audioLoader->writeTrackMetadata(updatedTrack, options)) {
-                const QDateTime modifiedTime = QFileInfo{updatedTrack.filepath()}.lastModified();
-                updatedTrack.setModifiedTime(modifiedTime.isValid() ? modifiedTime.toMSecsSinceEpoch() : 0);
-            }
-            else {
-                qCWarning(TRK_DBMAN) << "Failed to write metadata to file:" << updatedTrack.filepath();
-                continue;
+        tracksUpdated = writeTracks(tracksToUpdate, options);
+    }
+    else {
+        for(const Track& track : std::as_const(tracksToUpdate)) {
+            if(!mayRun()) {
+                break;
             }
-        }
 
-        if(m_trackDatabase.updateTrack(updatedTrack) && m_trackDatabase.updateTrackStats(updatedTrack)) {
-            tracksUpdated.push_back(updatedTrack);
+            if(m_trackDatabase.updateTrack(track) && m_trackDatabase.updateTrackStats(track)) {
+                tracksUpdated.push_back(track);
+            }
         }
     }
 
@@ -174,8 +180,7 @@ void TrackDatabaseManager::updateTrackStats(const TrackList& tracks)
             success = m_audioLoader->writeTrackMetadata(updatedTrack, options);
         }
         if(success && m_trackDatabase.updateTrackStats(updatedTrack)) {
-            const QDateTime modifiedTime = QFileInfo{updatedTrack.filepath()}.lastModified();
-            updatedTrack.setModifiedTime(modifiedTime.isValid() ? modifiedTime.toMSecsSinceEpoch() : 0);
+            updateModifiedTime(updatedTrack);
             tracksUpdated.push_back(updatedTrack);
         }
         else {
@@ -206,27 +211,39 @@ void TrackDatabaseManager::writeCovers(const TrackCoverData& tracks)
         m_pendingCoverUpdate = {{activeTrack}, tracks.coverData};
     }
 
-    for(const auto& track : std::as_const(tracksToUpdate)) {
-        if(!mayRun()) {
-            break;
-        }
+    std::erase_if(tracksToUpdate, [](const Track& track) { return track.isInArchive(); });
 
-        if(track.isInArchive()) {
-            continue;
+    TagWriteJournal::Entries entries;
+    for(const Track& track : std::as_const(tracksToUpdate)) {
+        entries.push_back({TagWriteJournal::Kind::Cover, track.id(), {}, track.filepath()});
+    }
+    m_journal.begin(entries);
+
+    const auto results
+        = writeFiles(tracksToUpdate, TagWriteJournal::Kind::Cover, [this, &tracks](const Track& track) {
+              return m_audioLoader->writeTrackCover(track, tracks.coverData);
+          });
+
+    TrackList tracksWritten;
+    for(size_t i{0}; i < tracksToUpdate.size(); ++i) {
+        Track& track = tracksToUpdate.at(i);
+        switch(results.at(i)) {
+            case(WriteResult::Written):
+                updateModifiedTime(track);
+                tracksWritten.push_back(track);
+                break;
+            case(WriteResult::Failed):
+                qCWarning(TRK_DBMAN) << "Failed to update track covers:" << track.filepath();
+                break;
+            case(WriteResult::Cancelled):
+                // Nothing in the database depends on the artwork, so there is nothing left to retry
+                m_journal.finish(TagWriteJournal::Kind::Cover, track.id());
+                break;
         }
+    }
 
-        Track updatedTrack{track};
-        if(m_audioLoader->writeTrackCover(updatedTrack, tracks.coverData)) {
-            const QDateTime modifiedTime = QFileInfo{updatedTrack.filepath()}.lastModified();
-            updatedTrack.setModifiedTime(modifiedTime.isValid() ? modifiedTime.toMSecsSinceEpoch() : 0);
-
-            if(m_trackDatabase.updateTrack(updatedTrack)) {
-                tracksUpdated.push_back(updatedTrack);
-            }
-        }
-        else {
-            qCWarning(TRK_DBMAN) << "Failed to update track covers:" << updatedTrack.filepath();
-        }
+    if(m_trackDatabase.updateTracks(tracksWritten)) {
+        tracksUpdated = tracksWritten;
     }
 
     if(!m_pendingCoverUpdate.tracks.empty()) {
@@ -266,6 +283,177 @@ void TrackDatabaseManager::writePending()
         m_pendingCoverUpdate = {};
     }
 }
+
+void TrackDatabaseManager::resumeInterruptedWrites(const TrackList& tracks)
+{
+    const auto entries = m_journal.pending();
+    m_journal.clear();
+
+    if(entries.empty()) {
+        return;
+    }
+
+    qCWarning(TRK_DBMAN) << entries.size() << "tag writes were interrupted and will be retried";
+
+    std::unordered_map<int, Track> tracksById;
+    for(const Track& track : tracks) {
+        tracksById.emplace(track.id(), track);
+    }
+
+    // The database was updated before the files were written, so it holds the tags each file should have
+    std::map<int, TrackList> tracksToWrite;
+    for(const auto& entry : entries) {
+        if(entry.kind == TagWriteJournal::Kind::Cover) {
+            qCWarning(TRK_DBMAN) << "Artwork may not have been written to:" << entry.filepath;
+            continue;
+        }
+
+        const auto trackIt = tracksById.find(entry.trackId);
+        if(trackIt == tracksById.cend() || trackIt->second.filepath() != entry.filepath) {
+            qCWarning(TRK_DBMAN) << "Unable to retry writing tags to file no longer in library:" << entry.filepath;
+            continue;
+        }
+
+        tracksToWrite[entry.options.toInt()].push_back(trackIt->second);
+    }
+
+    for(auto& [options, tracksWithOptions] : tracksToWrite) {
+        const TrackList tracksWritten = writeTracks(tracksWithOptions, AudioReader::WriteOptions::fromInt(options));
+        if(!tracksWritten.empty()) {
+            emit updatedTracks(tracksWritten);
+        }
+    }
+}
+
+TrackList TrackDatabaseManager::writeTracks(TrackList& tracks, AudioReader::WriteOptions options)
+{
+    if(tracks.empty()) {
+        return {};
+    }
+
+    // Kept so the database can be restored if a file can't be written
+    TrackList originalTracks{tracks};
+    m_trackDatabase.reloadTracks(originalTracks);
+
+    std::unordered_map<int, Track> originalsById;
+    for(const Track& track : originalTracks) {
+        originalsById.emplace(track.id(), track);
+    }
+
+    // The database is updated first so it always holds the tags any file interrupted by a crash should have
+    m_trackDatabase.updateTracks(tracks);
+    m_trackDatabase.updateTrackStats(tracks);
+
+    TagWriteJournal::Entries entries;
+    for(const Track& track : std::as_const(tracks)) {
+        entries.push_back({TagWriteJournal::Kind::Metadata, track.id(), options, track.filepath()});
+    }
+    m_journal.begin(entries);
+
+    const auto results = writeFiles(tracks, TagWriteJournal::Kind::Metadata, [this, options](const Track& track) {
+        return m_audioLoader->writeTrackMetadata(track, options);
+    });
+
+    TrackList tracksWritten;
+    TrackList tracksToRestore;
+    std::vector<int> tracksCancelled;
+
+    for(size_t i{0}; i < tracks.size(); ++i) {
+        Track& track = tracks.at(i);
+
+        switch(results.at(i)) {
+            case(WriteResult::Written):
+                updateModifiedTime(track);
+                if(track.id() >= 0) {
+                    tracksWritten.push_back(track);
+                }
+                break;
+            case(WriteResult::Failed): {
+                qCWarning(TRK_DBMAN) << "Failed to write metadata to file:" << track.filepath();
+                const auto originalIt = originalsById.find(track.id());
+                if(originalIt != originalsById.cend()) {
+                    tracksToRestore.push_back(originalIt->second);
+                }
+                break;
+            }
+            case(WriteResult::Cancelled): {
+                // The file was never touched, so the database goes back to matching it
+                const auto originalIt = originalsById.find(track.id());
+                if(originalIt != originalsById.cend()) {
+                    tracksToRestore.push_back(originalIt->second);
+                }
+                tracksCancelled.push_back(track.id());
+                break;
+            }
+        }
+    }
+
+    // Store the new modified times
+    m_trackDatabase.updateTracks(tracksWritten);
+
+    if(!tracksToRestore.empty()) {
+        m_trackDatabase.updateTracks(tracksToRestore);
+        m_trackDatabase.updateTrackStats(tracksToRestore);
+    }
+
+    // Only marked once restored, so an interrupted restore is still retried on the next start
+    for(const int trackId : tracksCancelled) {
+        m_journal.finish(TagWriteJournal::Kind::Metadata, trackId);
+    }
+
+    return tracksWritten;
+}
+
+std::vector<TrackDatabaseManager::WriteResult>
+TrackDatabaseManager::writeFiles(const TrackList& tracks, TagWriteJournal::Kind kind, const FileWriter& writer)
+{
+    std::vector<WriteResult> results(tracks.size(), WriteResult::Cancelled);
+
+    // Tracks sharing a file (cue sheets, multi-track files) are written one after another by the same task,
+    // as concurrent writers could each shift the file's contents underneath the other
+    std::vector<std::vector<size_t>> fileGroups;
+    std::unordered_map<QString, size_t> groupIndexes;
+
+    for(size_t i{0}; i < tracks.size(); ++i) {
+        const auto [groupIt, inserted] = groupIndexes.try_emplace(tracks.at(i).filepath(), fileGroups.size());
+        if(inserted) {
+            fileGroups.emplace_back();
+        }
+        fileGroups.at(groupIt->second).push_back(i);
+    }
+
+    const auto cancelled = [this]() {
+        return !mayRun();
+    };
+
+    // Files are written in parallel, with the scheduler limiting how many writers share each device
+    QtConcurrent::blockingMap(&m_writePool, fileGroups, [&](const std::vector<size_t>& indexes) {
+        if(!mayRun()) {
+            return;
+        }
+
+        const auto lease = IoScheduler::instance()->acquire(tracks.at(indexes.front()).filepath(),
+                                                            IoScheduler::Priority::Interactive, cancelled);
+        if(!lease.isValid()) {
+            return;
+        }
+
+        for(const size_t index : indexes) {
+            if(!mayRun()) {
+                break;
+            }
+
+            const Track& track = tracks.at(index);
+
+            results[index] = writer(track) ? WriteResult::Written : WriteResult::Failed;
+            m_journal.finish(kind, track.id());
+        }
+
+        m_audioLoader->destroyThreadInstance();
+    });
+
+    return results;
+}
 } // namespace Fooyin
 
 #include "moc_trackdatabasemanager.cpp"
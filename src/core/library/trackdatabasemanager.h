@@ -20,10 +20,16 @@
 #pragma once
 
 #include "database/trackdatabase.h"
+#include "tagwritejournal.h"
 
+#include <core/engine/audioinput.h>
 #include <utils/database/dbconnectionhandler.h>
 #include <utils/worker.h>
 
+#include <QThreadPool>
+
+#include <functional>
+
 namespace Fooyin {
 class Database;
 class AudioLoader;
@@ -53,7 +59,20 @@ public slots:
     void cleanupTracks();
 
 private:
+    enum class WriteResult : uint8_t
+    {
+        Written = 0,
+        Failed,
+        Cancelled,
+    };
+    using FileWriter = std::function<bool(const Track&)>;
+
     void writePending();
+    void resumeInterruptedWrites(const TrackList& tracks);
+
+    TrackList writeTracks(TrackList& tracks, AudioReader::WriteOptions options);
+    std::vector<WriteResult> writeFiles(const TrackList& tracks, TagWriteJournal::Kind kind,
+                                        const FileWriter& writer);
 
     DbConnectionPoolPtr m_dbPool;
     std::shared_ptr<AudioLoader> m_audioLoader;
@@ -61,6 +80,8 @@ private:
 
     std::unique_ptr<DbConnectionHandler> m_dbHandler;
     TrackDatabase m_trackDatabase;
+    TagWriteJournal m_journal;
+    QThreadPool m_writePool;
 
     Track m_pendingUpdate;
     Track m_pendingStatUpdate;
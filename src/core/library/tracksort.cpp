@@ -19,6 +19,77 @@
 
 #include <core/library/tracksort.h>
 
+#include <QCollator>
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+// Below this many items the overhead of dispatching to the thread pool outweighs the gain
+constexpr auto ParallelSortThreshold = 10000;
+
+struct SortRange
+{
+    size_t chunk{0};
+    int begin{0};
+    int end{0};
+};
+
+std::vector<SortRange> splitRange(int count)
+{
+    std::vector<SortRange> ranges;
+
+    const int chunks    = count < ParallelSortThreshold ? 1 : std::max(1, QThread::idealThreadCount());
+    const int chunkSize = (count + chunks - 1) / chunks;
+
+    for(int begin{0}; begin < count; begin += chunkSize) {
+        ranges.push_back({ranges.size(), begin, std::min(begin + chunkSize, count)});
+    }
+
+    return ranges;
+}
+
+template <typename Func>
+void forEachRange(std::vector<SortRange>& ranges, Func&& func)
+{
+    if(ranges.size() == 1) {
+        func(ranges.front());
+    }
+    else {
+        QtConcurrent::blockingMap(ranges, std::forward<Func>(func));
+    }
+}
+
+std::vector<QCollatorSortKey> generateSortKeys(const std::vector<QString>& sortFields, std::vector<SortRange>& ranges)
+{
+    std::vector<std::vector<QCollatorSortKey>> chunkKeys(ranges.size());
+
+    forEachRange(ranges, [&sortFields, &chunkKeys](const SortRange& range) {
+        // QCollator isn't thread-safe, so use one per chunk
+        QCollator collator;
+        collator.setNumericMode(true);
+
+        auto& keys = chunkKeys.at(range.chunk);
+        keys.reserve(static_cast<size_t>(range.end - range.begin));
+
+        for(int i{range.begin}; i < range.end; ++i) {
+            keys.push_back(collator.sortKey(sortFields.at(i)));
+        }
+    });
+
+    std::vector<QCollatorSortKey> sortKeys;
+    sortKeys.reserve(sortFields.size());
+
+    for(auto& keys : chunkKeys) {
+        std::ranges::move(keys, std::back_inserter(sortKeys));
+    }
+
+    return sortKeys;
+}
+} // namespace
+
 namespace Fooyin {
 TrackSorter::TrackSorter()
     : TrackSorter{nullptr}
@@ -48,9 +119,77 @@ TrackList TrackSorter::calcSortFields(const ParsedScript& sortScript, const Trac
 
 TrackList TrackSorter::sortTracks(const TrackList& tracks, Qt::SortOrder order)
 {
-    TrackList sortedTracks{tracks};
-    sortTracks(sortedTracks, std::identity{}, order);
-    return sortedTracks;
+    std::vector<QString> sortFields;
+    sortFields.reserve(tracks.size());
+    std::ranges::transform(tracks, std::back_inserter(sortFields), [](const Track& track) { return track.sort(); });
+
+    return applyPermutation(tracks, sortPermutation(sortFields, order));
+}
+
+std::vector<int> TrackSorter::sortPermutation(const QString& sort, const TrackList& tracks, Qt::SortOrder order)
+{
+    return sortPermutation(parseScript(sort), tracks, order);
+}
+
+std::vector<int> TrackSorter::sortPermutation(const ParsedScript& sortScript, const TrackList& tracks,
+                                              Qt::SortOrder order)
+{
+    return sortPermutation(calcSortKeys(sortScript, tracks, std::identity{}), order);
+}
+
+std::vector<int> TrackSorter::sortPermutation(const std::vector<QString>& sortFields, Qt::SortOrder order)
+{
+    const auto count = static_cast<int>(sortFields.size());
+
+    std::vector<int> permutation(sortFields.size());
+    std::iota(permutation.begin(), permutation.end(), 0);
+
+    if(count < 2) {
+        return permutation;
+    }
+
+    std::vector<SortRange> ranges            = splitRange(count);
+    const std::vector<QCollatorSortKey> keys = generateSortKeys(sortFields, ranges);
+
+    const auto compare = [&keys, order](int lhs, int rhs) {
+        const int cmp = keys[lhs].compare(keys[rhs]);
+        return order == Qt::AscendingOrder ? cmp < 0 : cmp > 0;
+    };
+
+    forEachRange(ranges, [&permutation, &compare](const SortRange& range) {
+        std::stable_sort(permutation.begin() + range.begin, permutation.begin() + range.end, compare);
+    });
+
+    // Merge neighbouring sorted chunks until a single range remains
+    while(ranges.size() > 1) {
+        std::vector<SortRange> merged;
+        std::vector<std::pair<SortRange, int>> pairs;
+
+        for(size_t i{0}; i + 1 < ranges.size(); i += 2) {
+            pairs.emplace_back(SortRange{merged.size(), ranges.at(i).begin, ranges.at(i + 1).end}, ranges.at(i).end);
+            merged.push_back(pairs.back().first);
+        }
+        if(ranges.size() % 2 != 0) {
+            merged.push_back(ranges.back());
+        }
+
+        if(pairs.size() == 1) {
+            const auto& [range, middle] = pairs.front();
+            std::inplace_merge(permutation.begin() + range.begin, permutation.begin() + middle,
+                               permutation.begin() + range.end, compare);
+        }
+        else {
+            QtConcurrent::blockingMap(pairs, [&permutation, &compare](const std::pair<SortRange, int>& pair) {
+                const auto& [range, middle] = pair;
+                std::inplace_merge(permutation.begin() + range.begin, permutation.begin() + middle,
+                                   permutation.begin() + range.end, compare);
+            });
+        }
+
+        ranges = merged;
+    }
+
+    return permutation;
 }
 
 TrackList TrackSorter::calcSortTracks(const QString& sort, const TrackList& tracks, Qt::SortOrder order)
@@ -66,8 +205,21 @@ TrackList TrackSorter::calcSortTracks(const QString& sort, const TrackList& trac
 
 TrackList TrackSorter::calcSortTracks(const ParsedScript& sortScript, const TrackList& tracks, Qt::SortOrder order)
 {
-    const TrackList calcTracks = calcSortFields(sortScript, tracks);
-    return sortTracks(calcTracks, order);
+    const std::vector<QString> sortFields = calcSortKeys(sortScript, tracks, std::identity{});
+    const std::vector<int> permutation    = sortPermutation(sortFields, order);
+
+    TrackList sortedTracks;
+    sortedTracks.reserve(tracks.size());
+
+    for(const int index : permutation) {
+        Track& track = sortedTracks.emplace_back(tracks.at(index));
+        // The library relies on the sort field of its tracks, but only detach if it has changed
+        if(track.isNewTrack() || track.sort() != sortFields.at(index)) {
+            track.setSort(sortFields.at(index));
+        }
+    }
+
+    return sortedTracks;
 }
 
 TrackList TrackSorter::calcSortTracks(const ParsedScript& sortScript, const TrackList& tracks,
@@ -84,8 +236,7 @@ TrackList TrackSorter::calcSortTracks(const ParsedScript& sortScript, const Trac
         tracksToSort.push_back(tracks.at(index));
     }
 
-    const TrackList calcTracks      = calcSortFields(sortScript, tracksToSort);
-    const TrackList sortedSubTracks = sortTracks(calcTracks, order);
+    const TrackList sortedSubTracks = calcSortTracks(sortScript, tracksToSort, order);
 
     for(auto i{0}; const int index : validIndexes) {
         sortedTracks[index] = sortedSubTracks.at(i++);
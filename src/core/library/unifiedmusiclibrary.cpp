@@ -288,6 +288,8 @@ UnifiedMusicLibrary::UnifiedMusicLibrary(LibraryManager* libraryManager, DbConne
                      [this](const TrackList& tracks) { p->updateTracks(tracks); });
     QObject::connect(&p->m_threadHandler, &LibraryThreadHandler::gotTracks, this,
                      [this](const TrackList& tracks) { p->loadTracks(tracks); });
+    QObject::connect(&p->m_threadHandler, &LibraryThreadHandler::directoriesChanged, this,
+                     &MusicLibrary::directoriesChanged);
 
     QObject::connect(
         this, &MusicLibrary::tracksLoaded, this, [this]() { p->handleTracksLoaded(); }, Qt::QueuedConnection);
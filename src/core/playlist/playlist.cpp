@@ -29,6 +29,8 @@
 #include <random>
 #include <ranges>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace Qt::StringLiterals;
 
@@ -134,12 +136,20 @@ public:
     int getNextIndex(int delta, Playlist::PlayModes mode, bool onlyCheck);
     [[nodiscard]] std::optional<Track> getTrack(int index) const;
 
+    void rebuildTrackIdIndexes();
+    void addTrackIdIndex(const Track& track, int index);
+    void tracksChanged();
+
     UId m_id;
     int m_dbId{-1};
     QString m_name;
     int m_index{-1};
     TrackList m_tracks;
 
+    // Track id -> indexes of that track in m_tracks
+    std::unordered_map<int, std::vector<int>> m_trackIdIndexes;
+    bool m_trackIdIndexesDirty{true};
+
     SettingsManager* m_settings;
     ScriptParser m_parser;
     TrackSorter m_sorter;
@@ -258,8 +268,7 @@ void PlaylistPrivate::sortAlbumTracks(AlbumTracks& album, const QString& sortScr
         trackIndexes.emplace_back(m_tracks.at(trackIndex), m_id, trackIndex);
     }
 
-    trackIndexes
-        = m_sorter.calcSortTracks(sortScript, trackIndexes, PlaylistTrack::extractor, PlaylistTrack::extractorConst);
+    trackIndexes = m_sorter.calcSortTracks(sortScript, trackIndexes, PlaylistTrack::extractorConst);
 
     album.clear();
     for(const auto& track : trackIndexes) {
@@ -486,6 +495,33 @@ std::optional<Track> PlaylistPrivate::getTrack(int index) const
     return m_tracks.at(index);
 }
 
+void PlaylistPrivate::rebuildTrackIdIndexes()
+{
+    m_trackIdIndexes.clear();
+
+    const auto count = static_cast<int>(m_tracks.size());
+    for(int i{0}; i < count; ++i) {
+        addTrackIdIndex(m_tracks.at(i), i);
+    }
+
+    m_trackIdIndexesDirty = false;
+}
+
+void PlaylistPrivate::addTrackIdIndex(const Track& track, int index)
+{
+    if(track.isInDatabase()) {
+        m_trackIdIndexes[track.id()].push_back(index);
+    }
+}
+
+void PlaylistPrivate::tracksChanged()
+{
+    m_tracksModified = true;
+    m_trackShuffleOrder.clear();
+    m_albumShuffleOrder.clear();
+    m_nextTrackIndex = -1;
+}
+
 Playlist::Playlist(PrivateKey /*key*/, int dbId, QString name, int index, SettingsManager* settings)
     : p{std::make_unique<PlaylistPrivate>(dbId, std::move(name), index, settings)}
 { }
@@ -724,11 +760,9 @@ void Playlist::setTracksModified(bool modified)
 void Playlist::replaceTracks(const TrackList& tracks)
 {
     if(std::exchange(p->m_tracks, tracks) != tracks) {
-        p->m_tracksModified = true;
-        p->m_trackShuffleOrder.clear();
-        p->m_albumShuffleOrder.clear();
-        p->m_nextTrackIndex = -1;
+        p->tracksChanged();
     }
+    p->m_trackIdIndexesDirty = true;
 }
 
 void Playlist::appendTracks(const TrackList& tracks)
@@ -737,6 +771,12 @@ void Playlist::appendTracks(const TrackList& tracks)
         return;
     }
 
+    if(!p->m_trackIdIndexesDirty) {
+        for(int index{static_cast<int>(p->m_tracks.size())}; const Track& track : tracks) {
+            p->addTrackIdIndex(track, index++);
+        }
+    }
+
     std::ranges::copy(tracks, std::back_inserter(p->m_tracks));
     p->m_tracksModified = true;
     p->m_trackShuffleOrder.clear();
@@ -750,10 +790,57 @@ void Playlist::updateTrackAtIndex(int index, const Track& track)
     }
 
     if(p->m_tracks.at(index).uniqueFilepath() == track.uniqueFilepath()) {
+        if(p->m_tracks.at(index).id() != track.id()) {
+            p->m_trackIdIndexesDirty = true;
+        }
         p->m_tracks[index] = track;
     }
 }
 
+std::vector<int> Playlist::updateTracks(const TrackList& tracks)
+{
+    std::vector<int> updatedIndexes;
+
+    if(p->m_tracks.empty() || tracks.empty()) {
+        return updatedIndexes;
+    }
+
+    if(p->m_trackIdIndexesDirty) {
+        p->rebuildTrackIdIndexes();
+    }
+
+    bool changed{false};
+    std::unordered_set<int> seenIds;
+
+    for(const Track& track : tracks) {
+        if(!track.isInDatabase() || !seenIds.emplace(track.id()).second) {
+            continue;
+        }
+
+        const auto indexesIt = p->m_trackIdIndexes.find(track.id());
+        if(indexesIt == p->m_trackIdIndexes.cend()) {
+            continue;
+        }
+
+        for(const int index : indexesIt->second) {
+            Track& existingTrack = p->m_tracks[index];
+            if(existingTrack != track) {
+                changed = true;
+            }
+            existingTrack = track;
+            updatedIndexes.push_back(index);
+        }
+    }
+
+    if(changed) {
+        p->tracksChanged();
+    }
+
+    std::ranges::sort(updatedIndexes);
+
+    return updatedIndexes;
+}
+
 std::vector<int> Playlist::removeTracks(const std::vector<int>& indexes)
 {
     const auto updateAlbumShuffleOrder = [this](int removedIndex) {
@@ -799,6 +886,9 @@ std::vector<int> Playlist::removeTracks(const std::vector<int>& indexes)
 
     std::erase_if(p->m_trackShuffleOrder, [](int num) { return num < 0; });
     changeCurrentIndex(adjustedTrackIndex);
+    if(!removedIndexes.empty()) {
+        p->m_trackIdIndexesDirty = true;
+    }
     if(indexesToRemove.contains(p->m_nextTrackIndex)) {
         p->m_nextTrackIndex = -1;
     }
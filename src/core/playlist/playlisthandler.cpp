@@ -22,7 +22,6 @@
 #include "application.h"
 #include "database/playlistdatabase.h"
 #include "internalcoresettings.h"
-#include "library/libraryutils.h"
 
 #include <core/coresettings.h>
 #include <core/library/musiclibrary.h>
@@ -169,11 +168,8 @@ void PlaylistHandlerPrivate::handleTracksChanged(const TrackList& tracks)
             continue;
         }
 
-        TrackList playlistTracks  = playlist->tracks();
-        const auto updatedIndexes = Utils::updateCommonTracks(playlistTracks, tracks, Utils::CommonOperation::Update);
-
+        const auto updatedIndexes = playlist->updateTracks(tracks);
         if(!updatedIndexes.empty()) {
-            playlist->replaceTracks(playlistTracks);
             emit m_self->tracksChanged(playlist.get(), updatedIndexes);
         }
     }
@@ -182,11 +178,8 @@ void PlaylistHandlerPrivate::handleTracksChanged(const TrackList& tracks)
 void PlaylistHandlerPrivate::handleTracksUpdated(const TrackList& tracks)
 {
     for(auto& playlist : m_playlists) {
-        TrackList playlistTracks  = playlist->tracks();
-        const auto updatedIndexes = Utils::updateCommonTracks(playlistTracks, tracks, Utils::CommonOperation::Update);
-
+        const auto updatedIndexes = playlist->updateTracks(tracks);
         if(!updatedIndexes.empty()) {
-            playlist->replaceTracks(playlistTracks);
             emit m_self->tracksUpdated(playlist.get(), updatedIndexes);
         }
     }
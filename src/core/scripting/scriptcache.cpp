@@ -19,64 +19,98 @@
 
 #include "scriptcache.h"
 
+#include <limits>
+
 constexpr auto DefaultLimit = 20;
+// Per-parser caches are bounded by entry count only
+constexpr auto DefaultMemoryLimit = std::numeric_limits<size_t>::max();
 
-namespace Fooyin {
-ScriptCache::ScriptCache()
-    : m_cacheLimit{DefaultLimit}
-{ }
+constexpr auto SharedLimit       = 5000;
+constexpr auto SharedMemoryLimit = 8 * 1024 * 1024;
 
-ParsedScript& ScriptCache::operator[](const QString& key)
+namespace {
+size_t expressionCost(const Fooyin::Expression& expr)
 {
-    auto it = m_parsedScripts.find(key);
-    if(it != m_parsedScripts.end()) {
-        auto orderIt = std::ranges::find(m_order, key);
-        if(orderIt != m_order.cend()) {
-            m_order.erase(orderIt);
+    using namespace Fooyin;
+
+    size_t cost = sizeof(Expression);
+
+    if(const auto* value = std::get_if<QString>(&expr.value)) {
+        cost += static_cast<size_t>(value->size()) * sizeof(QChar);
+    }
+    else if(const auto* func = std::get_if<FuncValue>(&expr.value)) {
+        cost += static_cast<size_t>(func->name.size() + func->source.size()) * sizeof(QChar);
+        for(const auto& arg : func->args) {
+            cost += expressionCost(arg);
         }
-        m_order.push_back(key);
-        return it->second;
+    }
+    else if(const auto* list = std::get_if<ExpressionList>(&expr.value)) {
+        for(const auto& subExpr : *list) {
+            cost += expressionCost(subExpr);
+        }
+    }
+
+    return cost;
+}
+
+size_t scriptCost(const QString& key, const Fooyin::ParsedScript& script)
+{
+    size_t cost = sizeof(Fooyin::ParsedScript)
+                + static_cast<size_t>(key.size() + script.input.size()) * sizeof(QChar);
+
+    for(const auto& expr : script.expressions) {
+        cost += expressionCost(expr);
+    }
+    for(const auto& error : script.errors) {
+        cost += sizeof(Fooyin::ScriptError)
+              + static_cast<size_t>(error.value.size() + error.message.size()) * sizeof(QChar);
     }
 
-    insert(key, {});
-    return m_parsedScripts.at(key);
+    return cost;
 }
+} // namespace
+
+namespace Fooyin {
+ScriptCache::ScriptCache()
+    : m_cacheLimit{DefaultLimit}
+    , m_memoryLimit{DefaultMemoryLimit}
+{ }
 
 bool ScriptCache::contains(const QString& key) const
 {
-    return m_parsedScripts.contains(key);
+    return m_index.contains(key);
 }
 
-ParsedScript ScriptCache::get(const QString& key) const
+std::optional<ParsedScript> ScriptCache::get(const QString& key)
 {
-    if(m_parsedScripts.contains(key)) {
-        return m_parsedScripts.at(key);
+    const auto it = m_index.find(key);
+    if(it == m_index.cend()) {
+        ++m_misses;
+        return {};
     }
-    return {};
+
+    ++m_hits;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->script;
 }
 
 void ScriptCache::insert(const QString& key, const ParsedScript& script)
 {
-    auto it = m_parsedScripts.find(key);
-    if(it != m_parsedScripts.end()) {
-        it->second = script;
+    const size_t cost = scriptCost(key, script);
 
-        auto orderIt = std::ranges::find(m_order, key);
-        if(orderIt != m_order.cend()) {
-            m_order.erase(orderIt);
-        }
-        m_order.push_back(key);
+    if(const auto it = m_index.find(key); it != m_index.end()) {
+        m_memoryUsage -= it->second->cost;
+        it->second->script = script;
+        it->second->cost   = cost;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
     }
     else {
-        m_order.push_back(key);
-        m_parsedScripts[key] = script;
+        m_entries.push_front({.key = key, .script = script, .cost = cost});
+        m_index.emplace(key, m_entries.begin());
     }
 
-    if(std::cmp_greater(m_parsedScripts.size(), m_cacheLimit)) {
-        const QString& oldestKey = m_order.front();
-        m_order.erase(m_order.begin());
-        m_parsedScripts.erase(oldestKey);
-    }
+    m_memoryUsage += cost;
+    evict();
 }
 
 int ScriptCache::limit() const
@@ -87,11 +121,63 @@ int ScriptCache::limit() const
 void ScriptCache::setLimit(int limit)
 {
     m_cacheLimit = limit;
+    evict();
+}
+
+size_t ScriptCache::memoryLimit() const
+{
+    return m_memoryLimit;
+}
+
+void ScriptCache::setMemoryLimit(size_t bytes)
+{
+    m_memoryLimit = bytes;
+    evict();
 }
 
 void ScriptCache::clear()
 {
-    m_parsedScripts.clear();
-    m_order.clear();
+    m_entries.clear();
+    m_index.clear();
+    m_memoryUsage = 0;
+}
+
+ScriptCacheStats ScriptCache::stats() const
+{
+    return {.hits        = m_hits,
+            .misses      = m_misses,
+            .evictions   = m_evictions,
+            .entries     = m_index.size(),
+            .memoryUsage = m_memoryUsage};
+}
+
+ScriptCache& ScriptCache::shared()
+{
+    static ScriptCache cache = []() {
+        ScriptCache sharedCache;
+        sharedCache.setLimit(SharedLimit);
+        sharedCache.setMemoryLimit(SharedMemoryLimit);
+        return sharedCache;
+    }();
+    return cache;
+}
+
+std::mutex& ScriptCache::sharedGuard()
+{
+    static std::mutex guard;
+    return guard;
+}
+
+void ScriptCache::evict()
+{
+    // Always keep the most recent entry, even if it exceeds the memory limit on its own
+    while(m_entries.size() > 1
+          && (std::cmp_greater(m_entries.size(), m_cacheLimit) || m_memoryUsage > m_memoryLimit)) {
+        const Entry& oldest = m_entries.back();
+        m_memoryUsage -= oldest.cost;
+        m_index.erase(oldest.key);
+        m_entries.pop_back();
+        ++m_evictions;
+    }
 }
 } // namespace Fooyin
@@ -21,25 +21,59 @@
 
 #include <core/scripting/scriptparser.h>
 
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
 namespace Fooyin {
+/*!
+ * LRU cache of parsed scripts keyed by their input.
+ * Lookups, insertions and evictions are all O(1). Entries are evicted once
+ * either the entry limit or the (approximate) memory limit is exceeded.
+ */
 class ScriptCache
 {
 public:
     ScriptCache();
 
-    ParsedScript& operator[](const QString& key);
-
-    bool contains(const QString& key) const;
-    ParsedScript get(const QString& key) const;
+    [[nodiscard]] bool contains(const QString& key) const;
+    std::optional<ParsedScript> get(const QString& key);
     void insert(const QString& key, const ParsedScript& script);
 
     [[nodiscard]] int limit() const;
     void setLimit(int limit);
+    [[nodiscard]] size_t memoryLimit() const;
+    void setMemoryLimit(size_t bytes);
     void clear();
 
+    [[nodiscard]] ScriptCacheStats stats() const;
+
+    /** Returns the cache shared between all ScriptParser instances. */
+    static ScriptCache& shared();
+    /** Returns the guard which must be held while accessing the shared cache. */
+    static std::mutex& sharedGuard();
+
 private:
-    std::unordered_map<QString, ParsedScript> m_parsedScripts;
-    std::vector<QString> m_order;
+    struct Entry
+    {
+        QString key;
+        ParsedScript script;
+        size_t cost{0};
+    };
+    using EntryList = std::list<Entry>;
+
+    void evict();
+
+    EntryList m_entries; // Most recently used first
+    std::unordered_map<QString, EntryList::iterator> m_index;
+
     int m_cacheLimit;
+    size_t m_memoryLimit;
+    size_t m_memoryUsage{0};
+
+    uint64_t m_hits{0};
+    uint64_t m_misses{0};
+    uint64_t m_evictions{0};
 };
 } // namespace Fooyin
@@ -208,6 +208,8 @@ public:
     ScriptResult evalVariableList(const Expression& exp, const auto& tracks);
     ScriptResult evalVariableRaw(const Expression& exp, const auto& tracks);
     ScriptResult evalFunction(const Expression& exp, const auto& tracks);
+    ScriptResult callFunction(const FuncValue& func, const auto& tracks);
+    ScriptResult evalMemoisedFunction(const FuncValue& func, const Track& track);
     ScriptResult evalFunctionArg(const Expression& exp, const auto& tracks);
     ScriptResult evalConditional(const Expression& exp, const auto& tracks);
     ScriptResult evalNot(const Expression& exp, const auto& tracks);
@@ -255,6 +257,12 @@ public:
     Qt::SortOrder m_sortOrder{Qt::AscendingOrder};
     int m_limit{0};
     int m_filteredCount{0};
+
+    bool m_memoiseFunctions{false};
+    bool m_usedStateValue{false};
+    QString m_memoTrack;
+    std::unordered_map<QString, ScriptResult> m_memo;
+    ScriptMemoStats m_memoStats;
 };
 
 ScriptParserPrivate::ScriptParserPrivate(ScriptParser* self, ScriptRegistry* registry)
@@ -458,6 +466,8 @@ Expression ScriptParserPrivate::variable()
 
 Expression ScriptParserPrivate::function()
 {
+    const int start = m_previous.position;
+
     advance();
 
     if(m_previous.type != TokenType::TokLiteral) {
@@ -481,8 +491,12 @@ Expression ScriptParserPrivate::function()
         }
     }
 
-    expr.value = funcExpr;
     consume(TokenType::TokRightParen, QObject::tr("Expected %1 at end of function").arg("')'"_L1));
+    if(start >= 0 && m_previous.type == TokenType::TokRightParen) {
+        funcExpr.source = m_currentInput.mid(start, m_previous.position - start + 1);
+    }
+
+    expr.value = funcExpr;
     return expr;
 }
 
@@ -884,8 +898,12 @@ ScriptResult ScriptParserPrivate::evalLiteral(const Expression& exp)
 
 ScriptResult ScriptParserPrivate::evalVariable(const Expression& exp, const auto& tracks)
 {
-    const QString var   = std::get<QString>(exp.value);
-    ScriptResult result = m_registry->value(var.toLower(), tracks);
+    const QString var = std::get<QString>(exp.value).toLower();
+    if(m_memoiseFunctions && m_registry->isStateVariable(var)) {
+        m_usedStateValue = true;
+    }
+
+    ScriptResult result = m_registry->value(var, tracks);
 
     if(!result.cond) {
         return {};
@@ -900,8 +918,12 @@ ScriptResult ScriptParserPrivate::evalVariable(const Expression& exp, const auto
 
 ScriptResult ScriptParserPrivate::evalVariableList(const Expression& exp, const auto& tracks)
 {
-    const QString var = std::get<QString>(exp.value);
-    return m_registry->value(var.toLower(), tracks);
+    const QString var = std::get<QString>(exp.value).toLower();
+    if(m_memoiseFunctions && m_registry->isStateVariable(var)) {
+        m_usedStateValue = true;
+    }
+
+    return m_registry->value(var, tracks);
 }
 
 ScriptResult ScriptParserPrivate::evalVariableRaw(const Expression& exp, const auto& tracks)
@@ -930,13 +952,50 @@ ScriptResult ScriptParserPrivate::evalVariableRaw(const Expression& exp, const a
 
 ScriptResult ScriptParserPrivate::evalFunction(const Expression& exp, const auto& tracks)
 {
-    auto func = std::get<FuncValue>(exp.value);
+    const auto& func = std::get<FuncValue>(exp.value);
+
+    if constexpr(std::is_same_v<std::decay_t<decltype(tracks)>, Track>) {
+        if(m_memoiseFunctions && !m_isQuery && !func.source.isEmpty()) {
+            return evalMemoisedFunction(func, tracks);
+        }
+    }
+
+    return callFunction(func, tracks);
+}
+
+ScriptResult ScriptParserPrivate::callFunction(const FuncValue& func, const auto& tracks)
+{
     ScriptValueList args;
     std::ranges::transform(func.args, std::back_inserter(args),
                            [this, &tracks](const Expression& arg) { return evalExpression(arg, tracks); });
     return m_registry->function(func.name, args, tracks);
 }
 
+ScriptResult ScriptParserPrivate::evalMemoisedFunction(const FuncValue& func, const Track& track)
+{
+    if(m_memoTrack != track.uniqueFilepath()) {
+        m_memo.clear();
+        m_memoTrack = track.uniqueFilepath();
+    }
+
+    if(const auto it = m_memo.find(func.source); it != m_memo.cend()) {
+        ++m_memoStats.hits;
+        return it->second;
+    }
+
+    ++m_memoStats.misses;
+
+    const bool parentUsedState = std::exchange(m_usedStateValue, m_registry->isStateFunction(func.name));
+    ScriptResult result        = callFunction(func, track);
+
+    if(!m_usedStateValue) {
+        m_memo.emplace(func.source, result);
+    }
+    m_usedStateValue = parentUsedState || m_usedStateValue;
+
+    return result;
+}
+
 ScriptResult ScriptParserPrivate::evalFunctionArg(const Expression& exp, const auto& tracks)
 {
     ScriptResult result;
@@ -1235,8 +1294,11 @@ ParsedScript ScriptParserPrivate::parse(const QString& input)
     m_scanner.setSkipWhitespace(false);
     m_currentScript = {};
 
-    if(m_cache.contains(input)) {
-        return m_cache.get(input);
+    {
+        const std::scoped_lock lock{ScriptCache::sharedGuard()};
+        if(auto script = ScriptCache::shared().get(input)) {
+            return script.value();
+        }
     }
 
     m_currentInput        = input;
@@ -1254,7 +1316,11 @@ ParsedScript ScriptParserPrivate::parse(const QString& input)
     }
 
     consume(TokenType::TokEos, QObject::tr("Expected end of script"));
-    m_cache.insert(input, m_currentScript);
+
+    {
+        const std::scoped_lock lock{ScriptCache::sharedGuard()};
+        ScriptCache::shared().insert(input, m_currentScript);
+    }
 
     return m_currentScript;
 }
@@ -1269,8 +1335,8 @@ ParsedScript ScriptParserPrivate::parseQuery(const QString& input)
     m_scanner.setSkipWhitespace(true);
     m_currentScript = {};
 
-    if(m_cache.contains(input)) {
-        return m_cache.get(input);
+    if(auto script = m_cache.get(input)) {
+        return script.value();
     }
 
     m_currentInput        = input;
@@ -1404,8 +1470,8 @@ TrackListType ScriptParserPrivate::evaluateQuery(const ParsedScript& input, cons
             }
         }
         if constexpr(std::is_same_v<TrackListType, PlaylistTrackList>) {
-            filteredTracks = m_sorter.calcSortTracks(sort, filteredTracks, PlaylistTrack::extractor,
-                                                     PlaylistTrack::extractorConst, m_sortOrder);
+            filteredTracks
+                = m_sorter.calcSortTracks(sort, filteredTracks, PlaylistTrack::extractorConst, m_sortOrder);
         }
         else {
             filteredTracks = m_sorter.calcSortTracks(sort, filteredTracks, m_sortOrder);
@@ -1703,4 +1769,38 @@ void ScriptParser::clearCache()
 {
     p->m_cache.clear();
 }
+
+ScriptCacheStats ScriptParser::sharedCacheStats()
+{
+    const std::scoped_lock lock{ScriptCache::sharedGuard()};
+    return ScriptCache::shared().stats();
+}
+
+void ScriptParser::setSharedCacheMemoryLimit(size_t bytes)
+{
+    const std::scoped_lock lock{ScriptCache::sharedGuard()};
+    ScriptCache::shared().setMemoryLimit(bytes);
+}
+
+void ScriptParser::setMemoiseFunctions(bool enabled)
+{
+    p->m_memoiseFunctions = enabled;
+    clearMemo();
+}
+
+void ScriptParser::clearMemo()
+{
+    p->m_memo.clear();
+    p->m_memoTrack.clear();
+}
+
+ScriptMemoStats ScriptParser::memoStats() const
+{
+    return p->m_memoStats;
+}
+
+void ScriptParser::resetMemoStats()
+{
+    p->m_memoStats = {};
+}
 } // namespace Fooyin
@@ -181,7 +181,7 @@ void ScriptRegistryPrivate::addPlaybackVars()
     m_playbackVars[u"PLAYBACK_TIME"_s] = [this]() {
         return Utils::msToString(m_playerController ? m_playerController->currentPosition() : 0);
     };
-    m_playbackVars[u"PLAYBACK_TIME_s"_s] = [this]() {
+    m_playbackVars[u"PLAYBACK_TIME_S"_s] = [this]() {
         return QString::number(m_playerController ? m_playerController->currentPosition() / 1000 : 0);
     };
     m_playbackVars[u"PLAYBACK_TIME_REMAINING"_s] = [this]() {
@@ -491,6 +491,16 @@ bool ScriptRegistry::isFunction(const QString& func) const
     return p->m_funcs.contains(func);
 }
 
+bool ScriptRegistry::isStateVariable(const QString& var) const
+{
+    return p->m_playbackVars.contains(var.toUpper());
+}
+
+bool ScriptRegistry::isStateFunction(const QString& func) const
+{
+    return func == "rand"_L1;
+}
+
 ScriptResult ScriptRegistry::value(const QString& var, const Track& track) const
 {
     if(var.isEmpty() || (!isVariable(var, track) && !isListVariable(var))) {
@@ -0,0 +1,233 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "thumbnaildatabase.h"
+
+#include <utils/database/dbquery.h>
+#include <utils/database/dbtransaction.h>
+
+#include <QBuffer>
+#include <QDateTime>
+
+#include <cstring>
+
+using namespace Qt::StringLiterals;
+
+// Only refresh the access time of a thumbnail once per period to avoid a write on every read
+constexpr auto AccessResolution = 3600;
+
+namespace {
+QByteArray serialiseImage(const QImage& image, Fooyin::ThumbnailDatabase::Format format)
+{
+    if(format == Fooyin::ThumbnailDatabase::Format::Raw) {
+        const QImage raw = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        return {reinterpret_cast<const char*>(raw.constBits()), static_cast<qsizetype>(raw.sizeInBytes())};
+    }
+
+    QByteArray data;
+    QBuffer buffer{&data};
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "JPG", 85);
+
+    return data;
+}
+
+QImage deserialiseImage(const QByteArray& data, Fooyin::ThumbnailDatabase::Format format, int width, int height)
+{
+    if(format == Fooyin::ThumbnailDatabase::Format::Raw) {
+        QImage image{width, height, QImage::Format_ARGB32_Premultiplied};
+        if(image.isNull() || image.sizeInBytes() != data.size()) {
+            return {};
+        }
+        std::memcpy(image.bits(), data.constData(), data.size());
+        return image;
+    }
+
+    QImage image;
+    image.loadFromData(data, "JPG");
+    return image;
+}
+
+qint64 currentTime()
+{
+    return QDateTime::currentSecsSinceEpoch();
+}
+} // namespace
+
+namespace Fooyin {
+void ThumbnailDatabase::initialiseDatabase() const
+{
+    // Allow readers on other threads while a thumbnail is being written
+    DbQuery walQuery{db(), u"PRAGMA journal_mode=WAL;"_s};
+    walQuery.exec();
+
+    const auto statement = u"CREATE TABLE IF NOT EXISTS Thumbnails ("
+                           "CoverKey TEXT NOT NULL, "
+                           "Size INTEGER NOT NULL, "
+                           "Format INTEGER NOT NULL, "
+                           "Width INTEGER NOT NULL, "
+                           "Height INTEGER NOT NULL, "
+                           "ByteSize INTEGER NOT NULL, "
+                           "LastAccess INTEGER NOT NULL, "
+                           "Data BLOB, "
+                           "PRIMARY KEY (CoverKey, Size));"_s;
+
+    DbQuery query{db(), statement};
+    query.exec();
+
+    DbQuery indexQuery{db(), u"CREATE INDEX IF NOT EXISTS ThumbnailsAccessIndex ON Thumbnails(LastAccess);"_s};
+    indexQuery.exec();
+}
+
+QImage ThumbnailDatabase::loadThumbnail(const QString& key, int size) const
+{
+    const auto statement = u"SELECT Format, Width, Height, Data, LastAccess FROM Thumbnails "
+                           "WHERE CoverKey = :coverKey AND Size = :size;"_s;
+
+    DbQuery query{db(), statement};
+
+    query.bindValue(u":coverKey"_s, key);
+    query.bindValue(u":size"_s, size);
+
+    if(!query.exec() || !query.next()) {
+        return {};
+    }
+
+    const auto format     = static_cast<Format>(query.value(0).toInt());
+    const int width       = query.value(1).toInt();
+    const int height      = query.value(2).toInt();
+    const auto lastAccess = query.value(4).toLongLong();
+
+    QImage image = deserialiseImage(query.value(3).toByteArray(), format, width, height);
+
+    const auto now = currentTime();
+    if(!image.isNull() && now - lastAccess > AccessResolution) {
+        DbQuery accessQuery{
+            db(), u"UPDATE Thumbnails SET LastAccess = :lastAccess WHERE CoverKey = :coverKey AND Size = :size;"_s};
+        accessQuery.bindValue(u":lastAccess"_s, now);
+        accessQuery.bindValue(u":coverKey"_s, key);
+        accessQuery.bindValue(u":size"_s, size);
+        accessQuery.exec();
+    }
+
+    return image;
+}
+
+int ThumbnailDatabase::storeThumbnail(const QString& key, int size, const QImage& image, Format format) const
+{
+    if(image.isNull()) {
+        return 0;
+    }
+
+    const QByteArray data = serialiseImage(image, format);
+    if(data.isEmpty()) {
+        return 0;
+    }
+
+    const auto statement
+        = u"INSERT OR REPLACE INTO Thumbnails (CoverKey, Size, Format, Width, Height, ByteSize, LastAccess, Data) "
+          "VALUES (:coverKey, :size, :format, :width, :height, :byteSize, :lastAccess, :data);"_s;
+
+    DbQuery query{db(), statement};
+
+    query.bindValue(u":coverKey"_s, key);
+    query.bindValue(u":size"_s, size);
+    query.bindValue(u":format"_s, static_cast<int>(format));
+    query.bindValue(u":width"_s, image.width());
+    query.bindValue(u":height"_s, image.height());
+    query.bindValue(u":byteSize"_s, data.size());
+    query.bindValue(u":lastAccess"_s, currentTime());
+    query.bindValue(u":data"_s, data);
+
+    return query.exec() ? static_cast<int>(data.size()) : 0;
+}
+
+bool ThumbnailDatabase::removeThumbnails(const QString& key) const
+{
+    const auto statement = u"DELETE FROM Thumbnails WHERE CoverKey = :coverKey;"_s;
+
+    DbQuery query{db(), statement};
+    query.bindValue(u":coverKey"_s, key);
+
+    return query.exec();
+}
+
+bool ThumbnailDatabase::clearCache() const
+{
+    const auto statement = u"DELETE FROM Thumbnails;"_s;
+
+    DbQuery query{db(), statement};
+    DbQuery cleanQuery{db(), u"VACUUM"_s};
+
+    return query.exec() && cleanQuery.exec();
+}
+
+uint64_t ThumbnailDatabase::cacheSize() const
+{
+    DbQuery query{db(), u"SELECT COALESCE(SUM(ByteSize), 0) FROM Thumbnails;"_s};
+
+    if(query.exec() && query.next()) {
+        return query.value(0).toULongLong();
+    }
+
+    return 0;
+}
+
+bool ThumbnailDatabase::trimCache(uint64_t maxSize) const
+{
+    uint64_t total = cacheSize();
+    if(total <= maxSize) {
+        return true;
+    }
+
+    // Evict slightly more than needed so the next few stores don't trigger another trim
+    const uint64_t target = maxSize - (maxSize / 10);
+
+    std::vector<std::pair<QString, int>> evicted;
+
+    {
+        DbQuery query{db(), u"SELECT CoverKey, Size, ByteSize FROM Thumbnails ORDER BY LastAccess;"_s};
+        if(!query.exec()) {
+            return false;
+        }
+
+        while(total > target && query.next()) {
+            evicted.emplace_back(query.value(0).toString(), query.value(1).toInt());
+            total -= std::min(total, query.value(2).toULongLong());
+        }
+    }
+
+    DbTransaction transaction{db()};
+    if(!transaction) {
+        return false;
+    }
+
+    DbQuery query{db(), u"DELETE FROM Thumbnails WHERE CoverKey = :coverKey AND Size = :size;"_s};
+
+    for(const auto& [key, size] : evicted) {
+        query.bindValue(u":coverKey"_s, key);
+        query.bindValue(u":size"_s, size);
+        if(!query.exec()) {
+            return false;
+        }
+    }
+
+    return transaction.commit();
+}
+} // namespace Fooyin
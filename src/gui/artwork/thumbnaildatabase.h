@@ -0,0 +1,52 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <utils/database/dbmodule.h>
+
+#include <QImage>
+
+namespace Fooyin {
+/*!
+ * Stores pre-scaled cover thumbnails as blobs in a single database, keyed by
+ * cover key and pixel size, with least-recently-used eviction.
+ */
+class ThumbnailDatabase : public DbModule
+{
+public:
+    enum class Format : uint8_t
+    {
+        Jpeg = 0,
+        // Premultiplied ARGB32, which can be uploaded without decoding
+        Raw = 1,
+    };
+
+    void initialiseDatabase() const;
+
+    [[nodiscard]] QImage loadThumbnail(const QString& key, int size) const;
+    [[nodiscard]] int storeThumbnail(const QString& key, int size, const QImage& image, Format format) const;
+    [[nodiscard]] bool removeThumbnails(const QString& key) const;
+    [[nodiscard]] bool clearCache() const;
+
+    [[nodiscard]] uint64_t cacheSize() const;
+    // Removes the least recently used thumbnails until the cache is below @p maxSize bytes
+    [[nodiscard]] bool trimCache(uint64_t maxSize) const;
+};
+} // namespace Fooyin
@@ -19,6 +19,7 @@
 
 #include <gui/coverprovider.h>
 
+#include "artwork/thumbnaildatabase.h"
 #include "internalguisettings.h"
 
 #include <core/engine/audioloader.h>
@@ -27,8 +28,11 @@
 #include <gui/guiconstants.h>
 #include <gui/guipaths.h>
 #include <gui/guisettings.h>
-#include <utils/async.h>
 #include <utils/crypto.h>
+#include <utils/database/dbconnectionhandler.h>
+#include <utils/database/dbconnectionpool.h>
+#include <utils/database/dbconnectionprovider.h>
+#include <utils/ioscheduler.h>
 #include <utils/settings/settingsmanager.h>
 #include <utils/utils.h>
 
@@ -41,14 +45,27 @@
 #include <QLoggingCategory>
 #include <QMimeDatabase>
 #include <QPixmapCache>
-
+#include <QThread>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <map>
+#include <optional>
 #include <set>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 Q_LOGGING_CATEGORY(COV_PROV, "fy.coverprovider")
 
 using namespace Qt::StringLiterals;
 
-constexpr auto MaxSize = 1024;
+constexpr auto MaxSize         = 1024;
+constexpr auto MaxCoverWorkers = 4;
+// Trim the thumbnail store each time roughly this fraction of its budget has been written
+constexpr auto TrimFraction = 16;
 
 // Used to keep track of tracks without artwork so we don't query the filesystem more than necessary
 std::set<QString> Fooyin::CoverProvider::m_noCoverKeys;
@@ -66,16 +83,150 @@ QString generateThumbCoverKey(const QString& key, int size)
     return Fooyin::Utils::generateHash(u"Thumb|%1|%2"_s.arg(key).arg(size));
 }
 
-QString coverThumbnailPath(const QString& key)
+QString thumbnailDbPath()
+{
+    return Fooyin::Gui::coverPath() + u"thumbnails.db"_s;
+}
+
+int thumbnailPixelSize(int size)
+{
+    return static_cast<int>(size * Fooyin::Utils::windowDpr());
+}
+
+/*!
+ * Owns the connection pool for the thumbnail database and applies its size budget.
+ * Shared by all providers and cover workers; each thread must hold a DbConnectionHandler.
+ */
+class ThumbnailStore
+{
+public:
+    ThumbnailStore();
+
+    ThumbnailStore(const ThumbnailStore&)            = delete;
+    ThumbnailStore& operator=(const ThumbnailStore&) = delete;
+
+    static std::shared_ptr<ThumbnailStore> instance();
+
+    [[nodiscard]] Fooyin::DbConnectionPoolPtr pool() const;
+
+    void setSizeLimit(uint64_t bytes);
+    void setStoreRaw(bool raw);
+
+    [[nodiscard]] QImage load(const QString& key, int size) const;
+    void store(const QString& key, int size, const QImage& image);
+    void remove(const QString& key) const;
+    void clear() const;
+
+private:
+    Fooyin::DbConnectionPoolPtr m_pool;
+    // Connection for the thread which created the store
+    Fooyin::DbConnectionHandler m_dbHandler;
+    Fooyin::ThumbnailDatabase m_thumbnailDb;
+
+    std::atomic<uint64_t> m_sizeLimit;
+    std::atomic_bool m_storeRaw;
+    std::atomic<uint64_t> m_bytesSinceTrim;
+    std::mutex m_trimGuard;
+};
+
+ThumbnailStore::ThumbnailStore()
+    : m_sizeLimit{256 * 1024 * 1024}
+    , m_storeRaw{false}
+    , m_bytesSinceTrim{std::numeric_limits<uint64_t>::max() / 2}
 {
-    return Fooyin::Gui::coverPath() + key + u".jpg"_s;
+    const bool isNewStore = !QFileInfo::exists(thumbnailDbPath());
+
+    Fooyin::DbConnection::DbParams params;
+    params.type           = u"QSQLITE"_s;
+    params.connectOptions = u"QSQLITE_BUSY_TIMEOUT=5000"_s;
+    params.filePath       = thumbnailDbPath();
+
+    m_pool      = Fooyin::DbConnectionPool::create(params, u"thumbnails"_s);
+    m_dbHandler = Fooyin::DbConnectionHandler{m_pool};
+
+    m_thumbnailDb.initialise(Fooyin::DbConnectionProvider{m_pool});
+    m_thumbnailDb.initialiseDatabase();
+
+    if(isNewStore) {
+        // Remove thumbnails left over from the previous one-file-per-cover cache
+        QDir cache{Fooyin::Gui::coverPath()};
+        const QStringList legacyFiles = cache.entryList({u"*.jpg"_s}, QDir::Files);
+        for(const QString& file : legacyFiles) {
+            cache.remove(file);
+        }
+    }
 }
 
-void saveThumbnail(const QImage& cover, const QString& key)
+std::shared_ptr<ThumbnailStore> ThumbnailStore::instance()
 {
-    QFile file{coverThumbnailPath(key)};
-    file.open(QIODevice::WriteOnly);
-    cover.save(&file, "JPG", 85);
+    static std::mutex instanceGuard;
+    static std::weak_ptr<ThumbnailStore> shared;
+
+    const std::scoped_lock lock{instanceGuard};
+
+    auto store = shared.lock();
+    if(!store) {
+        store  = std::make_shared<ThumbnailStore>();
+        shared = store;
+    }
+    return store;
+}
+
+Fooyin::DbConnectionPoolPtr ThumbnailStore::pool() const
+{
+    return m_pool;
+}
+
+void ThumbnailStore::setSizeLimit(uint64_t bytes)
+{
+    m_sizeLimit = bytes;
+}
+
+void ThumbnailStore::setStoreRaw(bool raw)
+{
+    m_storeRaw = raw;
+}
+
+QImage ThumbnailStore::load(const QString& key, int size) const
+{
+    return m_thumbnailDb.loadThumbnail(key, size);
+}
+
+void ThumbnailStore::store(const QString& key, int size, const QImage& image)
+{
+    const auto format = m_storeRaw ? Fooyin::ThumbnailDatabase::Format::Raw : Fooyin::ThumbnailDatabase::Format::Jpeg;
+    const int written = m_thumbnailDb.storeThumbnail(key, size, image, format);
+
+    const uint64_t limit = m_sizeLimit;
+    if(m_bytesSinceTrim.fetch_add(written) + written < limit / TrimFraction) {
+        return;
+    }
+
+    const std::unique_lock lock{m_trimGuard, std::try_to_lock};
+    if(lock.owns_lock()) {
+        m_bytesSinceTrim = 0;
+        if(!m_thumbnailDb.trimCache(limit)) {
+            qCDebug(COV_PROV) << "Failed to trim thumbnail cache";
+        }
+    }
+}
+
+void ThumbnailStore::remove(const QString& key) const
+{
+    const Fooyin::DbConnectionHandler handler{m_pool};
+
+    if(!m_thumbnailDb.removeThumbnails(key)) {
+        qCWarning(COV_PROV) << "Unable to remove thumbnails for" << key;
+    }
+}
+
+void ThumbnailStore::clear() const
+{
+    const Fooyin::DbConnectionHandler handler{m_pool};
+
+    if(!m_thumbnailDb.clearCache()) {
+        qCWarning(COV_PROV) << "Unable to clear thumbnail cache";
+    }
 }
 
 QSize calculateScaledSize(const QSize& originalSize, int maxSize)
@@ -106,42 +257,132 @@ QPixmap loadCachedCover(const QString& key, int size = 0)
     return {};
 }
 
-QString findDirectoryCover(const Fooyin::CoverPaths& paths, const Fooyin::Track& track, Fooyin::Track::Cover type)
+/*!
+ * Caches the file each cover path pattern resolved to, keyed by directory and evaluated pattern,
+ * so tracks from the same album don't list the same directory again.
+ * Entries for a directory are dropped when the library watcher reports it has changed, and for
+ * a whole library when it's scanned, so covers added while nothing was watching are still found.
+ */
+class DirectoryCoverCache
+{
+public:
+    [[nodiscard]] std::optional<QString> find(const QString& dir, const QString& pattern) const
+    {
+        const std::shared_lock lock{m_mutex};
+
+        const auto dirIt = m_dirs.find(dir);
+        if(dirIt == m_dirs.cend()) {
+            return {};
+        }
+
+        const auto patternIt = dirIt->second.find(pattern);
+        if(patternIt == dirIt->second.cend()) {
+            return {};
+        }
+
+        return patternIt->second;
+    }
+
+    void insert(const QString& dir, const QString& pattern, const QString& coverPath)
+    {
+        const std::unique_lock lock{m_mutex};
+
+        if(m_dirs.size() >= MaxCachedDirs && !m_dirs.contains(dir)) {
+            m_dirs.erase(m_dirs.begin());
+        }
+        m_dirs[dir][pattern] = coverPath;
+    }
+
+    void invalidate(const QStringList& dirs)
+    {
+        const std::unique_lock lock{m_mutex};
+
+        for(const QString& dir : dirs) {
+            m_dirs.erase(QDir::cleanPath(dir));
+        }
+    }
+
+    void invalidateTree(const QString& root)
+    {
+        if(root.isEmpty()) {
+            return;
+        }
+
+        const QString rootPath = QDir::cleanPath(root);
+        const QString prefix   = rootPath.endsWith(u'/') ? rootPath : rootPath + u'/';
+
+        const std::unique_lock lock{m_mutex};
+
+        std::erase_if(m_dirs, [&rootPath, &prefix](const auto& entry) {
+            return entry.first == rootPath || entry.first.startsWith(prefix);
+        });
+    }
+
+    void clear()
+    {
+        const std::unique_lock lock{m_mutex};
+        m_dirs.clear();
+    }
+
+private:
+    static constexpr size_t MaxCachedDirs = 50000;
+
+    mutable std::shared_mutex m_mutex;
+    // Directory -> evaluated pattern -> resolved cover path (empty if nothing matched)
+    std::unordered_map<QString, std::unordered_map<QString, QString>> m_dirs;
+};
+
+DirectoryCoverCache& directoryCoverCache()
+{
+    static DirectoryCoverCache cache;
+    return cache;
+}
+
+QString findDirectoryCover(const Fooyin::CoverPaths& paths, const Fooyin::Track& track, Fooyin::Track::Cover type,
+                           Fooyin::ScriptParser& parser)
 {
     if(!track.isValid()) {
         return {};
     }
 
-    static Fooyin::ScriptParser parser;
-    static std::mutex parserGuard;
-    const std::scoped_lock lock{parserGuard};
-
-    QStringList filters;
+    const QStringList* coverPaths{nullptr};
 
     if(type == Fooyin::Track::Cover::Front) {
-        for(const auto& path : paths.frontCoverPaths) {
-            filters.emplace_back(parser.evaluate(path.trimmed(), track));
-        }
+        coverPaths = &paths.frontCoverPaths;
     }
     else if(type == Fooyin::Track::Cover::Back) {
-        for(const auto& path : paths.backCoverPaths) {
-            filters.emplace_back(parser.evaluate(path.trimmed(), track));
-        }
+        coverPaths = &paths.backCoverPaths;
     }
     else if(type == Fooyin::Track::Cover::Artist) {
-        for(const auto& path : paths.artistPaths) {
-            filters.emplace_back(parser.evaluate(path.trimmed(), track));
-        }
+        coverPaths = &paths.artistPaths;
     }
 
-    for(const auto& filter : filters) {
-        const QFileInfo fileInfo{QDir::cleanPath(filter)};
-        const QDir filePath{fileInfo.path()};
-        const QString filePattern  = fileInfo.fileName();
+    if(!coverPaths) {
+        return {};
+    }
+
+    auto& cache = directoryCoverCache();
+
+    for(const auto& path : *coverPaths) {
+        const QFileInfo fileInfo{QDir::cleanPath(parser.evaluate(path.trimmed(), track))};
+        const QString dir         = fileInfo.path();
+        const QString filePattern = fileInfo.fileName();
+
+        if(const auto cachedPath = cache.find(dir, filePattern)) {
+            if(!cachedPath->isEmpty()) {
+                return cachedPath.value();
+            }
+            continue;
+        }
+
+        const QDir filePath{dir};
         const QStringList fileList = filePath.entryList({filePattern}, QDir::Files);
+        const QString coverPath    = fileList.isEmpty() ? QString{} : filePath.absoluteFilePath(fileList.constFirst());
 
-        if(!fileList.isEmpty()) {
-            return filePath.absoluteFilePath(fileList.constFirst());
+        cache.insert(dir, filePattern, coverPath);
+
+        if(!coverPath.isEmpty()) {
+            return coverPath;
         }
     }
 
@@ -223,9 +464,9 @@ struct CoverLoader
     QImage cover;
 };
 
-QImage loadImageFromDirectory(CoverLoader& loader)
+QImage loadImageFromDirectory(CoverLoader& loader, Fooyin::ScriptParser& parser)
 {
-    const QString dirPath = findDirectoryCover(loader.paths, loader.track, loader.type);
+    const QString dirPath = findDirectoryCover(loader.paths, loader.track, loader.type, parser);
     if(dirPath.isEmpty()) {
         return {};
     }
@@ -238,7 +479,7 @@ QImage loadImageFromDirectory(CoverLoader& loader)
     return readImage(dirPath, loader.size, u"directory"_s);
 }
 
-QImage loadImageFromEmbedded(const CoverLoader& loader, const QString& cachePath)
+QImage loadImageFromEmbedded(const CoverLoader& loader, ThumbnailStore& store)
 {
     const QByteArray coverData = loader.audioLoader->readTrackCover(loader.track, loader.type);
     if(coverData.isEmpty()) {
@@ -247,37 +488,289 @@ QImage loadImageFromEmbedded(const CoverLoader& loader, const QString& cachePath
 
     QImage cover = readImage(coverData);
 
-    if(loader.isThumb && !cover.isNull() && !QFileInfo::exists(cachePath)) {
-        saveThumbnail(cover, loader.key);
+    if(loader.isThumb && !cover.isNull()) {
         cover = Fooyin::Utils::scaleImage(cover, loader.size, Fooyin::Utils::windowDpr());
+        store.store(loader.key, thumbnailPixelSize(loader.size), cover);
     }
 
     return cover;
 }
 
-CoverLoader loadCoverImage(CoverLoader loader)
+CoverLoader loadCoverImage(CoverLoader loader, ThumbnailStore& store, Fooyin::ScriptParser& parser)
 {
     CoverLoader result{loader};
 
-    const QString cachePath = coverThumbnailPath(loader.key);
-
     // First check disk cache
-    if(result.isThumb && QFileInfo::exists(cachePath)) {
-        result.cover = readImage(cachePath, loader.size, u"cached"_s);
+    if(result.isThumb) {
+        result.cover = store.load(loader.key, thumbnailPixelSize(loader.size));
+        if(!result.cover.isNull()) {
+            result.cover.setDevicePixelRatio(Fooyin::Utils::windowDpr());
+            return result;
+        }
     }
 
+    const auto lease = Fooyin::IoScheduler::instance()->acquire(loader.track.filepath(),
+                                                                Fooyin::IoScheduler::Priority::Interactive);
+
     // Then check directory paths
     if(result.cover.isNull()) {
-        result.cover = loadImageFromDirectory(loader);
+        result.cover = loadImageFromDirectory(loader, parser);
     }
 
     // Finally check metadata
     if(result.cover.isNull()) {
-        result.cover = loadImageFromEmbedded(loader, cachePath);
+        result.cover = loadImageFromEmbedded(loader, store);
     }
 
     return result;
 }
+
+QString requestId(const QString& key, bool thumbnail, CoverProvider::ThumbnailSize size)
+{
+    return key + u'|' + QString::number(thumbnail ? static_cast<int>(size) : -1);
+}
+
+QString requestId(const CoverLoader& loader)
+{
+    return requestId(loader.key, loader.isThumb, loader.size);
+}
+
+/*!
+ * Loads covers on a small set of long-lived worker threads shared by all providers.
+ * The most recently requested cover is always loaded next, identical requests from
+ * different providers are coalesced, and requests which haven't started can be cancelled.
+ */
+class CoverScheduler
+{
+public:
+    using Callback = std::function<void(const CoverLoader&)>;
+
+    CoverScheduler();
+    ~CoverScheduler();
+
+    CoverScheduler(const CoverScheduler&)            = delete;
+    CoverScheduler& operator=(const CoverScheduler&) = delete;
+
+    static std::shared_ptr<CoverScheduler> instance();
+
+    [[nodiscard]] std::shared_ptr<ThumbnailStore> thumbnailStore() const;
+
+    void request(const CoverLoader& loader, QObject* requester, Callback callback);
+    void prioritise(const QString& id);
+    // Returns the ids of the queued requests which were cancelled
+    std::vector<QString> cancel(const QObject* requester, bool includeRunning = false);
+
+private:
+    struct Waiter
+    {
+        QObject* requester;
+        Callback callback;
+    };
+
+    struct Request
+    {
+        CoverLoader loader;
+        uint64_t priority{0};
+        std::vector<Waiter> waiters;
+    };
+
+    void run();
+
+    std::shared_ptr<ThumbnailStore> m_store;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stopping{false};
+    uint64_t m_sequence{0};
+
+    std::unordered_map<QString, Request> m_queued;
+    std::map<uint64_t, QString> m_order;
+    std::unordered_map<QString, std::vector<Waiter>> m_running;
+    std::vector<std::unique_ptr<QThread>> m_workers;
+};
+
+CoverScheduler::CoverScheduler()
+    : m_store{ThumbnailStore::instance()}
+{
+    const int count = std::clamp(QThread::idealThreadCount(), 1, MaxCoverWorkers);
+    for(int i{0}; i < count; ++i) {
+        auto& worker = m_workers.emplace_back(QThread::create([this]() { run(); }));
+        worker->setObjectName(u"CoverWorker%1"_s.arg(i));
+        worker->start(QThread::LowPriority);
+    }
+}
+
+CoverScheduler::~CoverScheduler()
+{
+    {
+        const std::scoped_lock lock{m_mutex};
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+
+    for(const auto& worker : m_workers) {
+        worker->wait();
+    }
+}
+
+std::shared_ptr<CoverScheduler> CoverScheduler::instance()
+{
+    static std::mutex instanceGuard;
+    static std::weak_ptr<CoverScheduler> shared;
+
+    const std::scoped_lock lock{instanceGuard};
+
+    auto scheduler = shared.lock();
+    if(!scheduler) {
+        scheduler = std::make_shared<CoverScheduler>();
+        shared    = scheduler;
+    }
+    return scheduler;
+}
+
+std::shared_ptr<ThumbnailStore> CoverScheduler::thumbnailStore() const
+{
+    return m_store;
+}
+
+void CoverScheduler::request(const CoverLoader& loader, QObject* requester, Callback callback)
+{
+    const QString id = requestId(loader);
+
+    {
+        const std::scoped_lock lock{m_mutex};
+
+        if(auto running = m_running.find(id); running != m_running.end()) {
+            running->second.push_back({requester, std::move(callback)});
+            return;
+        }
+
+        auto [it, inserted] = m_queued.try_emplace(id);
+        auto& request       = it->second;
+        if(inserted) {
+            request.loader = loader;
+        }
+        else {
+            m_order.erase(request.priority);
+        }
+
+        request.priority = ++m_sequence;
+        m_order.emplace(request.priority, id);
+        request.waiters.push_back({requester, std::move(callback)});
+    }
+
+    m_cv.notify_one();
+}
+
+void CoverScheduler::prioritise(const QString& id)
+{
+    const std::scoped_lock lock{m_mutex};
+
+    auto it = m_queued.find(id);
+    if(it == m_queued.end()) {
+        return;
+    }
+
+    auto& request = it->second;
+    m_order.erase(request.priority);
+    request.priority = ++m_sequence;
+    m_order.emplace(request.priority, id);
+}
+
+std::vector<QString> CoverScheduler::cancel(const QObject* requester, bool includeRunning)
+{
+    const std::scoped_lock lock{m_mutex};
+
+    std::vector<QString> cancelled;
+
+    const auto isRequester = [requester](const Waiter& waiter) {
+        return waiter.requester == requester;
+    };
+
+    for(auto it = m_queued.begin(); it != m_queued.end();) {
+        auto& request = it->second;
+        if(std::erase_if(request.waiters, isRequester) > 0) {
+            cancelled.push_back(it->first);
+        }
+        if(request.waiters.empty()) {
+            m_order.erase(request.priority);
+            it = m_queued.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    if(includeRunning) {
+        for(auto& [id, waiters] : m_running) {
+            std::erase_if(waiters, isRequester);
+        }
+    }
+
+    return cancelled;
+}
+
+void CoverScheduler::run()
+{
+    const Fooyin::DbConnectionHandler dbHandler{m_store->pool()};
+    // Each worker evaluates cover paths with its own parser so lookups don't serialise
+    Fooyin::ScriptParser parser;
+
+    // Reader instances are reused for every cover in a burst of requests, and only
+    // destroyed once the queue drains (or before the thread quits)
+    std::vector<std::shared_ptr<Fooyin::AudioLoader>> usedLoaders;
+
+    const auto releaseInstances = [&usedLoaders]() {
+        for(const auto& loader : usedLoaders) {
+            loader->destroyThreadInstance();
+        }
+        usedLoaders.clear();
+    };
+
+    std::unique_lock lock{m_mutex};
+
+    while(true) {
+        if(m_order.empty() && !usedLoaders.empty()) {
+            lock.unlock();
+            releaseInstances();
+            lock.lock();
+        }
+
+        m_cv.wait(lock, [this]() { return m_stopping || !m_order.empty(); });
+        if(m_stopping) {
+            break;
+        }
+
+        const auto next = std::prev(m_order.end());
+        const QString id{next->second};
+        m_order.erase(next);
+
+        auto node       = m_queued.extract(id);
+        Request request = std::move(node.mapped());
+        m_running.emplace(id, std::move(request.waiters));
+
+        lock.unlock();
+
+        if(std::ranges::find(usedLoaders, request.loader.audioLoader) == usedLoaders.cend()) {
+            usedLoaders.push_back(request.loader.audioLoader);
+        }
+
+        const CoverLoader result = loadCoverImage(request.loader, *m_store, parser);
+
+        lock.lock();
+
+        auto running = m_running.find(id);
+        for(const auto& waiter : running->second) {
+            QMetaObject::invokeMethod(
+                waiter.requester, [callback = waiter.callback, result]() { callback(result); }, Qt::QueuedConnection);
+        }
+        m_running.erase(running);
+    }
+
+    lock.unlock();
+
+    releaseInstances();
+}
 } // namespace
 
 namespace Fooyin {
@@ -286,6 +779,10 @@ class FYGUI_NO_EXPORT CoverProvider::CoverProviderPrivate
 public:
     explicit CoverProviderPrivate(CoverProvider* self, std::shared_ptr<AudioLoader> audioLoader,
                                   SettingsManager* settings);
+    ~CoverProviderPrivate();
+
+    CoverProviderPrivate(const CoverProviderPrivate&)            = delete;
+    CoverProviderPrivate& operator=(const CoverProviderPrivate&) = delete;
 
     QPixmap loadNoCover();
     void processCoverResult(const CoverLoader& loader);
@@ -295,10 +792,12 @@ public:
     CoverProvider* m_self;
     std::shared_ptr<AudioLoader> m_audioLoader;
     SettingsManager* m_settings;
+    std::shared_ptr<CoverScheduler> m_scheduler;
 
     bool m_usePlacerholder{true};
     QPixmapCache::Key m_noCoverKey;
-    std::set<QString> m_pendingCovers;
+    // Scheduler ids of the requests still waiting for a result, one per cover key and size
+    std::unordered_set<QString> m_pendingCovers;
 
     CoverPaths m_paths;
 };
@@ -308,11 +807,28 @@ CoverProvider::CoverProviderPrivate::CoverProviderPrivate(CoverProvider* self, s
     : m_self{self}
     , m_audioLoader{std::move(audioLoader)}
     , m_settings{settings}
+    , m_scheduler{CoverScheduler::instance()}
     , m_paths{m_settings->value<Settings::Gui::Internal::TrackCoverPaths>().value<CoverPaths>()}
 {
     m_settings->subscribe<Settings::Gui::Internal::TrackCoverPaths>(
         m_self, [this](const QVariant& var) { m_paths = var.value<CoverPaths>(); });
     m_settings->subscribe<Settings::Gui::IconTheme>(m_self, [this]() { QPixmapCache::remove(m_noCoverKey); });
+
+    auto store = m_scheduler->thumbnailStore();
+    store->setSizeLimit(static_cast<uint64_t>(m_settings->value<Settings::Gui::Internal::ThumbnailCacheSize>()) * 1024
+                        * 1024);
+    store->setStoreRaw(m_settings->value<Settings::Gui::Internal::RawThumbnails>());
+
+    m_settings->subscribe<Settings::Gui::Internal::ThumbnailCacheSize>(m_self, [store](const int sizeMb) {
+        store->setSizeLimit(static_cast<uint64_t>(sizeMb) * 1024 * 1024);
+    });
+    m_settings->subscribe<Settings::Gui::Internal::RawThumbnails>(m_self,
+                                                                  [store](const bool raw) { store->setStoreRaw(raw); });
+}
+
+CoverProvider::CoverProviderPrivate::~CoverProviderPrivate()
+{
+    m_scheduler->cancel(m_self, true);
 }
 
 QPixmap CoverProvider::CoverProviderPrivate::loadNoCover()
@@ -333,7 +849,7 @@ QPixmap CoverProvider::CoverProviderPrivate::loadNoCover()
 
 void CoverProvider::CoverProviderPrivate::processCoverResult(const CoverLoader& loader)
 {
-    m_pendingCovers.erase(loader.key);
+    m_pendingCovers.erase(requestId(loader));
 
     if(loader.cover.isNull()) {
         CoverProvider::m_noCoverKeys.emplace(loader.key);
@@ -362,13 +878,8 @@ void CoverProvider::CoverProviderPrivate::fetchCover(const QString& key, const T
     loader.isThumb     = thumbnail;
     loader.size        = size;
 
-    auto loaderResult = Utils::asyncExec([loader]() -> CoverLoader {
-        auto result = loadCoverImage(loader);
-        // Make sure we destroy instance before thread quits
-        loader.audioLoader->destroyThreadInstance();
-        return result;
-    });
-    loaderResult.then(m_self, [this, key, track](const CoverLoader& result) { processCoverResult(result); });
+    m_pendingCovers.emplace(requestId(loader));
+    m_scheduler->request(loader, m_self, [this](const CoverLoader& result) { processCoverResult(result); });
 }
 
 CoverProvider::CoverProvider(std::shared_ptr<AudioLoader> audioLoader, SettingsManager* settings, QObject* parent)
@@ -390,13 +901,16 @@ QPixmap CoverProvider::trackCover(const Track& track, Track::Cover type) const
     }
 
     const QString coverKey = generateCoverKey(track, type);
-    if(!p->m_pendingCovers.contains(coverKey)) {
+    if(const QString id = requestId(coverKey, false, None); p->m_pendingCovers.contains(id)) {
+        // Requested again while still waiting, so load ahead of older requests
+        p->m_scheduler->prioritise(id);
+    }
+    else {
         QPixmap cover = loadCachedCover(coverKey);
         if(!cover.isNull()) {
             return cover;
         }
 
-        p->m_pendingCovers.emplace(coverKey);
         p->fetchCover(coverKey, track, type, false);
     }
 
@@ -410,13 +924,15 @@ QPixmap CoverProvider::trackCoverThumbnail(const Track& track, ThumbnailSize siz
     }
 
     const QString coverKey = generateCoverKey(track, type);
-    if(!p->m_pendingCovers.contains(coverKey) && !m_noCoverKeys.contains(coverKey)) {
+    if(const QString id = requestId(coverKey, true, size); p->m_pendingCovers.contains(id)) {
+        p->m_scheduler->prioritise(id);
+    }
+    else if(!m_noCoverKeys.contains(coverKey)) {
         QPixmap cover = loadCachedCover(coverKey, size);
         if(!cover.isNull()) {
             return cover;
         }
 
-        p->m_pendingCovers.emplace(coverKey);
         p->fetchCover(coverKey, track, type, true, size);
     }
 
@@ -428,6 +944,15 @@ QPixmap CoverProvider::trackCoverThumbnail(const Track& track, const QSize& size
     return trackCoverThumbnail(track, findThumbnailSize(size), type);
 }
 
+bool CoverProvider::cancelPendingRequests()
+{
+    const auto cancelled = p->m_scheduler->cancel(this);
+    for(const auto& id : cancelled) {
+        p->m_pendingCovers.erase(id);
+    }
+    return !cancelled.empty();
+}
+
 CoverProvider::ThumbnailSize CoverProvider::findThumbnailSize(const QSize& size)
 {
     const int maxSize = std::max(size.width(), size.height());
@@ -459,17 +984,28 @@ CoverProvider::ThumbnailSize CoverProvider::findThumbnailSize(const QSize& size)
 
 void CoverProvider::clearCache()
 {
-    QDir cache{Fooyin::Gui::coverPath()};
-    cache.removeRecursively();
+    ThumbnailStore::instance()->clear();
+    directoryCoverCache().clear();
 
     QPixmapCache::clear();
 }
 
+void CoverProvider::invalidateDirectories(const QStringList& dirs)
+{
+    directoryCoverCache().invalidate(dirs);
+}
+
+void CoverProvider::invalidateDirectoryTree(const QString& root)
+{
+    directoryCoverCache().invalidateTree(root);
+}
+
 void CoverProvider::removeFromCache(const Track& track)
 {
-    auto removeKey = [](const QString& key) {
-        QDir cache{Fooyin::Gui::coverPath()};
-        cache.remove(coverThumbnailPath(key));
+    const auto store = ThumbnailStore::instance();
+
+    auto removeKey = [&store](const QString& key) {
+        store->remove(key);
         m_noCoverKeys.erase(key);
         QPixmapCache::remove(key);
     };
@@ -36,6 +36,7 @@
 #include "playlist/playlistinteractor.h"
 #include "search/searchcontroller.h"
 #include "search/searchwidget.h"
+#include "stalldetector.h"
 #include "systemtrayicon.h"
 #include "widgets.h"
 
@@ -192,6 +193,7 @@ public:
     std::unique_ptr<LogWidget> m_logWidget;
     Widgets* m_widgets;
     ScriptParser m_scriptParser;
+    StallDetector* m_stallDetector;
 };
 
 GuiApplicationPrivate::GuiApplicationPrivate(GuiApplication* self_, Application* core_)
@@ -227,6 +229,7 @@ GuiApplicationPrivate::GuiApplicationPrivate(GuiApplication* self_, Application*
                          m_editableLayout.get(), m_windowController, m_themeRegistry}
     , m_logWidget{std::make_unique<LogWidget>(m_settings)}
     , m_widgets{new Widgets(m_core, m_mainWindow.get(), m_self, &m_playlistInteractor, m_self)}
+    , m_stallDetector{new StallDetector(m_settings, m_self)}
 { }
 
 void GuiApplicationPrivate::initialise()
@@ -281,6 +284,13 @@ void GuiApplicationPrivate::setupConnections()
                      &TrackSelectionController::tracksUpdated);
     QObject::connect(m_library, &MusicLibrary::tracksDeleted, &m_selectionController,
                      &TrackSelectionController::tracksRemoved);
+    QObject::connect(m_library, &MusicLibrary::directoriesChanged, m_self, &CoverProvider::invalidateDirectories);
+    QObject::connect(m_library, &MusicLibrary::scanProgress, m_self, [](const ScanProgress& progress) {
+        // A scan re-reads the disk, so covers which weren't there before (or are now gone) are picked up
+        if(progress.type == ScanRequest::Library && (progress.current == 0 || progress.current == progress.total)) {
+            CoverProvider::invalidateDirectoryTree(progress.info.path);
+        }
+    });
 
     QObject::connect(m_playerController, &PlayerController::playStateChanged, m_mainWindow.get(),
                      [this]() { updateWindowTitle(); });
@@ -33,7 +33,9 @@
 
 using namespace Qt::StringLiterals;
 
-constexpr int PixmapCacheSize = 32;
+constexpr int PixmapCacheSize    = 32;
+constexpr int ThumbnailCacheSize = 256;
+constexpr int StallThreshold     = 100;
 
 namespace {
 Fooyin::CoverPaths defaultCoverPaths()
@@ -153,5 +155,10 @@ GuiSettings::GuiSettings(SettingsManager* settingsManager)
     m_settings->createTempSetting<Internal::SystemPalette>(QApplication::palette());
     m_settings->createSetting<Internal::DirBrowserShowHorizScroll>(true, u"DirectoryBrowser/ShowHorizontalScrollbar"_s);
     m_settings->createSetting<Internal::LibTreeIconSize>(QSize{36, 36}, u"LibraryTree/IconSize"_s);
+    m_settings->createSetting<Internal::ThumbnailCacheSize>(ThumbnailCacheSize, u"Artwork/ThumbnailCacheSize"_s);
+    m_settings->createSetting<Internal::RawThumbnails>(false, u"Artwork/RawThumbnails"_s);
+    m_settings->createSetting<Internal::PlaylistLazyRows>(true, u"PlaylistWidget/LazyRows"_s);
+    m_settings->createSetting<Internal::StallDetection>(false, u"Diagnostics/StallDetection"_s);
+    m_settings->createSetting<Internal::StallThreshold>(StallThreshold, u"Diagnostics/StallThreshold"_s);
 }
 } // namespace Fooyin
@@ -132,6 +132,11 @@ enum GuiInternalSettings : uint32_t
     SystemPalette             = 60 | Type::Variant,
     DirBrowserShowHorizScroll = 61 | Type::Bool,
     LibTreeIconSize           = 62 | Type::Variant,
+    ThumbnailCacheSize        = 63 | Type::Int,
+    RawThumbnails             = 64 | Type::Bool,
+    PlaylistLazyRows          = 65 | Type::Bool,
+    StallDetection            = 66 | Type::Bool,
+    StallThreshold            = 67 | Type::Int,
 };
 Q_ENUM_NS(GuiInternalSettings)
 } // namespace Settings::Gui::Internal
@@ -22,6 +22,9 @@
 #include <core/constants.h>
 #include <core/library/tracksort.h>
 
+#include <unordered_map>
+#include <unordered_set>
+
 namespace {
 QStyleOptionViewItem::Position getCoverPosition(const QString& text, const char* cover)
 {
@@ -135,6 +138,19 @@ void LibraryTreeItem::removeTrack(const Track& track)
     std::erase_if(m_tracks, [track](const Track& child) { return child.id() == track.id(); });
 }
 
+void LibraryTreeItem::removeTracks(const TrackList& tracks)
+{
+    if(m_tracks.empty()) {
+        return;
+    }
+
+    std::unordered_set<int> ids;
+    for(const Track& track : tracks) {
+        ids.emplace(track.id());
+    }
+    std::erase_if(m_tracks, [&ids](const Track& child) { return ids.contains(child.id()); });
+}
+
 void LibraryTreeItem::replaceTrack(const Track& track)
 {
     if(m_tracks.empty()) {
@@ -143,6 +159,23 @@ void LibraryTreeItem::replaceTrack(const Track& track)
     std::ranges::replace_if(m_tracks, [track](const Track& child) { return child.id() == track.id(); }, track);
 }
 
+void LibraryTreeItem::replaceTracks(const TrackList& tracks)
+{
+    if(m_tracks.empty()) {
+        return;
+    }
+
+    std::unordered_map<int, Track> updated;
+    for(const Track& track : tracks) {
+        updated.emplace(track.id(), track);
+    }
+    for(Track& child : m_tracks) {
+        if(const auto it = updated.find(child.id()); it != updated.end()) {
+            child = it->second;
+        }
+    }
+}
+
 void LibraryTreeItem::sortTracks()
 {
     m_tracks = TrackSorter::sortTracks(m_tracks);
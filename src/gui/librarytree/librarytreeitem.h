@@ -61,7 +61,9 @@ public:
     void addTrack(const Track& track);
     void addTracks(const TrackList& tracks);
     void removeTrack(const Track& track);
+    void removeTracks(const TrackList& tracks);
     void replaceTrack(const Track& track);
+    void replaceTracks(const TrackList& tracks);
     void sortTracks();
 
 private:
@@ -127,7 +127,11 @@ public:
 
     void updateSummary();
 
+    using NodeTrackMap = std::unordered_map<Md5Hash, TrackList>;
+
     void removeTracks(const TrackList& tracks);
+    void removeFromNodes(const NodeTrackMap& nodeTracks);
+    void updateTracks(const PendingTreeData& data);
     void mergeTrackParents(const TrackIdNodeMap& parents);
 
     void batchFinished(PendingTreeData data);
@@ -159,8 +163,6 @@ public:
     std::unordered_set<Md5Hash> m_addedNodes;
     bool m_addingTracks{false};
 
-    TrackList m_tracksPendingRemoval;
-
     Player::PlayState m_playingState;
     QString m_parentNode;
     QString m_playingPath;
@@ -191,51 +193,115 @@ void LibraryTreeModelPrivate::updateSummary()
 
 void LibraryTreeModelPrivate::removeTracks(const TrackList& tracks)
 {
-    std::set<LibraryTreeItem*, cmpItems> items;
-    std::set<LibraryTreeItem*> pendingItems;
+    NodeTrackMap nodeTracks;
 
     for(const Track& track : tracks) {
-        const int id = track.id();
-        if(!m_trackParents.contains(id)) {
+        const auto parentsIt = m_trackParents.find(track.id());
+        if(parentsIt == m_trackParents.end()) {
             continue;
         }
 
-        const auto trackNodes = m_trackParents[id];
-        for(const auto& node : trackNodes) {
-            if(m_nodes.contains(node)) {
-                LibraryTreeItem* item = &m_nodes[node];
-                item->removeTrack(track);
-                if(item->pending()) {
-                    pendingItems.emplace(item);
-                }
-                else {
-                    items.emplace(item);
-                }
-            }
+        for(const auto& node : parentsIt->second) {
+            nodeTracks[node].push_back(track);
         }
-        m_trackParents.erase(id);
+        m_trackParents.erase(parentsIt);
     }
 
-    for(const LibraryTreeItem* item : pendingItems) {
+    removeFromNodes(nodeTracks);
+    updateSummary();
+}
+
+void LibraryTreeModelPrivate::removeFromNodes(const NodeTrackMap& nodeTracks)
+{
+    std::set<LibraryTreeItem*, cmpItems> items;
+    std::unordered_set<Md5Hash> pendingItems;
+
+    for(const auto& [key, tracks] : nodeTracks) {
+        const auto nodeIt = m_nodes.find(key);
+        if(nodeIt == m_nodes.end()) {
+            continue;
+        }
+
+        LibraryTreeItem* item = &nodeIt->second;
+        item->removeTracks(tracks);
+
         if(item->trackCount() == 0) {
-            m_pendingNodes.erase(item->key());
-            m_nodes.erase(item->key());
+            if(item->pending()) {
+                pendingItems.emplace(key);
+            }
+            else {
+                items.emplace(item);
+            }
+        }
+    }
+
+    if(!pendingItems.empty()) {
+        for(auto& [_, rows] : m_pendingNodes) {
+            std::erase_if(rows, [&pendingItems](const Md5Hash& row) { return pendingItems.contains(row); });
+        }
+        for(const Md5Hash& key : pendingItems) {
+            m_pendingNodes.erase(key);
+            m_addedNodes.erase(key);
+            m_nodes.erase(key);
         }
     }
 
     for(LibraryTreeItem* item : items) {
-        if(item->trackCount() == 0) {
-            LibraryTreeItem* parent = item->parent();
-            const int row           = item->row();
-            m_self->beginRemoveRows(m_self->indexOfItem(parent), row, row);
-            parent->removeChild(row);
-            parent->resetChildren();
-            m_self->endRemoveRows();
-            m_nodes.erase(item->key());
+        LibraryTreeItem* parent = item->parent();
+        const int row           = item->row();
+        m_self->beginRemoveRows(m_self->indexOfItem(parent), row, row);
+        parent->removeChild(row);
+        parent->resetChildren();
+        m_self->endRemoveRows();
+        m_pendingNodes.erase(item->key());
+        m_nodes.erase(item->key());
+    }
+}
+
+void LibraryTreeModelPrivate::updateTracks(const PendingTreeData& data)
+{
+    NodeTrackMap keptTracks;
+    NodeTrackMap removedTracks;
+
+    for(const Track& track : data.updatedTracks) {
+        const int id = track.id();
+
+        const auto keptIt = data.keptParents.find(id);
+        if(keptIt != data.keptParents.cend()) {
+            for(const auto& key : keptIt->second) {
+                keptTracks[key].push_back(track);
+            }
+            m_trackParents[id] = keptIt->second;
+        }
+        else {
+            m_trackParents.erase(id);
+        }
+
+        const auto removedIt = data.removedParents.find(id);
+        if(removedIt != data.removedParents.cend()) {
+            for(const auto& key : removedIt->second) {
+                removedTracks[key].push_back(track);
+            }
         }
     }
 
-    updateSummary();
+    for(const auto& [key, tracks] : keptTracks) {
+        const auto nodeIt = m_nodes.find(key);
+        if(nodeIt == m_nodes.end()) {
+            continue;
+        }
+
+        LibraryTreeItem* item = &nodeIt->second;
+        item->replaceTracks(tracks);
+        item->sortTracks();
+
+        if(!item->pending() && item->parent()) {
+            const QModelIndex index = m_self->indexOfItem(item);
+            emit m_self->dataChanged(index, index);
+        }
+    }
+
+    removeFromNodes(removedTracks);
 }
 
 void LibraryTreeModelPrivate::mergeTrackParents(const TrackIdNodeMap& parents)
@@ -264,8 +330,8 @@ void LibraryTreeModelPrivate::batchFinished(PendingTreeData data)
         beginReset();
     }
 
-    if(!m_tracksPendingRemoval.empty()) {
-        removeTracks(m_tracksPendingRemoval);
+    if(!data.updatedTracks.empty()) {
+        updateTracks(data);
     }
 
     populateModel(data);
@@ -459,6 +525,11 @@ void LibraryTreeModel::setRowHeight(int height)
     emit dataUpdated({}, {});
 }
 
+bool LibraryTreeModel::cancelPendingCovers()
+{
+    return p->m_coverProvider.cancelPendingRequests();
+}
+
 void LibraryTreeModel::setPlayState(Player::PlayState state)
 {
     p->m_playingState = state;
@@ -707,13 +778,17 @@ void LibraryTreeModel::updateTracks(const TrackList& tracks)
         return;
     }
 
-    p->m_tracksPendingRemoval = tracksToUpdate;
-    p->m_addingTracks         = false;
+    TrackIdNodeMap currentParents;
+    for(const Track& track : tracksToUpdate) {
+        currentParents.emplace(track.id(), p->m_trackParents.at(track.id()));
+    }
+
+    p->m_addingTracks = false;
     p->m_populatorThread.start();
 
-    QMetaObject::invokeMethod(&p->m_populator, [this, tracksToUpdate] {
-        p->m_populator.run(p->m_grouping, tracksToUpdate,
-                           p->m_settings->value<Settings::Core::UseVariousForCompilations>());
+    QMetaObject::invokeMethod(&p->m_populator, [this, tracksToUpdate, currentParents] {
+        p->m_populator.update(p->m_grouping, tracksToUpdate, currentParents,
+                              p->m_settings->value<Settings::Core::UseVariousForCompilations>());
     });
 
     addTracks(tracks);
@@ -721,16 +796,22 @@ void LibraryTreeModel::updateTracks(const TrackList& tracks)
 
 void LibraryTreeModel::refreshTracks(const TrackList& tracks)
 {
+    LibraryTreeModelPrivate::NodeTrackMap nodeTracks;
+
     for(const Track& track : tracks) {
-        if(!p->m_trackParents.contains(track.id())) {
+        const auto parentsIt = p->m_trackParents.find(track.id());
+        if(parentsIt == p->m_trackParents.end()) {
             continue;
         }
 
-        const auto parents = p->m_trackParents.at(track.id());
-        for(const auto& parent : parents) {
-            if(p->m_nodes.contains(parent)) {
-                p->m_nodes.at(parent).replaceTrack(track);
-            }
+        for(const auto& parent : parentsIt->second) {
+            nodeTracks[parent].push_back(track);
+        }
+    }
+
+    for(const auto& [key, parentTracks] : nodeTracks) {
+        if(p->m_nodes.contains(key)) {
+            p->m_nodes.at(key).replaceTracks(parentTracks);
         }
     }
 }
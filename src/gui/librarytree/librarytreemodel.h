@@ -61,6 +61,7 @@ public:
     void setRowHeight(int height);
     void setPlayState(Player::PlayState state);
     void setPlayingPath(const QString& parentNode, const QString& path);
+    bool cancelPendingCovers();
 
     [[nodiscard]] Qt::ItemFlags flags(const QModelIndex& index) const override;
     [[nodiscard]] QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
@@ -25,10 +25,17 @@
 #include <core/scripting/scriptparser.h>
 #include <core/scripting/scriptregistry.h>
 
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <unordered_set>
+
 using namespace Qt::StringLiterals;
 
 constexpr int InitialBatchSize = 3000;
 constexpr int BatchSize        = 4000;
+// Below this many tracks the grouping script is evaluated on the populator thread alone
+constexpr int ParallelGroupingThreshold = 1000;
 
 namespace Fooyin {
 class LibraryTreePopulatorPrivate
@@ -36,25 +43,43 @@ class LibraryTreePopulatorPrivate
 public:
     explicit LibraryTreePopulatorPrivate(LibraryTreePopulator* self, LibraryManager* libraryManager)
         : m_self{self}
+        , m_libraryManager{libraryManager}
         , m_parser{new LibraryTreeScriptRegistry(libraryManager)}
         , m_data{}
     { }
 
+    struct GroupingChunk
+    {
+        ScriptParser* parser{nullptr};
+        size_t begin{0};
+        size_t end{0};
+    };
+
     LibraryTreeItem* getOrInsertItem(const Md5Hash& key, const LibraryTreeItem* parent, const QString& title,
                                      int level);
-    void iterateTrack(const Track& track);
-    bool runBatch(int size);
+    void setUseVarious(bool enabled);
+    void evaluateGrouping(size_t begin, size_t end);
+    void iterateTrack(const Track& track, const QString& field);
+    void diffTrackParents(size_t begin, size_t end);
+    bool runBatches();
+    bool populate(const QString& grouping, const TrackList& tracks, bool useVarious);
 
     LibraryTreePopulator* m_self;
+    LibraryManager* m_libraryManager;
 
     ScriptParser m_parser;
+    // Additional parsers for evaluating the grouping in parallel, as ScriptParser isn't thread-safe
+    std::vector<std::unique_ptr<ScriptParser>> m_chunkParsers;
 
     QString m_currentGrouping;
     ParsedScript m_script;
+    bool m_useVarious{false};
 
     LibraryTreeItem m_root;
     PendingTreeData m_data;
     TrackList m_pendingTracks;
+    std::vector<QString> m_fields;
+    TrackIdNodeMap m_currentParents;
 };
 
 LibraryTreeItem* LibraryTreePopulatorPrivate::getOrInsertItem(const Md5Hash& key, const LibraryTreeItem* parent,
@@ -73,9 +98,65 @@ LibraryTreeItem* LibraryTreePopulatorPrivate::getOrInsertItem(const Md5Hash& key
     return child;
 }
 
-void LibraryTreePopulatorPrivate::iterateTrack(const Track& track)
+void LibraryTreePopulatorPrivate::setUseVarious(bool enabled)
+{
+    m_useVarious = enabled;
+
+    if(auto* registry = m_parser.registry()) {
+        registry->setUseVariousArtists(enabled);
+    }
+    for(const auto& parser : m_chunkParsers) {
+        if(auto* registry = parser->registry()) {
+            registry->setUseVariousArtists(enabled);
+        }
+    }
+}
+
+void LibraryTreePopulatorPrivate::evaluateGrouping(size_t begin, size_t end)
+{
+    m_fields.assign(end - begin, {});
+
+    const auto count = static_cast<int>(end - begin);
+    const int chunks = count < ParallelGroupingThreshold ? 1 : std::max(1, QThread::idealThreadCount());
+
+    auto evaluateChunk = [this, begin](const GroupingChunk& chunk) {
+        for(size_t i{chunk.begin}; i < chunk.end; ++i) {
+            if(!m_self->mayRun()) {
+                return;
+            }
+            const Track& track = m_pendingTracks.at(i);
+            if(track.isInLibrary()) {
+                m_fields[i - begin] = chunk.parser->evaluate(m_script, track);
+            }
+        }
+    };
+
+    if(chunks == 1) {
+        evaluateChunk({&m_parser, begin, end});
+        return;
+    }
+
+    while(std::cmp_less(m_chunkParsers.size(), chunks - 1)) {
+        auto& parser = m_chunkParsers.emplace_back(
+            std::make_unique<ScriptParser>(new LibraryTreeScriptRegistry(m_libraryManager)));
+        if(auto* registry = parser->registry()) {
+            registry->setUseVariousArtists(m_useVarious);
+        }
+    }
+
+    std::vector<GroupingChunk> groupingChunks;
+    const auto chunkSize = static_cast<size_t>((count + chunks - 1) / chunks);
+    for(size_t chunkBegin{begin}; chunkBegin < end; chunkBegin += chunkSize) {
+        const size_t index = groupingChunks.size();
+        auto* parser       = index == 0 ? &m_parser : m_chunkParsers.at(index - 1).get();
+        groupingChunks.push_back({parser, chunkBegin, std::min(chunkBegin + chunkSize, end)});
+    }
+
+    QtConcurrent::blockingMap(groupingChunks, evaluateChunk);
+}
+
+void LibraryTreePopulatorPrivate::iterateTrack(const Track& track, const QString& field)
 {
-    const QString field = m_parser.evaluate(m_script, track);
     if(field.isNull()) {
         return;
     }
@@ -91,7 +172,7 @@ void LibraryTreePopulatorPrivate::iterateTrack(const Track& track)
 
         for(int level{0}; const QString& item : items) {
             const QString title = item.trimmed();
-            const auto key      = Utils::generateMd5Hash(parent->key(), title);
+            const auto key      = Utils::generateFastHash(parent->key(), title);
 
             auto* node = getOrInsertItem(key, parent, title, level);
 
@@ -104,39 +185,129 @@ void LibraryTreePopulatorPrivate::iterateTrack(const Track& track)
     }
 }
 
-bool LibraryTreePopulatorPrivate::runBatch(int size)
+void LibraryTreePopulatorPrivate::diffTrackParents(size_t begin, size_t end)
 {
-    if(size <= 0) {
-        return true;
-    }
+    std::unordered_map<Md5Hash, TrackList> keptTracks;
 
-    auto tracksBatch = std::ranges::views::take(m_pendingTracks, size);
+    for(size_t i{begin}; i < end; ++i) {
+        const Track& track = m_pendingTracks.at(i);
+        const int id       = track.id();
 
-    for(const Track& track : tracksBatch) {
-        if(!m_self->mayRun()) {
-            return false;
+        const auto currentIt = m_currentParents.find(id);
+        if(currentIt == m_currentParents.end()) {
+            continue;
         }
 
-        if(track.isInLibrary()) {
-            iterateTrack(track);
+        std::unordered_set<Md5Hash> newParents;
+        const auto parentsIt = m_data.trackParents.find(id);
+        if(parentsIt != m_data.trackParents.end()) {
+            newParents.insert(parentsIt->second.cbegin(), parentsIt->second.cend());
+        }
+
+        std::vector<Md5Hash> kept;
+        std::vector<Md5Hash> removed;
+        for(const Md5Hash& key : currentIt->second) {
+            if(newParents.contains(key)) {
+                kept.push_back(key);
+                keptTracks[key].push_back(track);
+            }
+            else {
+                removed.push_back(key);
+            }
+        }
+
+        // Nodes the track stays in only need the track replacing, so don't add it again
+        if(parentsIt != m_data.trackParents.end() && !kept.empty()) {
+            const std::unordered_set<Md5Hash> keptKeys{kept.cbegin(), kept.cend()};
+            std::erase_if(parentsIt->second, [&keptKeys](const Md5Hash& key) { return keptKeys.contains(key); });
+            if(parentsIt->second.empty()) {
+                m_data.trackParents.erase(parentsIt);
+            }
+        }
+
+        m_data.updatedTracks.push_back(track);
+        if(!kept.empty()) {
+            m_data.keptParents.emplace(id, std::move(kept));
+        }
+        if(!removed.empty()) {
+            m_data.removedParents.emplace(id, std::move(removed));
         }
     }
 
-    if(!m_self->mayRun()) {
-        return false;
+    bool itemsRemoved{false};
+
+    for(const auto& [key, tracks] : keptTracks) {
+        auto itemIt = m_data.items.find(key);
+        if(itemIt == m_data.items.end()) {
+            continue;
+        }
+        itemIt->second.removeTracks(tracks);
+        if(itemIt->second.trackCount() == 0) {
+            m_data.items.erase(itemIt);
+            itemsRemoved = true;
+        }
     }
 
-    emit m_self->populated(m_data);
+    if(itemsRemoved) {
+        for(auto& [_, rows] : m_data.nodes) {
+            std::erase_if(rows, [this](const Md5Hash& row) { return !m_data.items.contains(row); });
+        }
+    }
+}
+
+bool LibraryTreePopulatorPrivate::runBatches()
+{
+    const size_t total = m_pendingTracks.size();
+    size_t begin{0};
+    size_t batchSize{InitialBatchSize};
+
+    // Always emit at least once so an empty library still resets the model
+    do {
+        const size_t end = std::min(begin + batchSize, total);
+
+        evaluateGrouping(begin, end);
+
+        for(size_t i{begin}; i < end; ++i) {
+            if(!m_self->mayRun()) {
+                return false;
+            }
+            iterateTrack(m_pendingTracks.at(i), m_fields.at(i - begin));
+        }
+
+        if(!m_currentParents.empty()) {
+            diffTrackParents(begin, end);
+        }
+
+        if(!m_self->mayRun()) {
+            return false;
+        }
+
+        emit m_self->populated(m_data);
+
+        m_data.clear();
 
-    auto tracksToKeep = std::ranges::views::drop(m_pendingTracks, size);
-    TrackList tempTracks;
-    std::ranges::copy(tracksToKeep, std::back_inserter(tempTracks));
-    m_pendingTracks = std::move(tempTracks);
+        begin     = end;
+        batchSize = BatchSize;
+    } while(begin < total);
 
+    m_pendingTracks.clear();
+    m_fields.clear();
+    m_currentParents.clear();
+
+    return true;
+}
+
+bool LibraryTreePopulatorPrivate::populate(const QString& grouping, const TrackList& tracks, bool useVarious)
+{
     m_data.clear();
+    setUseVarious(useVarious);
+
+    if(std::exchange(m_currentGrouping, grouping) != grouping) {
+        m_script = m_parser.parse(m_currentGrouping);
+    }
 
-    const auto remaining = static_cast<int>(m_pendingTracks.size());
-    return runBatch(std::min(remaining, BatchSize));
+    m_pendingTracks = tracks;
+    return runBatches();
 }
 
 LibraryTreePopulator::LibraryTreePopulator(LibraryManager* libraryManager, QObject* parent)
@@ -150,18 +321,23 @@ void LibraryTreePopulator::run(const QString& grouping, const TrackList& tracks,
 {
     setState(Running);
 
-    p->m_data.clear();
+    p->m_currentParents.clear();
+    const bool success = p->populate(grouping, tracks, useVarious);
 
-    if(auto* registry = p->m_parser.registry()) {
-        registry->setUseVariousArtists(useVarious);
-    }
+    setState(Idle);
 
-    if(std::exchange(p->m_currentGrouping, grouping) != grouping) {
-        p->m_script = p->m_parser.parse(p->m_currentGrouping);
+    if(success) {
+        emit finished();
     }
+}
+
+void LibraryTreePopulator::update(const QString& grouping, const TrackList& tracks,
+                                  const TrackIdNodeMap& currentParents, bool useVarious)
+{
+    setState(Running);
 
-    p->m_pendingTracks = tracks;
-    const bool success = p->runBatch(InitialBatchSize);
+    p->m_currentParents = currentParents;
+    const bool success  = p->populate(grouping, tracks, useVarious);
 
     setState(Idle);
 
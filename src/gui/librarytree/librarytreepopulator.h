@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include "fygui_export.h"
+
 #include "librarytreeitem.h"
 
 #include <utils/crypto.h>
@@ -38,15 +40,24 @@ struct PendingTreeData
     NodeKeyMap nodes;
     TrackIdNodeMap trackParents;
 
+    // Only set when updating existing tracks: the nodes each track stays in or has left.
+    // Kept nodes aren't included in items/trackParents above.
+    TrackList updatedTracks;
+    TrackIdNodeMap keptParents;
+    TrackIdNodeMap removedParents;
+
     void clear()
     {
         items.clear();
         nodes.clear();
         trackParents.clear();
+        updatedTracks.clear();
+        keptParents.clear();
+        removedParents.clear();
     }
 };
 
-class LibraryTreePopulator : public Worker
+class FYGUI_EXPORT LibraryTreePopulator : public Worker
 {
     Q_OBJECT
 
@@ -55,6 +66,9 @@ public:
     ~LibraryTreePopulator() override;
 
     void run(const QString& grouping, const TrackList& tracks, bool useVarious);
+    // Regroups tracks already in the tree, diffing the result against their current parents
+    void update(const QString& grouping, const TrackList& tracks, const TrackIdNodeMap& currentParents,
+                bool useVarious);
 
 signals:
     void populated(Fooyin::PendingTreeData data);
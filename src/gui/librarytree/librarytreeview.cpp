@@ -19,6 +19,8 @@
 
 #include "librarytreeview.h"
 
+#include <gui/painttimer.h>
+
 #include <QHeaderView>
 #include <QMouseEvent>
 #include <QPaintEvent>
@@ -91,6 +93,8 @@ void LibraryTreeView::wheelEvent(QWheelEvent* event)
 
 void LibraryTreeView::paintEvent(QPaintEvent* event)
 {
+    const PaintTimer paintTimer{"LibraryTreeView"};
+
     QPainter painter{viewport()};
 
     auto drawCentreText = [this, &painter](const QString& text) {
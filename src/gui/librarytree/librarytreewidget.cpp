@@ -53,6 +53,7 @@
 #include <QJsonObject>
 #include <QKeyEvent>
 #include <QMenu>
+#include <QScrollBar>
 #include <QTreeView>
 #include <QVBoxLayout>
 
@@ -320,6 +321,12 @@ void LibraryTreeWidgetPrivate::setupConnections()
 
     QObject::connect(m_model, &LibraryTreeModel::dataUpdated, m_libraryTree, &QTreeView::dataChanged);
     QObject::connect(m_model, &LibraryTreeModel::modelLoaded, m_self, [this]() { restoreState(m_pendingState); });
+    QObject::connect(m_libraryTree->verticalScrollBar(), &QScrollBar::valueChanged, m_self, [this]() {
+        // Requeue covers which are still visible ahead of any which have scrolled away
+        if(m_model->cancelPendingCovers()) {
+            m_libraryTree->viewport()->update();
+        }
+    });
 
     QObject::connect(m_libraryTree, &LibraryTreeView::doubleClicked, m_self,
                      [this](const QModelIndex& index) { handleDoubleClick(index); });
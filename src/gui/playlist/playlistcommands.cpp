@@ -175,7 +175,7 @@ void ResetTracks::undo()
     auto* model            = m_model;
     auto* playerController = m_playerController;
     QObject::connect(
-        model, &PlaylistModel::playlistLoaded, model,
+        model, &PlaylistModel::tracksReplaced, model,
         [model, playerController, queuedIndexes]() {
             model->tracksChanged();
             restoreQueuedIndexes(playerController, queuedIndexes);
@@ -183,7 +183,7 @@ void ResetTracks::undo()
         Qt::SingleShotConnection);
 
     m_model->tracksAboutToBeChanged();
-    m_model->reset(m_oldTracks);
+    m_model->replaceTracks(m_newTracks, m_oldTracks);
 }
 
 void ResetTracks::redo()
@@ -193,7 +193,7 @@ void ResetTracks::redo()
     auto* model            = m_model;
     auto* playerController = m_playerController;
     QObject::connect(
-        model, &PlaylistModel::playlistLoaded, model,
+        model, &PlaylistModel::tracksReplaced, model,
         [model, playerController, queuedIndexes]() {
             model->tracksChanged();
             restoreQueuedIndexes(playerController, queuedIndexes);
@@ -201,6 +201,6 @@ void ResetTracks::redo()
         Qt::SingleShotConnection);
 
     m_model->tracksAboutToBeChanged();
-    m_model->reset(m_newTracks);
+    m_model->replaceTracks(m_oldTracks, m_newTracks);
 }
 } // namespace Fooyin
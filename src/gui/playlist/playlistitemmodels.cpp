@@ -254,15 +254,42 @@ QSize PlaylistTrackItem::size(int column) const
     return m_sizes.at(column);
 }
 
+bool PlaylistTrackItem::isEvaluated() const
+{
+    return m_evaluated;
+}
+
 void PlaylistTrackItem::setColumns(const std::vector<RichScript>& columns)
 {
-    m_columns = columns;
+    m_columns   = columns;
+    m_evaluated = true;
 }
 
 void PlaylistTrackItem::setLeftRight(const RichScript& left, const RichScript& right)
 {
-    m_left  = left;
-    m_right = right;
+    m_left      = left;
+    m_right     = right;
+    m_evaluated = true;
+}
+
+void PlaylistTrackItem::setText(const PlaylistTrackItem& other)
+{
+    m_columns   = other.m_columns;
+    m_left      = other.m_left;
+    m_right     = other.m_right;
+    m_sizes     = other.m_sizes;
+    m_evaluated = other.m_evaluated;
+}
+
+void PlaylistTrackItem::clearText()
+{
+    // Assign rather than clear so the formatted blocks are released
+    for(auto& column : m_columns) {
+        column.text = {};
+    }
+    m_left.text  = {};
+    m_right.text = {};
+    m_evaluated  = false;
 }
 
 void PlaylistTrackItem::setTrack(const PlaylistTrack& track)
@@ -307,6 +334,8 @@ void PlaylistTrackItem::calculateSize()
         return blockSize;
     };
 
+    m_sizes.clear();
+
     if(!m_columns.empty()) {
         for(const auto& col : m_columns) {
             QSize colSize = addSize(col);
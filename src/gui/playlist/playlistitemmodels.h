@@ -87,9 +87,12 @@ public:
     [[nodiscard]] int rowHeight() const;
     [[nodiscard]] int depth() const;
     [[nodiscard]] QSize size(int column = 0) const;
+    [[nodiscard]] bool isEvaluated() const;
 
     void setColumns(const std::vector<RichScript>& columns);
     void setLeftRight(const RichScript& left, const RichScript& right);
+    void setText(const PlaylistTrackItem& other);
+    void clearText();
     void setTrack(const PlaylistTrack& track);
     void setIndex(int index);
 
@@ -108,5 +111,6 @@ private:
     std::vector<QSize> m_sizes;
     int m_rowHeight;
     int m_depth;
+    bool m_evaluated{true};
 };
 } // namespace Fooyin
@@ -25,6 +25,7 @@
 #include "playlistitem.h"
 #include "playlistpopulator.h"
 #include "playlistpreset.h"
+#include "playlistrowloader.h"
 #include "playlistscriptregistry.h"
 
 #include <core/constants.h>
@@ -57,6 +58,10 @@ using namespace Qt::StringLiterals;
 
 constexpr auto MimeModelId       = "application/x-playlistmodel-id";
 constexpr auto MaxPlaylistTracks = 250;
+// Playlists larger than this only evaluate the text of rows as they are shown
+constexpr auto LazyRowThreshold = 5000;
+constexpr auto LazyRowReadAhead = 100;
+constexpr auto LazyRowCapacity  = 10000;
 
 namespace {
 bool cmpItemsPlaylistItems(Fooyin::PlaylistItem* pItem1, Fooyin::PlaylistItem* pItem2, bool reverse = false)
@@ -490,7 +495,10 @@ PlaylistModel::PlaylistModel(PlaylistInteractor* playlistInteractor, CoverProvid
     , m_playingColour{QApplication::palette().highlight().color()}
     , m_disabledColour{Qt::red}
     , m_populator{playlistInteractor->playerController()}
+    , m_rowLoader{new PlaylistRowLoader(LazyRowCapacity, this)}
+    , m_lazyRows{false}
     , m_playlistLoaded{false}
+    , m_replacingTracks{false}
     , m_pixmapPadding{settings->value<Settings::Gui::Internal::PlaylistImagePadding>()}
     , m_pixmapPaddingTop{settings->value<Settings::Gui::Internal::PlaylistImagePaddingTop>()}
     , m_starRatingSize{settings->value<Settings::Gui::StarRatingSize>()}
@@ -531,6 +539,9 @@ PlaylistModel::PlaylistModel(PlaylistInteractor* playlistInteractor, CoverProvid
         m_playlistLoaded = true;
         emit dataChanged({}, {});
         emit playlistLoaded();
+        if(std::exchange(m_replacingTracks, false)) {
+            emit tracksReplaced();
+        }
     });
 
     QObject::connect(&m_populator, &PlaylistPopulator::populated, this,
@@ -538,12 +549,26 @@ PlaylistModel::PlaylistModel(PlaylistInteractor* playlistInteractor, CoverProvid
 
     QObject::connect(&m_populator, &PlaylistPopulator::populatedTrackGroup, this,
                      [this](PendingData data) { populateTrackGroup(data); });
+    QObject::connect(&m_populator, &PlaylistPopulator::replaceRequired, this,
+                     [this](const UId& playlistId, const PlaylistTrackList& tracks) {
+                         if(m_currentPlaylist && m_currentPlaylist->id() == playlistId) {
+                             m_replacingTracks = true;
+                             reset(tracks);
+                         }
+                         else {
+                             emit tracksReplaced();
+                         }
+                     });
+    QObject::connect(&m_populator, &PlaylistPopulator::replaceCancelled, this, &PlaylistModel::tracksReplaced);
 
     QObject::connect(&m_populator, &PlaylistPopulator::headersUpdated, this,
                      [this](ItemKeyMap data) { updateModel(data); });
 
     QObject::connect(&m_populator, &PlaylistPopulator::tracksUpdated, this,
                      [this](const ItemList& data) { updateTracks(data); });
+    QObject::connect(&m_populator, &PlaylistPopulator::tracksEvaluated, this,
+                     [this](const UId& playlistId, const ItemList& data) { tracksEvaluated(playlistId, data); });
+    QObject::connect(m_rowLoader, &PlaylistRowLoader::rowsRequested, this, &PlaylistModel::evaluateRows);
 
     QObject::connect(m_coverProvider, &CoverProvider::coverAdded, this,
                      [this](const Track& track) { coverUpdated(track); });
@@ -890,9 +915,15 @@ void PlaylistModel::reset(const PlaylistTrackList& tracks)
 
     m_playlistLoaded = false;
     m_resetting      = true;
+    m_rowLoader->clear();
+
+    const bool lazyTracks = m_settings->value<Settings::Gui::Internal::PlaylistLazyRows>()
+                         && std::cmp_greater(tracks.size(), LazyRowThreshold);
+    m_lazyRows = lazyTracks;
 
-    QMetaObject::invokeMethod(&m_populator, [this, tracks] {
+    QMetaObject::invokeMethod(&m_populator, [this, tracks, lazyTracks] {
         m_populator.setUseVarious(m_settings->value<Settings::Core::UseVariousForCompilations>());
+        m_populator.setLazyTracks(lazyTracks);
         m_populator.run(m_currentPlaylist ? m_currentPlaylist->id() : UId{}, m_currentPreset, m_columns, tracks);
     });
 }
@@ -1004,6 +1035,21 @@ void PlaylistModel::insertTracks(const TrackGroups& tracks)
     }
 }
 
+void PlaylistModel::replaceTracks(const PlaylistTrackList& oldTracks, const PlaylistTrackList& newTracks)
+{
+    if(!m_currentPlaylist || !m_playlistLoaded || m_nodes.empty()) {
+        m_replacingTracks = true;
+        reset(newTracks);
+        return;
+    }
+
+    // Diffed on the populator thread, then applied as row removals/insertions so the view keeps its state
+    QMetaObject::invokeMethod(&m_populator, [this, oldTracks, newTracks] {
+        m_populator.setUseVarious(m_settings->value<Settings::Core::UseVariousForCompilations>());
+        m_populator.runDiff(m_currentPlaylist->id(), m_currentPreset, m_columns, oldTracks, newTracks);
+    });
+}
+
 void PlaylistModel::updateTracks(const std::vector<int>& indexes)
 {
     TrackGroups groups;
@@ -1240,11 +1286,21 @@ void PlaylistModel::populateModel(PendingData& data)
 void PlaylistModel::populateTrackGroup(PendingData& data)
 {
     if(m_currentPlaylist && m_currentPlaylist->id() != data.playlistId) {
+        if(data.replacement) {
+            emit tracksReplaced();
+        }
         return;
     }
 
     tracksAboutToBeChanged();
 
+    for(const int index : data.removedIndexes) {
+        const auto& [trackIndex, end] = trackIndexAtPlaylistIndex(index);
+        if(!end) {
+            m_indexesPendingRemoval.push_back(trackIndex);
+        }
+    }
+
     if(!m_indexesPendingRemoval.empty()) {
         const ParentChildRangesList indexGroups = determineRowGroups(m_indexesPendingRemoval);
 
@@ -1259,13 +1315,18 @@ void PlaylistModel::populateTrackGroup(PendingData& data)
     if(m_nodes.empty()) {
         m_resetting = true;
         populateModel(data);
-        tracksChanged();
-        return;
+    }
+    else {
+        handleTrackGroup(data);
     }
 
-    handleTrackGroup(data);
-
-    tracksChanged();
+    if(data.replacement) {
+        // Whoever requested the replacement finishes it (and notifies the change) on tracksReplaced
+        emit tracksReplaced();
+    }
+    else {
+        tracksChanged();
+    }
 }
 
 void PlaylistModel::updateModel(ItemKeyMap& data)
@@ -1290,16 +1351,110 @@ void PlaylistModel::updateTracks(const ItemList& tracks)
         return;
     }
 
+    std::vector<UId> evicted;
+
     for(const PlaylistItem& item : tracks) {
         if(m_nodes.contains(item.key())) {
             auto* node = &m_nodes.at(item.key());
             node->setData(item.data());
             node->setState(PlaylistItem::State::None);
 
+            // Counted against the row budget like any other evaluated row
+            if(m_lazyRows && node->type() == PlaylistItem::Track
+               && std::get<PlaylistTrackItem>(node->data()).isEvaluated()) {
+                std::ranges::move(m_rowLoader->setLoaded(node->key()), std::back_inserter(evicted));
+            }
+
             const QModelIndex trackIndex = indexOfItem(node);
             emit dataChanged(trackIndex, trackIndex.siblingAtColumn(columnCount(trackIndex) - 1), {});
         }
     }
+
+    dropRowText(evicted);
+}
+
+void PlaylistModel::evaluateRows(const std::vector<int>& indexes)
+{
+    if(m_resetting || !m_currentPlaylist || m_trackIndexes.empty()) {
+        return;
+    }
+
+    ItemList items;
+
+    for(const int index : indexes) {
+        auto indexIt       = m_trackIndexes.lower_bound(index - LazyRowReadAhead);
+        const auto lastRow = index + LazyRowReadAhead;
+
+        for(; indexIt != m_trackIndexes.end() && indexIt->first <= lastRow; ++indexIt) {
+            const UId& key    = indexIt->second;
+            const auto nodeIt = m_nodes.find(key);
+            if(nodeIt == m_nodes.end() || nodeIt->second.type() != PlaylistItem::Track) {
+                continue;
+            }
+
+            const auto& trackItem = std::get<PlaylistTrackItem>(nodeIt->second.data());
+            if(trackItem.isEvaluated() || m_rowLoader->isLoading(key)) {
+                continue;
+            }
+
+            m_rowLoader->setLoading(key);
+            items.push_back(nodeIt->second);
+        }
+    }
+
+    if(items.empty()) {
+        return;
+    }
+
+    QMetaObject::invokeMethod(&m_populator, [this, playlistId = m_currentPlaylist->id(), preset = m_currentPreset,
+                                             columns = m_columns, items] {
+        m_populator.evaluateTracks(playlistId, preset, columns, items);
+    });
+}
+
+void PlaylistModel::tracksEvaluated(const UId& playlistId, const ItemList& tracks)
+{
+    if(m_resetting || !m_currentPlaylist || m_currentPlaylist->id() != playlistId) {
+        return;
+    }
+
+    std::vector<UId> evicted;
+
+    for(const PlaylistItem& item : tracks) {
+        const auto nodeIt = m_nodes.find(item.key());
+        if(nodeIt == m_nodes.end() || nodeIt->second.type() != PlaylistItem::Track) {
+            // Removed in the meantime
+            m_rowLoader->remove(item.key());
+            continue;
+        }
+
+        auto* node      = &nodeIt->second;
+        auto& trackItem = std::get<PlaylistTrackItem>(node->data());
+
+        // Still marked as loaded if refreshed in the meantime, so it can be requested again once dropped
+        std::ranges::move(m_rowLoader->setLoaded(node->key()), std::back_inserter(evicted));
+
+        if(trackItem.isEvaluated()) {
+            continue;
+        }
+
+        trackItem.setText(std::get<PlaylistTrackItem>(item.data()));
+
+        const QModelIndex trackIndex = indexOfItem(node);
+        emit dataChanged(trackIndex, trackIndex.siblingAtColumn(columnCount(trackIndex) - 1), {});
+    }
+
+    dropRowText(evicted);
+}
+
+void PlaylistModel::dropRowText(const std::vector<UId>& keys)
+{
+    for(const UId& key : keys) {
+        const auto nodeIt = m_nodes.find(key);
+        if(nodeIt != m_nodes.end() && nodeIt->second.type() == PlaylistItem::Track) {
+            std::get<PlaylistTrackItem>(nodeIt->second.data()).clearText();
+        }
+    }
 }
 
 void PlaylistModel::mergeTrackParents(const TrackIdNodeMap& parents)
@@ -1330,6 +1485,15 @@ QVariant PlaylistModel::trackData(PlaylistItem* item, const QModelIndex& index,
     const bool singleColumnMode = m_columns.empty();
     const bool isPlaying        = trackIsPlaying(track, item->index());
 
+    auto requestText = [this, item, &trackItem]() {
+        if(trackItem.isEvaluated()) {
+            m_rowLoader->touch(item->key());
+        }
+        else {
+            m_rowLoader->request(item->key(), item->index());
+        }
+    };
+
     auto getCover = [this, &index, column](const Track::Cover type) -> QVariant {
         if(std::cmp_greater_equal(column, m_columnSizes.size())) {
             return {};
@@ -1355,6 +1519,7 @@ QVariant PlaylistModel::trackData(PlaylistItem* item, const QModelIndex& index,
     switch(role) {
         case(Qt::ToolTipRole): {
             if(!singleColumnMode) {
+                requestText();
                 return trackItem.column(column).text.joinedText();
             }
             break;
@@ -1381,6 +1546,7 @@ QVariant PlaylistModel::trackData(PlaylistItem* item, const QModelIndex& index,
                 break;
             }
 
+            requestText();
             return QVariant::fromValue(trackItem.column(column).text);
         }
         case(PlaylistItem::Role::DecorationPosition): {
@@ -1397,8 +1563,10 @@ QVariant PlaylistModel::trackData(PlaylistItem* item, const QModelIndex& index,
         case(PlaylistItem::Role::ImagePaddingTop):
             return m_pixmapPaddingTop;
         case(PlaylistItem::Role::Left):
+            requestText();
             return QVariant::fromValue(trackItem.left().text);
         case(PlaylistItem::Role::Right):
+            requestText();
             return QVariant::fromValue(trackItem.right().text);
         case(PlaylistItem::Role::ItemData):
             return QVariant::fromValue<PlaylistTrack>(trackItem.track());
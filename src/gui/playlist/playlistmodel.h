@@ -37,6 +37,7 @@ class MusicLibrary;
 class Playlist;
 class PlayerController;
 class PlaylistInteractor;
+class PlaylistRowLoader;
 struct PlaylistPreset;
 struct PlaylistTrack;
 class SettingsManager;
@@ -128,6 +129,7 @@ public:
     [[nodiscard]] QModelIndexList indexesOfTrackId(int id);
 
     void insertTracks(const TrackGroups& tracks);
+    void replaceTracks(const PlaylistTrackList& oldTracks, const PlaylistTrackList& newTracks);
     void updateTracks(const std::vector<int>& indexes);
     void refreshTracks(const std::vector<int>& indexes);
     void removeTracks(const QModelIndexList& indexes);
@@ -147,6 +149,7 @@ signals:
     void tracksInserted(const Fooyin::TrackGroups& groups);
     void tracksMoved(const Fooyin::MoveOperation& operation);
     void playlistTracksChanged(int index);
+    void tracksReplaced();
 
 public slots:
     void playingTrackChanged(const Fooyin::PlaylistTrack& track);
@@ -157,6 +160,9 @@ private:
     void populateTrackGroup(PendingData& data);
     void updateModel(ItemKeyMap& data);
     void updateTracks(const ItemList& tracks);
+    void evaluateRows(const std::vector<int>& indexes);
+    void tracksEvaluated(const UId& playlistId, const ItemList& tracks);
+    void dropRowText(const std::vector<UId>& keys);
     void mergeTrackParents(const TrackIdNodeMap& parents);
 
     QVariant trackData(PlaylistItem* item, const QModelIndex& index, int role) const;
@@ -245,8 +251,11 @@ private:
 
     QThread m_populatorThread;
     PlaylistPopulator m_populator;
+    PlaylistRowLoader* m_rowLoader;
+    bool m_lazyRows;
 
     bool m_playlistLoaded;
+    bool m_replacingTracks;
     ItemKeyMap m_nodes;
     TrackIdNodeMap m_trackParents;
     std::map<int, UId> m_trackIndexes;
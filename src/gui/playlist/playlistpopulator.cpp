@@ -24,12 +24,18 @@
 #include "playlistscriptregistry.h"
 
 #include <core/player/playercontroller.h>
+#include <utils/sequencediff.h>
 
+#include <QLoggingCategory>
 #include <QTimer>
 
 #include <ranges>
 
+Q_LOGGING_CATEGORY(PL_POPULATOR, "fy.playlistpopulator")
+
 constexpr int TrackPreloadSize = 2000;
+// Replacements needing more separate row insertions/removals than this reset the model instead
+constexpr int MaxDiffRanges = 100;
 
 namespace Fooyin {
 class PlaylistPopulatorPrivate
@@ -40,7 +46,9 @@ public:
         , m_playerController{playerController}
         , m_registry{new PlaylistScriptRegistry()}
         , m_parser{m_registry}
-    { }
+    {
+        m_parser.setMemoiseFunctions(true);
+    }
 
     void reset();
 
@@ -52,10 +60,15 @@ public:
     void iterateHeader(const Track& track, PlaylistItem*& parent, int index);
     void iterateSubheaders(const Track& track, PlaylistItem*& parent, int index);
     void evaluateTrackScript(RichScript& script, const Track& track);
+    void evaluateTrackText(PlaylistTrackItem& trackData, const PlaylistTrack& track, const PlaylistPreset& preset,
+                           const PlaylistColumnList& columns);
     PlaylistItem* iterateTrack(const PlaylistTrack& track, int index);
 
     void runBatch(int size, int index);
-    void runTracksGroup(const std::map<int, PlaylistTrackList>& tracks);
+    bool runTracksGroup(const std::map<int, PlaylistTrackList>& tracks);
+    static SequenceDiff diffTracks(const PlaylistTrackList& oldTracks, const PlaylistTrackList& newTracks);
+
+    void logMemoStats() const;
 
     PlaylistPopulator* m_self;
     PlayerController* m_playerController;
@@ -66,6 +79,7 @@ public:
     PlaylistScriptRegistry* m_registry;
     ScriptParser m_parser;
     ScriptFormatter m_formatter;
+    bool m_lazyTracks{false};
 
     int m_trackDepth{0};
     Md5Hash m_prevBaseHeaderKey;
@@ -247,10 +261,38 @@ void PlaylistPopulatorPrivate::evaluateTrackScript(RichScript& script, const Tra
     }
 }
 
+void PlaylistPopulatorPrivate::evaluateTrackText(PlaylistTrackItem& trackData, const PlaylistTrack& track,
+                                                 const PlaylistPreset& preset, const PlaylistColumnList& columns)
+{
+    m_registry->setTrackProperties(track.indexInPlaylist, trackData.depth());
+    m_parser.clearMemo();
+
+    if(!columns.empty()) {
+        std::vector<RichScript> trackColumns;
+        for(const auto& column : columns) {
+            const auto evalScript = m_parser.evaluate(column.field, track.track);
+            trackColumns.emplace_back(column.field, m_formatter.evaluate(evalScript));
+        }
+        trackData.setColumns(trackColumns);
+    }
+    else {
+        RichScript trackLeft{preset.track.leftText};
+        RichScript trackRight{preset.track.rightText};
+
+        evaluateTrackScript(trackLeft, track.track);
+        evaluateTrackScript(trackRight, track.track);
+
+        trackData.setLeftRight(trackLeft, trackRight);
+    }
+}
+
 PlaylistItem* PlaylistPopulatorPrivate::iterateTrack(const PlaylistTrack& track, int index)
 {
     PlaylistItem* parent = &m_root;
 
+    // Share function results between the header, subheader and column scripts of this track only
+    m_parser.clearMemo();
+
     iterateHeader(track.track, parent, index);
     iterateSubheaders(track.track, parent, index);
 
@@ -263,7 +305,16 @@ PlaylistItem* PlaylistPopulatorPrivate::iterateTrack(const PlaylistTrack& track,
     TrackRow trackRow{m_currentPreset.track};
     PlaylistTrackItem playlistTrack;
 
-    if(!m_columns.empty()) {
+    if(m_lazyTracks) {
+        // Only the scripts are stored here; the text is evaluated once the row is shown
+        for(const auto& column : m_columns) {
+            trackRow.columns.emplace_back(column.field);
+        }
+        playlistTrack = m_columns.empty() ? PlaylistTrackItem{trackRow.leftText, trackRow.rightText, track}
+                                          : PlaylistTrackItem{trackRow.columns, track};
+        playlistTrack.clearText();
+    }
+    else if(!m_columns.empty()) {
         for(const auto& column : m_columns) {
             const auto evalScript = m_parser.evaluate(column.field, track.track);
             trackRow.columns.emplace_back(column.field, m_formatter.evaluate(evalScript));
@@ -327,7 +378,7 @@ void PlaylistPopulatorPrivate::runBatch(int size, int index)
     runBatch(remaining, index);
 }
 
-void PlaylistPopulatorPrivate::runTracksGroup(const std::map<int, PlaylistTrackList>& tracks)
+bool PlaylistPopulatorPrivate::runTracksGroup(const std::map<int, PlaylistTrackList>& tracks)
 {
     for(const auto& [index, trackGroup] : tracks) {
         std::vector<UId> trackKeys;
@@ -336,7 +387,7 @@ void PlaylistPopulatorPrivate::runTracksGroup(const std::map<int, PlaylistTrackL
 
         for(const PlaylistTrack& track : trackGroup) {
             if(!m_self->mayRun()) {
-                return;
+                return false;
             }
             if(const auto* trackItem = iterateTrack(track, trackIndex++)) {
                 trackKeys.push_back(trackItem->key());
@@ -348,10 +399,44 @@ void PlaylistPopulatorPrivate::runTracksGroup(const std::map<int, PlaylistTrackL
     updateContainers();
 
     if(!m_self->mayRun()) {
-        return;
+        return false;
     }
 
     emit m_self->populatedTrackGroup(m_data);
+    return true;
+}
+
+SequenceDiff PlaylistPopulatorPrivate::diffTracks(const PlaylistTrackList& oldTracks,
+                                                  const PlaylistTrackList& newTracks)
+{
+    // Rows are identified by file and how many times it has already appeared, so duplicates stay distinct
+    std::unordered_map<QString, uint32_t> fileIds;
+
+    auto trackKeys = [&fileIds](const PlaylistTrackList& tracks) {
+        std::unordered_map<uint32_t, uint32_t> occurrences;
+        std::vector<uint64_t> keys;
+        keys.reserve(tracks.size());
+
+        for(const PlaylistTrack& track : tracks) {
+            const auto nextId    = static_cast<uint32_t>(fileIds.size());
+            const auto [it, _]   = fileIds.try_emplace(track.track.uniqueFilepath(), nextId);
+            const uint32_t count = occurrences[it->second]++;
+            keys.push_back((static_cast<uint64_t>(it->second) << 32) | count);
+        }
+        return keys;
+    };
+
+    const auto oldKeys = trackKeys(oldTracks);
+    const auto newKeys = trackKeys(newTracks);
+
+    return diffSequences(oldKeys, newKeys);
+}
+
+void PlaylistPopulatorPrivate::logMemoStats() const
+{
+    const ScriptMemoStats stats = m_parser.memoStats();
+    qCDebug(PL_POPULATOR) << "Script memo hits:" << stats.hits << "misses:" << stats.misses
+                          << "hit rate:" << stats.hitRate() * 100 << "%";
 }
 
 PlaylistPopulator::PlaylistPopulator(PlayerController* playerController, QObject* parent)
@@ -373,6 +458,11 @@ void PlaylistPopulator::setUseVarious(bool enabled)
     p->m_registry->setUseVariousArtists(enabled);
 }
 
+void PlaylistPopulator::setLazyTracks(bool enabled)
+{
+    p->m_lazyTracks = enabled;
+}
+
 void PlaylistPopulator::run(const UId& playlistId, const PlaylistPreset& preset, const PlaylistColumnList& columns,
                             const PlaylistTrackList& tracks)
 {
@@ -385,8 +475,10 @@ void PlaylistPopulator::run(const UId& playlistId, const PlaylistPreset& preset,
     p->m_columns         = columns;
     p->m_pendingTracks   = tracks;
     p->m_registry->setup(playlistId, p->m_playerController->playbackQueue());
+    p->m_parser.resetMemoStats();
 
     p->runBatch(TrackPreloadSize, 0);
+    p->logMemoStats();
 
     emit finished();
 
@@ -404,8 +496,54 @@ void PlaylistPopulator::runTracks(const UId& playlistId, const PlaylistPreset& p
     p->m_currentPreset   = preset;
     p->m_columns         = columns;
     p->m_registry->setup(playlistId, p->m_playerController->playbackQueue());
+    p->m_parser.resetMemoStats();
 
     p->runTracksGroup(tracks);
+    p->logMemoStats();
+
+    setState(Idle);
+}
+
+void PlaylistPopulator::runDiff(const UId& playlistId, const PlaylistPreset& preset, const PlaylistColumnList& columns,
+                                const PlaylistTrackList& oldTracks, const PlaylistTrackList& newTracks)
+{
+    setState(Running);
+
+    const SequenceDiff diff = PlaylistPopulatorPrivate::diffTracks(oldTracks, newTracks);
+
+    const int rangeCount = SequenceDiff::rangeCount(diff.removed) + SequenceDiff::rangeCount(diff.inserted);
+    if(rangeCount > MaxDiffRanges || diff.removed.size() == oldTracks.size()) {
+        qCDebug(PL_POPULATOR) << "Replacing playlist tracks with" << rangeCount << "changed ranges; resetting";
+        emit replaceRequired(playlistId, newTracks);
+        setState(Idle);
+        return;
+    }
+
+    std::map<int, PlaylistTrackList> insertGroups;
+    int groupStart{-1};
+    for(size_t i{0}; i < diff.inserted.size(); ++i) {
+        const int index = diff.inserted.at(i);
+        if(i == 0 || index != diff.inserted.at(i - 1) + 1) {
+            groupStart = index;
+        }
+        insertGroups[groupStart].push_back(newTracks.at(index));
+    }
+
+    p->reset();
+
+    p->m_data.playlistId     = playlistId;
+    p->m_data.removedIndexes = diff.removed;
+    p->m_data.replacement    = true;
+    p->m_currentPreset       = preset;
+    p->m_columns             = columns;
+    p->m_registry->setup(playlistId, p->m_playerController->playbackQueue());
+    p->m_parser.resetMemoStats();
+
+    if(!p->runTracksGroup(insertGroups)) {
+        // Still reported, so anything waiting on the replacement isn't left waiting for a later one
+        emit replaceCancelled(playlistId);
+    }
+    p->logMemoStats();
 
     setState(Idle);
 }
@@ -424,25 +562,7 @@ void PlaylistPopulator::updateTracks(const UId& playlistId, const PlaylistPreset
         PlaylistTrackItem& trackData = std::get<0>(item.data());
 
         trackData.setTrack(track);
-        p->m_registry->setTrackProperties(trackData.track().indexInPlaylist, trackData.depth());
-
-        if(!columns.empty()) {
-            std::vector<RichScript> trackColumns;
-            for(const auto& column : columns) {
-                const auto evalScript = p->m_parser.evaluate(column.field, track.track);
-                trackColumns.emplace_back(column.field, p->m_formatter.evaluate(evalScript));
-            }
-            trackData.setColumns(trackColumns);
-        }
-        else {
-            RichScript trackLeft{preset.track.leftText};
-            RichScript trackRight{preset.track.rightText};
-
-            p->evaluateTrackScript(trackLeft, track.track);
-            p->evaluateTrackScript(trackRight, track.track);
-
-            trackData.setLeftRight(trackLeft, trackRight);
-        }
+        p->evaluateTrackText(trackData, track, preset, columns);
 
         updatedTracks.push_back(item);
     }
@@ -468,6 +588,22 @@ void PlaylistPopulator::updateHeaders(const ItemList& headers)
 
     setState(Idle);
 }
+
+void PlaylistPopulator::evaluateTracks(const UId& playlistId, const PlaylistPreset& preset,
+                                       const PlaylistColumnList& columns, const ItemList& tracks)
+{
+    p->m_registry->setup(playlistId, p->m_playerController->playbackQueue());
+
+    ItemList evaluatedTracks{tracks};
+
+    for(PlaylistItem& item : evaluatedTracks) {
+        auto& trackData = std::get<PlaylistTrackItem>(item.data());
+        p->evaluateTrackText(trackData, trackData.track(), preset, columns);
+        trackData.calculateSize();
+    }
+
+    emit tracksEvaluated(playlistId, evaluatedTracks);
+}
 } // namespace Fooyin
 
 #include "moc_playlistpopulator.cpp"
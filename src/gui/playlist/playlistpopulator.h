@@ -51,6 +51,9 @@ struct PendingData
     int row{-1};
 
     IndexGroupMap indexNodes;
+    // Playlist indexes to remove before inserting, used when replacing tracks in place
+    std::vector<int> removedIndexes;
+    bool replacement{false};
 
     void clear()
     {
@@ -61,6 +64,8 @@ struct PendingData
         trackParents.clear();
         row = -1;
         indexNodes.clear();
+        removedIndexes.clear();
+        replacement = false;
     }
 };
 
@@ -74,20 +79,28 @@ public:
 
     void setFont(const QFont& font);
     void setUseVarious(bool enabled);
+    void setLazyTracks(bool enabled);
 
     void run(const UId& playlistId, const PlaylistPreset& preset, const PlaylistColumnList& columns,
              const PlaylistTrackList& tracks);
     void runTracks(const UId& playlistId, const PlaylistPreset& preset, const PlaylistColumnList& columns,
                    const std::map<int, PlaylistTrackList>& tracks);
+    void runDiff(const UId& playlistId, const PlaylistPreset& preset, const PlaylistColumnList& columns,
+                 const PlaylistTrackList& oldTracks, const PlaylistTrackList& newTracks);
     void updateTracks(const UId& playlistId, const PlaylistPreset& preset, const PlaylistColumnList& columns,
                       const TrackItemMap& tracks);
     void updateHeaders(const ItemList& headers);
+    void evaluateTracks(const UId& playlistId, const PlaylistPreset& preset, const PlaylistColumnList& columns,
+                        const ItemList& tracks);
 
 signals:
     void populated(Fooyin::PendingData data);
     void populatedTrackGroup(Fooyin::PendingData data);
+    void replaceRequired(const Fooyin::UId& playlistId, Fooyin::PlaylistTrackList tracks);
+    void replaceCancelled(const Fooyin::UId& playlistId);
     void tracksUpdated(Fooyin::ItemList tracks);
     void headersUpdated(Fooyin::ItemKeyMap headers);
+    void tracksEvaluated(const Fooyin::UId& playlistId, Fooyin::ItemList tracks);
 
 private:
     std::unique_ptr<PlaylistPopulatorPrivate> p;
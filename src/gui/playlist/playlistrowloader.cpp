@@ -0,0 +1,124 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "playlistrowloader.h"
+
+#include <QTimer>
+
+namespace Fooyin {
+PlaylistRowLoader::PlaylistRowLoader(int capacity, QObject* parent)
+    : QObject{parent}
+    , m_capacity{capacity}
+    , m_flushQueued{false}
+{ }
+
+void PlaylistRowLoader::clear()
+{
+    m_requested.clear();
+    m_loading.clear();
+    m_order.clear();
+    m_loaded.clear();
+}
+
+void PlaylistRowLoader::request(const UId& key, int playlistIndex)
+{
+    if(playlistIndex < 0 || m_loading.contains(key)) {
+        return;
+    }
+
+    m_requested.emplace(playlistIndex);
+
+    if(!std::exchange(m_flushQueued, true)) {
+        QTimer::singleShot(0, this, &PlaylistRowLoader::flushRequests);
+    }
+}
+
+void PlaylistRowLoader::touch(const UId& key)
+{
+    const auto rowIt = m_loaded.find(key);
+    if(rowIt != m_loaded.end()) {
+        m_order.splice(m_order.begin(), m_order, rowIt->second);
+    }
+}
+
+bool PlaylistRowLoader::isLoading(const UId& key) const
+{
+    return m_loading.contains(key);
+}
+
+void PlaylistRowLoader::setLoading(const UId& key)
+{
+    m_loading.emplace(key);
+}
+
+std::vector<UId> PlaylistRowLoader::setLoaded(const UId& key)
+{
+    m_loading.erase(key);
+
+    if(m_loaded.contains(key)) {
+        touch(key);
+        return {};
+    }
+
+    m_order.push_front(key);
+    m_loaded.emplace(key, m_order.begin());
+
+    std::vector<UId> evicted;
+    while(std::cmp_greater(m_loaded.size(), m_capacity)) {
+        const UId oldest = m_order.back();
+        m_order.pop_back();
+        m_loaded.erase(oldest);
+        evicted.push_back(oldest);
+    }
+
+    return evicted;
+}
+
+void PlaylistRowLoader::remove(const UId& key)
+{
+    m_loading.erase(key);
+
+    const auto rowIt = m_loaded.find(key);
+    if(rowIt != m_loaded.end()) {
+        m_order.erase(rowIt->second);
+        m_loaded.erase(rowIt);
+    }
+}
+
+int PlaylistRowLoader::loadedCount() const
+{
+    return static_cast<int>(m_loaded.size());
+}
+
+void PlaylistRowLoader::flushRequests()
+{
+    m_flushQueued = false;
+
+    if(m_requested.empty()) {
+        return;
+    }
+
+    const std::vector<int> indexes{m_requested.cbegin(), m_requested.cend()};
+    m_requested.clear();
+
+    emit rowsRequested(indexes);
+}
+} // namespace Fooyin
+
+#include "moc_playlistrowloader.cpp"
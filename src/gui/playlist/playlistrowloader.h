@@ -0,0 +1,78 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fygui_export.h"
+
+#include <utils/id.h>
+
+#include <QObject>
+
+#include <list>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Fooyin {
+/*!
+ * Tracks the rows of a lazily populated playlist whose text has been evaluated.
+ * Requests from the model are coalesced until control returns to the event loop,
+ * and evaluated rows are kept in least-recently-used order so their text can be
+ * dropped once the budget is exceeded.
+ */
+class FYGUI_EXPORT PlaylistRowLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PlaylistRowLoader(int capacity, QObject* parent = nullptr);
+
+    void clear();
+
+    /** Queues the row at @p playlistIndex for evaluation unless it is already loading. */
+    void request(const UId& key, int playlistIndex);
+    /** Marks the row as recently used if its text is cached. */
+    void touch(const UId& key);
+
+    [[nodiscard]] bool isLoading(const UId& key) const;
+    void setLoading(const UId& key);
+
+    /** Records the row as evaluated and returns the rows which should be dropped to stay within capacity. */
+    std::vector<UId> setLoaded(const UId& key);
+    /** Forgets the row, e.g. once it has been removed from the model. */
+    void remove(const UId& key);
+
+    [[nodiscard]] int loadedCount() const;
+
+signals:
+    void rowsRequested(const std::vector<int>& indexes);
+
+private:
+    void flushRequests();
+
+    int m_capacity;
+    bool m_flushQueued;
+    std::set<int> m_requested;
+    std::unordered_set<UId, UId::UIdHash> m_loading;
+
+    std::list<UId> m_order;
+    std::unordered_map<UId, std::list<UId>::iterator, UId::UIdHash> m_loaded;
+};
+} // namespace Fooyin
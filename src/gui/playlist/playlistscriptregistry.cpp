@@ -135,6 +135,11 @@ bool PlaylistScriptRegistry::isVariable(const QString& var, const Track& track)
     return ScriptRegistry::isVariable(var, track);
 }
 
+bool PlaylistScriptRegistry::isStateVariable(const QString& var) const
+{
+    return p->m_vars.contains(var) || ScriptRegistry::isStateVariable(var);
+}
+
 ScriptResult PlaylistScriptRegistry::value(const QString& var, const Track& track) const
 {
     if(isListVariable(var)) {
@@ -41,6 +41,7 @@ public:
     void setTrackProperties(int index, int depth);
 
     [[nodiscard]] bool isVariable(const QString& var, const Track& track) const override;
+    [[nodiscard]] bool isStateVariable(const QString& var) const override;
     [[nodiscard]] ScriptResult value(const QString& var, const Track& track) const override;
 
 protected:
@@ -24,12 +24,81 @@
 #include <gui/scripting/scriptformatterregistry.h>
 
 #include <QApplication>
+#include <QCache>
 #include <QPalette>
 
+#include <mutex>
+#include <optional>
 #include <stack>
 
 using namespace Qt::StringLiterals;
 
+namespace {
+// Approximate memory budget in bytes for all cached results
+constexpr auto FormatCacheSize = 8 * 1024 * 1024;
+
+struct FormatKey
+{
+    QString input;
+    QString font;
+    QRgb colour;
+
+    bool operator==(const FormatKey& other) const
+    {
+        return std::tie(input, font, colour) == std::tie(other.input, other.font, other.colour);
+    }
+};
+
+size_t qHash(const FormatKey& key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.input, key.font, key.colour);
+}
+
+/*!
+ * Formatted results shared between all ScriptFormatter instances.
+ * Populators on different threads tend to format the same small set of strings,
+ * and returning copies of a cached result also shares the underlying text and
+ * font data between items.
+ */
+class FormatCache
+{
+public:
+    FormatCache()
+        : m_cache{FormatCacheSize}
+    { }
+
+    std::optional<Fooyin::RichText> get(const FormatKey& key)
+    {
+        const std::scoped_lock lock{m_mutex};
+        if(const auto* text = m_cache.object(key)) {
+            return *text;
+        }
+        return {};
+    }
+
+    void insert(const FormatKey& key, const Fooyin::RichText& text)
+    {
+        qsizetype cost = key.input.size() * 2;
+        for(const auto& block : text) {
+            cost += static_cast<qsizetype>(sizeof(Fooyin::RichTextBlock)) + block.text.size() * 2;
+        }
+
+        const std::scoped_lock lock{m_mutex};
+        m_cache.insert(key, new Fooyin::RichText{text}, cost);
+    }
+
+private:
+    std::mutex m_mutex;
+    QCache<FormatKey, Fooyin::RichText> m_cache;
+};
+
+FormatCache& formatCache()
+{
+    static FormatCache cache;
+    return cache;
+}
+} // namespace
+
 namespace Fooyin {
 class ScriptFormatterPrivate
 {
@@ -49,9 +118,12 @@ public:
     void closeBlock();
     void resetFormat();
 
+    RichText format(const QString& input);
+
     ScriptScanner m_scanner;
     ScriptFormatterRegistry m_registry;
     QFont m_font;
+    QString m_fontKey;
 
     ScriptScanner::Token m_current;
     ScriptScanner::Token m_previous;
@@ -276,9 +348,31 @@ void ScriptFormatterPrivate::resetFormat()
     m_currentBlock.format.colour = QApplication::palette().text().color();
 }
 
+RichText ScriptFormatterPrivate::format(const QString& input)
+{
+    resetFormat();
+    m_formatResult.clear();
+    m_scanner.setup(input);
+
+    advance();
+    while(m_current.type != ScriptScanner::TokEos) {
+        expression();
+    }
+
+    consume(ScriptScanner::TokEos, u"Expected end of expression"_s);
+
+    if(!m_currentBlock.text.isEmpty()) {
+        m_formatResult.emplace_back(m_currentBlock);
+    }
+
+    return m_formatResult;
+}
+
 ScriptFormatter::ScriptFormatter()
     : p{std::make_unique<ScriptFormatterPrivate>()}
-{ }
+{
+    p->m_fontKey = p->m_font.key();
+}
 
 ScriptFormatter::~ScriptFormatter() = default;
 
@@ -288,26 +382,21 @@ RichText ScriptFormatter::evaluate(const QString& input)
         return {};
     }
 
-    p->resetFormat();
-    p->m_formatResult.clear();
-    p->m_scanner.setup(input);
+    const FormatKey key{.input = input, .font = p->m_fontKey, .colour = QApplication::palette().text().color().rgba()};
 
-    p->advance();
-    while(p->m_current.type != ScriptScanner::TokEos) {
-        p->expression();
+    if(auto text = formatCache().get(key)) {
+        return text.value();
     }
 
-    p->consume(ScriptScanner::TokEos, u"Expected end of expression"_s);
-
-    if(!p->m_currentBlock.text.isEmpty()) {
-        p->m_formatResult.emplace_back(p->m_currentBlock);
-    }
+    RichText text = p->format(input);
+    formatCache().insert(key, text);
 
-    return p->m_formatResult;
+    return text;
 }
 
 void ScriptFormatter::setBaseFont(const QFont& font)
 {
-    p->m_font = font;
+    p->m_font    = font;
+    p->m_fontKey = font.key();
 }
 } // namespace Fooyin
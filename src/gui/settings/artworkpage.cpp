@@ -21,6 +21,7 @@
 
 #include "internalguisettings.h"
 
+#include <gui/coverprovider.h>
 #include <gui/guiconstants.h>
 #include <gui/guipaths.h>
 #include <utils/fileutils.h>
@@ -28,7 +29,7 @@
 #include <utils/stringutils.h>
 
 #include <QButtonGroup>
-#include <QDir>
+#include <QCheckBox>
 #include <QGridLayout>
 #include <QGroupBox>
 #include <QLabel>
@@ -66,6 +67,8 @@ private:
     QPlainTextEdit* m_artistCovers;
 
     QSpinBox* m_pixmapCache;
+    QSpinBox* m_thumbnailCache;
+    QCheckBox* m_rawThumbnails;
     QLabel* m_cacheSizeLabel;
 };
 
@@ -78,6 +81,8 @@ ArtworkPageWidget::ArtworkPageWidget(SettingsManager* settings)
     , m_backCovers{new QPlainTextEdit(this)}
     , m_artistCovers{new QPlainTextEdit(this)}
     , m_pixmapCache{new QSpinBox(this)}
+    , m_thumbnailCache{new QSpinBox(this)}
+    , m_rawThumbnails{new QCheckBox(tr("Store thumbnails uncompressed"), this)}
     , m_cacheSizeLabel{new QLabel(this)}
 {
     auto* layout = new QGridLayout(this);
@@ -105,15 +110,26 @@ ArtworkPageWidget::ArtworkPageWidget(SettingsManager* settings)
     m_pixmapCache->setMaximum(1000);
     m_pixmapCache->setSuffix(u" MB"_s);
 
+    auto* thumbnailCacheLabel = new QLabel(tr("Disk cache size") + u":"_s, this);
+
+    m_thumbnailCache->setMinimum(16);
+    m_thumbnailCache->setMaximum(10000);
+    m_thumbnailCache->setSuffix(u" MB"_s);
+
+    m_rawThumbnails->setToolTip(tr("Uses more disk space, but thumbnails no longer need to be decoded when loaded"));
+
     auto* clearCacheButton = new QPushButton(tr("Clear Cache"), this);
     QObject::connect(clearCacheButton, &QPushButton::clicked, this, [this]() {
-        QDir{Gui::coverPath()}.removeRecursively();
+        CoverProvider::clearCache();
         updateCacheSize();
     });
 
     int row{0};
     cacheLayout->addWidget(pixmapCacheLabel, row, 0);
     cacheLayout->addWidget(m_pixmapCache, row++, 1);
+    cacheLayout->addWidget(thumbnailCacheLabel, row, 0);
+    cacheLayout->addWidget(m_thumbnailCache, row++, 1);
+    cacheLayout->addWidget(m_rawThumbnails, row++, 0, 1, 2);
     cacheLayout->addWidget(m_cacheSizeLabel, row, 0);
     cacheLayout->addWidget(clearCacheButton, row++, 1);
     cacheLayout->setColumnStretch(cacheLayout->columnCount(), 1);
@@ -142,6 +158,8 @@ void ArtworkPageWidget::load()
     m_artistCovers->setPlainText(paths.artistPaths.join("\n"_L1));
 
     m_pixmapCache->setValue(m_settings->value<Settings::Gui::Internal::PixmapCacheSize>());
+    m_thumbnailCache->setValue(m_settings->value<Settings::Gui::Internal::ThumbnailCacheSize>());
+    m_rawThumbnails->setChecked(m_settings->value<Settings::Gui::Internal::RawThumbnails>());
     updateCacheSize();
 }
 
@@ -160,6 +178,8 @@ void ArtworkPageWidget::apply()
 
     m_settings->set<Settings::Gui::Internal::TrackCoverPaths>(QVariant::fromValue(paths));
     m_settings->set<Settings::Gui::Internal::PixmapCacheSize>(m_pixmapCache->value());
+    m_settings->set<Settings::Gui::Internal::ThumbnailCacheSize>(m_thumbnailCache->value());
+    m_settings->set<Settings::Gui::Internal::RawThumbnails>(m_rawThumbnails->isChecked());
 }
 
 void ArtworkPageWidget::reset()
@@ -167,6 +187,8 @@ void ArtworkPageWidget::reset()
     m_settings->reset<Settings::Gui::Internal::TrackCoverDisplayOption>();
     m_settings->reset<Settings::Gui::Internal::TrackCoverPaths>();
     m_settings->reset<Settings::Gui::Internal::PixmapCacheSize>();
+    m_settings->reset<Settings::Gui::Internal::ThumbnailCacheSize>();
+    m_settings->reset<Settings::Gui::Internal::RawThumbnails>();
 }
 
 void ArtworkPageWidget::updateCacheSize()
@@ -41,6 +41,7 @@
 #include <QLabel>
 #include <QMessageBox>
 #include <QPushButton>
+#include <QSpinBox>
 #include <QSystemTrayIcon>
 
 #include <ranges>
@@ -83,6 +84,9 @@ private:
     QCheckBox* m_minimiseToTray;
 
     QComboBox* m_language;
+
+    QCheckBox* m_stallDetection;
+    QSpinBox* m_stallThreshold;
     std::map<QString, QString, SortLanguages> m_languageMap;
 };
 
@@ -93,6 +97,8 @@ GeneralPageWidget::GeneralPageWidget(SettingsManager* settings)
     , m_showTray{new QCheckBox(tr("Show system tray icon"), this)}
     , m_minimiseToTray{new QCheckBox(tr("Minimise to tray on close"), this)}
     , m_language{new QComboBox(this)}
+    , m_stallDetection{new QCheckBox(tr("Detect interface stalls"), this)}
+    , m_stallThreshold{new QSpinBox(this)}
 {
     m_waitForTracks->setToolTip(tr("Delay opening fooyin until all tracks have been loaded"));
 
@@ -115,6 +121,21 @@ GeneralPageWidget::GeneralPageWidget(SettingsManager* settings)
     dirGroupLayout->addWidget(openConfig, row, 0);
     dirGroupLayout->addWidget(openShare, row++, 1);
 
+    auto* diagnosticsGroup       = new QGroupBox(tr("Diagnostics"), this);
+    auto* diagnosticsGroupLayout = new QGridLayout(diagnosticsGroup);
+
+    m_stallDetection->setToolTip(tr("Log slow event handling and paints, and write them to a trace file in the cache "
+                                    "directory"));
+
+    m_stallThreshold->setRange(16, 10000);
+    m_stallThreshold->setSuffix(u" ms"_s);
+
+    row = 0;
+    diagnosticsGroupLayout->addWidget(m_stallDetection, row++, 0, 1, 2);
+    diagnosticsGroupLayout->addWidget(new QLabel(tr("Threshold") + u":"_s, this), row, 0);
+    diagnosticsGroupLayout->addWidget(m_stallThreshold, row++, 1);
+    diagnosticsGroupLayout->setColumnStretch(2, 1);
+
     auto* mainLayout = new QGridLayout(this);
 
     row = 0;
@@ -124,6 +145,7 @@ GeneralPageWidget::GeneralPageWidget(SettingsManager* settings)
     mainLayout->addWidget(m_minimiseToTray, row++, 0, 1, 2);
     mainLayout->addWidget(startupGroup, row++, 0, 1, 2);
     mainLayout->addWidget(dirGroup, row++, 0, 1, 2);
+    mainLayout->addWidget(diagnosticsGroup, row++, 0, 1, 2);
 
     mainLayout->setColumnStretch(1, 1);
     mainLayout->setRowStretch(mainLayout->rowCount(), 1);
@@ -138,6 +160,7 @@ GeneralPageWidget::GeneralPageWidget(SettingsManager* settings)
     addStartupBehaviour(tr("Remember from last run"), MainWindow::StartPrev);
 
     QObject::connect(m_showTray, &QCheckBox::toggled, m_minimiseToTray, &QWidget::setEnabled);
+    QObject::connect(m_stallDetection, &QCheckBox::toggled, m_stallThreshold, &QWidget::setEnabled);
     QObject::connect(openConfig, &QPushButton::clicked, this, []() { QDesktopServices::openUrl(Utils::configPath()); });
     QObject::connect(openShare, &QPushButton::clicked, this, []() { QDesktopServices::openUrl(Utils::sharePath()); });
 }
@@ -153,6 +176,10 @@ void GeneralPageWidget::load()
 
     m_showTray->setEnabled(QSystemTrayIcon::isSystemTrayAvailable());
     m_minimiseToTray->setEnabled(QSystemTrayIcon::isSystemTrayAvailable() && m_showTray->isChecked());
+
+    m_stallDetection->setChecked(m_settings->value<Settings::Gui::Internal::StallDetection>());
+    m_stallThreshold->setValue(m_settings->value<Settings::Gui::Internal::StallThreshold>());
+    m_stallThreshold->setEnabled(m_stallDetection->isChecked());
 }
 
 void GeneralPageWidget::apply()
@@ -174,6 +201,8 @@ void GeneralPageWidget::apply()
     m_settings->set<Settings::Gui::WaitForTracks>(m_waitForTracks->isChecked());
     m_settings->set<Settings::Gui::Internal::ShowTrayIcon>(m_showTray->isChecked());
     m_settings->set<Settings::Gui::Internal::TrayOnClose>(m_minimiseToTray->isChecked());
+    m_settings->set<Settings::Gui::Internal::StallDetection>(m_stallDetection->isChecked());
+    m_settings->set<Settings::Gui::Internal::StallThreshold>(m_stallThreshold->value());
 }
 
 void GeneralPageWidget::reset()
@@ -183,6 +212,8 @@ void GeneralPageWidget::reset()
     m_settings->reset<Settings::Gui::WaitForTracks>();
     m_settings->reset<Settings::Gui::Internal::ShowTrayIcon>();
     m_settings->reset<Settings::Gui::Internal::TrayOnClose>();
+    m_settings->reset<Settings::Gui::Internal::StallDetection>();
+    m_settings->reset<Settings::Gui::Internal::StallThreshold>();
 }
 
 void GeneralPageWidget::loadLanguage()
@@ -113,6 +113,7 @@ private:
     QCheckBox* m_useVariousCompilations;
     QCheckBox* m_saveRatings;
     QCheckBox* m_savePlaycounts;
+    QCheckBox* m_analyseNewTracks;
 };
 
 LibraryGeneralPageWidget::LibraryGeneralPageWidget(ActionManager* actionManager, LibraryManager* libraryManager,
@@ -131,6 +132,7 @@ LibraryGeneralPageWidget::LibraryGeneralPageWidget(ActionManager* actionManager,
     , m_useVariousCompilations{new QCheckBox(tr("Use 'Various Artists' for compilations"), this)}
     , m_saveRatings{new QCheckBox(tr("Save ratings to file metadata"), this)}
     , m_savePlaycounts{new QCheckBox(tr("Save playcount to file metadata"), this)}
+    , m_analyseNewTracks{new QCheckBox(tr("Analyse new tracks after scanning"), this)}
 {
     m_libraryView->setExtendableModel(m_model);
 
@@ -143,6 +145,9 @@ LibraryGeneralPageWidget::LibraryGeneralPageWidget(ActionManager* actionManager,
 
     m_autoRefresh->setToolTip(tr("Scan libraries for changes on startup"));
     m_monitorLibraries->setToolTip(tr("Monitor libraries for external changes"));
+    m_analyseNewTracks->setToolTip(
+        tr("Decode each new track once in the background to verify its duration and run any analysis "
+           "provided by plugins, such as ReplayGain and waveform generation"));
 
     auto* fileTypesGroup  = new QGroupBox(tr("File Types"), this);
     auto* fileTypesLayout = new QGridLayout(fileTypesGroup);
@@ -167,6 +172,7 @@ LibraryGeneralPageWidget::LibraryGeneralPageWidget(ActionManager* actionManager,
     mainLayout->addWidget(m_useVariousCompilations, row++, 0, 1, 2);
     mainLayout->addWidget(m_saveRatings, row++, 0, 1, 2);
     mainLayout->addWidget(m_savePlaycounts, row++, 0, 1, 2);
+    mainLayout->addWidget(m_analyseNewTracks, row++, 0, 1, 2);
     mainLayout->setColumnStretch(1, 1);
 
     QObject::connect(m_model, &LibraryModel::requestAddLibrary, this, &LibraryGeneralPageWidget::addLibrary);
@@ -194,6 +200,7 @@ void LibraryGeneralPageWidget::load()
     m_useVariousCompilations->setChecked(m_settings->value<Settings::Core::UseVariousForCompilations>());
     m_saveRatings->setChecked(m_settings->value<Settings::Core::SaveRatingToMetadata>());
     m_savePlaycounts->setChecked(m_settings->value<Settings::Core::SavePlaycountToMetadata>());
+    m_analyseNewTracks->setChecked(m_settings->value<Settings::Core::AnalyseNewTracks>());
 }
 
 void LibraryGeneralPageWidget::apply()
@@ -212,6 +219,7 @@ void LibraryGeneralPageWidget::apply()
     m_settings->set<Settings::Core::UseVariousForCompilations>(m_useVariousCompilations->isChecked());
     m_settings->set<Settings::Core::SaveRatingToMetadata>(m_saveRatings->isChecked());
     m_settings->set<Settings::Core::SavePlaycountToMetadata>(m_savePlaycounts->isChecked());
+    m_settings->set<Settings::Core::AnalyseNewTracks>(m_analyseNewTracks->isChecked());
 }
 
 void LibraryGeneralPageWidget::reset()
@@ -226,6 +234,7 @@ void LibraryGeneralPageWidget::reset()
     m_settings->reset<Settings::Core::UseVariousForCompilations>();
     m_settings->reset<Settings::Core::SaveRatingToMetadata>();
     m_settings->reset<Settings::Core::SavePlaycountToMetadata>();
+    m_settings->reset<Settings::Core::AnalyseNewTracks>();
 }
 
 void LibraryGeneralPageWidget::addLibrary() const
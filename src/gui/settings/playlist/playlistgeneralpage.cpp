@@ -65,6 +65,7 @@ private:
     QCheckBox* m_scrollBars;
     QCheckBox* m_header;
     QCheckBox* m_altColours;
+    QCheckBox* m_lazyRows;
 
     QCheckBox* m_tabsExpand;
     QCheckBox* m_tabsAddButton;
@@ -89,6 +90,7 @@ PlaylistGeneralPageWidget::PlaylistGeneralPageWidget(const QStringList& playlist
     , m_scrollBars{new QCheckBox(tr("Show scrollbar"), this)}
     , m_header{new QCheckBox(tr("Show header"), this)}
     , m_altColours{new QCheckBox(tr("Alternating row colours"), this)}
+    , m_lazyRows{new QCheckBox(tr("Only format visible rows of large playlists"), this)}
     , m_tabsExpand{new QCheckBox(tr("Expand tabs to fill empty space"), this)}
     , m_tabsAddButton{new QCheckBox(tr("Show add button"), this)}
     , m_tabsClearButton{new QCheckBox(tr("Show clear button"), this)}
@@ -166,6 +168,7 @@ PlaylistGeneralPageWidget::PlaylistGeneralPageWidget(const QStringList& playlist
     appearanceLayout->addWidget(m_scrollBars, row++, 0, 1, 2);
     appearanceLayout->addWidget(m_header, row++, 0, 1, 2);
     appearanceLayout->addWidget(m_altColours, row++, 0, 1, 2);
+    appearanceLayout->addWidget(m_lazyRows, row++, 0, 1, 2);
     appearanceLayout->addWidget(padding, row, 0, 1, 3);
     appearanceLayout->setColumnStretch(2, 1);
     appearanceLayout->setRowStretch(appearanceLayout->rowCount(), 1);
@@ -233,6 +236,7 @@ void PlaylistGeneralPageWidget::load()
     m_scrollBars->setChecked(m_settings->value<Settings::Gui::Internal::PlaylistScrollBar>());
     m_header->setChecked(m_settings->value<Settings::Gui::Internal::PlaylistHeader>());
     m_altColours->setChecked(m_settings->value<Settings::Gui::Internal::PlaylistAltColours>());
+    m_lazyRows->setChecked(m_settings->value<Settings::Gui::Internal::PlaylistLazyRows>());
 
     m_tabsExpand->setChecked(m_settings->value<Settings::Gui::Internal::PlaylistTabsExpand>());
     m_tabsAddButton->setChecked(m_settings->value<Settings::Gui::Internal::PlaylistTabsAddButton>());
@@ -258,6 +262,7 @@ void PlaylistGeneralPageWidget::apply()
     m_settings->set<Settings::Gui::Internal::PlaylistScrollBar>(m_scrollBars->isChecked());
     m_settings->set<Settings::Gui::Internal::PlaylistHeader>(m_header->isChecked());
     m_settings->set<Settings::Gui::Internal::PlaylistAltColours>(m_altColours->isChecked());
+    m_settings->set<Settings::Gui::Internal::PlaylistLazyRows>(m_lazyRows->isChecked());
 
     m_settings->set<Settings::Gui::Internal::PlaylistTabsExpand>(m_tabsExpand->isChecked());
     m_settings->set<Settings::Gui::Internal::PlaylistTabsAddButton>(m_tabsAddButton->isChecked());
@@ -283,6 +288,7 @@ void PlaylistGeneralPageWidget::reset()
     m_settings->reset<Settings::Gui::Internal::PlaylistScrollBar>();
     m_settings->reset<Settings::Gui::Internal::PlaylistHeader>();
     m_settings->reset<Settings::Gui::Internal::PlaylistAltColours>();
+    m_settings->reset<Settings::Gui::Internal::PlaylistLazyRows>();
 
     m_settings->reset<Settings::Gui::Internal::PlaylistTabsExpand>();
     m_settings->reset<Settings::Gui::Internal::PlaylistTabsAddButton>();
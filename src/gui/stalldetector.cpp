@@ -0,0 +1,390 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "stalldetector.h"
+
+#include "internalguisettings.h"
+
+#include <gui/painttimer.h>
+#include <utils/paths.h>
+#include <utils/settings/settingsmanager.h>
+
+#include <QAbstractEventDispatcher>
+#include <QCoreApplication>
+#include <QDir>
+#include <QEvent>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+#include <QMetaEnum>
+#include <QThread>
+#include <QTimer>
+
+#include <map>
+
+Q_LOGGING_CATEGORY(GUI_STALL, "fy.stall")
+
+using namespace Qt::StringLiterals;
+using namespace std::chrono_literals;
+
+constexpr auto WatchdogInterval = 250ms;
+// The watchdog reports the GUI thread if it is still blocked after this long
+constexpr auto HangThreshold = 1000ms;
+// Paints slower than a 60Hz frame are traced even when the event loop didn't stall
+constexpr auto FrameBudget     = 16ms;
+constexpr auto TraceWriteDelay = 2000ms;
+constexpr size_t MaxTraceEvents = 5000;
+
+namespace {
+Fooyin::StallDetector* activeDetector{nullptr};
+
+int64_t toNanoseconds(Fooyin::StallDetector::Clock::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+qint64 toMilliseconds(Fooyin::StallDetector::Clock::duration duration)
+{
+    return static_cast<qint64>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
+}
+
+QString tracePath()
+{
+    return QDir::cleanPath(Fooyin::Utils::cachePath().append("/gui-trace.json"_L1));
+}
+} // namespace
+
+namespace Fooyin {
+PaintTimer::PaintTimer(const char* widget)
+    : m_widget{widget}
+    , m_active{StallDetector::active() != nullptr}
+{
+    if(m_active) {
+        m_start = StallDetector::Clock::now();
+    }
+}
+
+PaintTimer::~PaintTimer()
+{
+    if(!m_active) {
+        return;
+    }
+
+    if(auto* detector = StallDetector::active()) {
+        detector->recordPaint(m_widget, m_start, StallDetector::Clock::now());
+    }
+}
+
+StallDetector::StallDetector(SettingsManager* settings, QObject* parent)
+    : QObject{parent}
+    , m_settings{settings}
+    , m_enabled{false}
+    , m_threshold{std::chrono::milliseconds{m_settings->value<Settings::Gui::Internal::StallThreshold>()}}
+    , m_sessionStart{Clock::now()}
+    , m_inSlice{false}
+    , m_blockedSince{0}
+    , m_blockedReceiver{nullptr}
+    , m_blockedType{0}
+    , m_reportedSince{0}
+    , m_watchdogThread{new QThread(this)}
+    , m_watchdogTimer{new QTimer()}
+    , m_traceWritePending{false}
+{
+    m_watchdogThread->setObjectName(u"StallWatchdog"_s);
+    m_watchdogTimer->setInterval(WatchdogInterval);
+    m_watchdogTimer->moveToThread(m_watchdogThread);
+
+    QObject::connect(m_watchdogThread, &QThread::started, m_watchdogTimer, qOverload<>(&QTimer::start));
+    QObject::connect(m_watchdogThread, &QThread::finished, m_watchdogTimer, &QTimer::stop);
+    QObject::connect(m_watchdogTimer, &QTimer::timeout, m_watchdogTimer, [this]() { checkBlocked(); });
+
+    if(auto* dispatcher = QAbstractEventDispatcher::instance()) {
+        QObject::connect(dispatcher, &QAbstractEventDispatcher::awake, this, [this]() {
+            if(m_enabled) {
+                sliceStarted();
+            }
+        });
+        QObject::connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, this, [this]() {
+            if(m_enabled) {
+                sliceFinished();
+            }
+        });
+    }
+
+    m_settings->subscribe<Settings::Gui::Internal::StallDetection>(this, [this](bool enabled) { setEnabled(enabled); });
+    m_settings->subscribe<Settings::Gui::Internal::StallThreshold>(
+        this, [this](int threshold) { m_threshold = std::chrono::milliseconds{threshold}; });
+
+    setEnabled(m_settings->value<Settings::Gui::Internal::StallDetection>());
+}
+
+StallDetector::~StallDetector()
+{
+    setEnabled(false);
+    delete m_watchdogTimer;
+}
+
+StallDetector* StallDetector::active()
+{
+    return activeDetector;
+}
+
+void StallDetector::recordPaint(const char* widget, Clock::time_point start, Clock::time_point end)
+{
+    if(m_enabled) {
+        m_slicePaints.push_back({widget, start, end - start});
+    }
+}
+
+bool StallDetector::eventFilter(QObject* watched, QEvent* event)
+{
+    if(!m_inSlice) {
+        sliceStarted();
+    }
+
+    const auto now = Clock::now();
+    closeCurrentEvent(now);
+
+    m_currentEvent = {watched->metaObject(), static_cast<int>(event->type()), now};
+    m_blockedReceiver.store(m_currentEvent.receiver, std::memory_order_relaxed);
+    m_blockedType.store(m_currentEvent.type, std::memory_order_relaxed);
+
+    return false;
+}
+
+void StallDetector::setEnabled(bool enabled)
+{
+    if(std::exchange(m_enabled, enabled) == enabled) {
+        return;
+    }
+
+    if(enabled) {
+        m_sessionStart = Clock::now();
+        m_trace.clear();
+        QCoreApplication::instance()->installEventFilter(this);
+        m_watchdogThread->start(QThread::LowPriority);
+        activeDetector = this;
+        qCInfo(GUI_STALL) << "Stall detection enabled; traces will be written to" << tracePath();
+    }
+    else {
+        activeDetector = nullptr;
+        if(auto* app = QCoreApplication::instance()) {
+            app->removeEventFilter(this);
+        }
+        m_watchdogThread->quit();
+        m_watchdogThread->wait();
+        m_inSlice = false;
+        m_blockedSince.store(0, std::memory_order_release);
+        m_slicePaints.clear();
+        if(!m_trace.empty()) {
+            writeTrace();
+        }
+    }
+}
+
+void StallDetector::sliceStarted()
+{
+    if(m_inSlice) {
+        return;
+    }
+
+    m_inSlice      = true;
+    m_sliceStart   = Clock::now();
+    m_currentEvent = {};
+    m_slowestEvent = {};
+    m_slicePaints.clear();
+
+    m_blockedReceiver.store(nullptr, std::memory_order_relaxed);
+    m_blockedSince.store(toNanoseconds(m_sliceStart), std::memory_order_release);
+}
+
+void StallDetector::sliceFinished()
+{
+    if(!m_inSlice) {
+        return;
+    }
+
+    const auto now = Clock::now();
+    closeCurrentEvent(now);
+
+    m_inSlice = false;
+    m_blockedSince.store(0, std::memory_order_release);
+
+    if(now - m_sliceStart >= m_threshold) {
+        reportStall(now);
+        return;
+    }
+
+    for(const auto& paint : m_slicePaints) {
+        if(paint.duration > FrameBudget) {
+            addTraceEvent({QString::fromLatin1(paint.widget), u"paint"_s, paint.start, paint.duration, {}});
+            scheduleTraceWrite();
+        }
+    }
+}
+
+void StallDetector::closeCurrentEvent(Clock::time_point now)
+{
+    if(!m_currentEvent.receiver) {
+        return;
+    }
+
+    // Nested events split their parent's time, so this is an approximation of the worst offender
+    m_currentEvent.duration = now - m_currentEvent.start;
+    if(m_currentEvent.duration > m_slowestEvent.duration) {
+        m_slowestEvent = m_currentEvent;
+    }
+    m_currentEvent = {};
+}
+
+void StallDetector::reportStall(Clock::time_point end)
+{
+    const auto duration    = end - m_sliceStart;
+    const QString slowest  = describeEvent(m_slowestEvent.receiver, m_slowestEvent.type);
+    const auto slowestTime = toMilliseconds(m_slowestEvent.duration);
+
+    std::map<QString, Clock::duration> paintTotals;
+    for(const auto& paint : m_slicePaints) {
+        paintTotals[QString::fromLatin1(paint.widget)] += paint.duration;
+    }
+
+    QStringList paints;
+    for(const auto& [widget, total] : paintTotals) {
+        paints.emplace_back(u"%1 %2ms"_s.arg(widget).arg(toMilliseconds(total)));
+    }
+
+    QString message = u"GUI thread stalled for %1ms; slowest event: %2 (%3ms)"_s.arg(toMilliseconds(duration))
+                          .arg(slowest)
+                          .arg(slowestTime);
+    if(!paints.empty()) {
+        message += u"; paints: %1"_s.arg(paints.join(", "_L1));
+    }
+    qCWarning(GUI_STALL).noquote() << message;
+
+    addTraceEvent({u"Stall"_s, u"stall"_s, m_sliceStart, duration, message});
+    if(m_slowestEvent.receiver) {
+        addTraceEvent({slowest, u"event"_s, m_slowestEvent.start, m_slowestEvent.duration, {}});
+    }
+    for(const auto& paint : m_slicePaints) {
+        addTraceEvent({QString::fromLatin1(paint.widget), u"paint"_s, paint.start, paint.duration, {}});
+    }
+
+    scheduleTraceWrite();
+}
+
+void StallDetector::checkBlocked()
+{
+    const int64_t blockedSince = m_blockedSince.load(std::memory_order_acquire);
+    if(blockedSince == 0) {
+        return;
+    }
+
+    const auto blockedFor = std::chrono::nanoseconds{toNanoseconds(Clock::now()) - blockedSince};
+    if(blockedFor < HangThreshold) {
+        return;
+    }
+
+    // Only report each blocked period once
+    if(m_reportedSince.exchange(blockedSince, std::memory_order_acq_rel) == blockedSince) {
+        return;
+    }
+
+    qCWarning(GUI_STALL).noquote()
+        << u"GUI thread has been blocked for over %1ms, currently handling %2"_s
+               .arg(toMilliseconds(blockedFor))
+               .arg(describeEvent(m_blockedReceiver.load(std::memory_order_relaxed),
+                                  m_blockedType.load(std::memory_order_relaxed)));
+}
+
+void StallDetector::addTraceEvent(TraceEvent event)
+{
+    m_trace.push_back(std::move(event));
+    while(m_trace.size() > MaxTraceEvents) {
+        m_trace.pop_front();
+    }
+}
+
+void StallDetector::scheduleTraceWrite()
+{
+    if(std::exchange(m_traceWritePending, true)) {
+        return;
+    }
+
+    QTimer::singleShot(TraceWriteDelay, this, [this]() {
+        m_traceWritePending = false;
+        writeTrace();
+    });
+}
+
+void StallDetector::writeTrace()
+{
+    QJsonArray events;
+
+    for(const auto& event : m_trace) {
+        QJsonObject object;
+        object["name"_L1] = event.name;
+        object["cat"_L1]  = event.category;
+        object["ph"_L1]   = u"X"_s;
+        object["ts"_L1]   = toTraceTime(event.start);
+        object["dur"_L1]  = static_cast<qint64>(
+            std::chrono::duration_cast<std::chrono::microseconds>(event.duration).count());
+        object["pid"_L1]  = static_cast<qint64>(QCoreApplication::applicationPid());
+        object["tid"_L1]  = 1;
+        if(!event.detail.isEmpty()) {
+            object["args"_L1] = QJsonObject{{u"detail"_s, event.detail}};
+        }
+        events.append(object);
+    }
+
+    QJsonObject root;
+    root["traceEvents"_L1]     = events;
+    root["displayTimeUnit"_L1] = u"ms"_s;
+
+    QFile file{tracePath()};
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(GUI_STALL) << "Could not write trace file" << file.fileName() << ":" << file.errorString();
+        return;
+    }
+
+    file.write(QJsonDocument{root}.toJson(QJsonDocument::Compact));
+}
+
+QString StallDetector::describeEvent(const QMetaObject* receiver, int type)
+{
+    static const QMetaEnum eventTypes = QMetaEnum::fromType<QEvent::Type>();
+
+    const char* typeName    = eventTypes.valueToKey(type);
+    const QString eventName = typeName ? QString::fromLatin1(typeName) : QString::number(type);
+
+    if(!receiver) {
+        return eventName;
+    }
+
+    return u"%1 for %2"_s.arg(eventName, QString::fromLatin1(receiver->className()));
+}
+
+qint64 StallDetector::toTraceTime(Clock::time_point time) const
+{
+    return static_cast<qint64>(std::chrono::duration_cast<std::chrono::microseconds>(time - m_sessionStart).count());
+}
+} // namespace Fooyin
+
+#include "moc_stalldetector.cpp"
@@ -0,0 +1,121 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <vector>
+
+class QThread;
+class QTimer;
+
+namespace Fooyin {
+class SettingsManager;
+
+/*!
+ * Watches the GUI event loop for stalls.
+ * Each busy period between the event loop waking and blocking again is timed, along with the events
+ * and widget paints handled in it. Periods over the configured threshold are logged with the slowest
+ * event, and written to a trace file which can be opened in chrome://tracing or Perfetto.
+ * A watchdog thread also reports the GUI thread while it is still blocked.
+ */
+class StallDetector : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit StallDetector(SettingsManager* settings, QObject* parent = nullptr);
+    ~StallDetector() override;
+
+    [[nodiscard]] static StallDetector* active();
+
+    void recordPaint(const char* widget, Clock::time_point start, Clock::time_point end);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    struct EventRecord
+    {
+        const QMetaObject* receiver{nullptr};
+        int type{0};
+        Clock::time_point start;
+        Clock::duration duration{0};
+    };
+
+    struct PaintRecord
+    {
+        const char* widget{nullptr};
+        Clock::time_point start;
+        Clock::duration duration{0};
+    };
+
+    struct TraceEvent
+    {
+        QString name;
+        QString category;
+        Clock::time_point start;
+        Clock::duration duration{0};
+        QString detail;
+    };
+
+    void setEnabled(bool enabled);
+    void sliceStarted();
+    void sliceFinished();
+    void closeCurrentEvent(Clock::time_point now);
+    void reportStall(Clock::time_point end);
+    void checkBlocked();
+
+    void addTraceEvent(TraceEvent event);
+    void scheduleTraceWrite();
+    void writeTrace();
+
+    [[nodiscard]] static QString describeEvent(const QMetaObject* receiver, int type);
+    [[nodiscard]] qint64 toTraceTime(Clock::time_point time) const;
+
+    SettingsManager* m_settings;
+    bool m_enabled;
+    Clock::duration m_threshold;
+    Clock::time_point m_sessionStart;
+
+    bool m_inSlice;
+    Clock::time_point m_sliceStart;
+    EventRecord m_currentEvent;
+    EventRecord m_slowestEvent;
+    std::vector<PaintRecord> m_slicePaints;
+
+    // Read by the watchdog thread
+    std::atomic<int64_t> m_blockedSince;
+    std::atomic<const QMetaObject*> m_blockedReceiver;
+    std::atomic<int> m_blockedType;
+    std::atomic<int64_t> m_reportedSince;
+
+    QThread* m_watchdogThread;
+    QTimer* m_watchdogTimer;
+
+    std::deque<TraceEvent> m_trace;
+    bool m_traceWritePending;
+};
+} // namespace Fooyin
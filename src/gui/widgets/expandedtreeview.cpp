@@ -19,6 +19,8 @@
 
 #include <gui/widgets/expandedtreeview.h>
 
+#include <gui/painttimer.h>
+#include <utils/prefixsumtree.h>
 #include <utils/utils.h>
 
 #include <QDrag>
@@ -610,12 +612,18 @@ private:
     void drawAndClipSpans(QPainter* painter, const QStyleOptionViewItem& option, int firstVisibleItem,
                           int firstVisibleItemOffset) const;
     void adjustViewOptionsForIndex(QStyleOptionViewItem* option, const QModelIndex& currentIndex) const;
+    [[nodiscard]] const PrefixSumTree& rowOffsets() const;
+
+    // Running totals of item height + padding, used when row heights aren't uniform
+    mutable PrefixSumTree m_rowOffsets;
+    mutable bool m_rowOffsetsValid{false};
 };
 
 void TreeView::invalidate()
 {
     m_uniformRowHeight = 0;
     m_p->m_uniformRoleHeights.clear();
+    m_rowOffsetsValid = false;
 }
 
 void TreeView::drawView(QPainter* painter, const QRegion& region) const
@@ -920,18 +928,13 @@ int TreeView::firstVisibleItem(int* offset) const
         return value / m_uniformRowHeight;
     }
 
-    int y{0};
-    for(int i{0}; i < count; ++i) {
-        const int height = itemHeight(i) + itemPadding(i);
-        y += height;
-        if(y > value) {
-            if(offset) {
-                *offset = y - value - height;
-            }
-            return i;
-        }
+    const auto& offsets = rowOffsets();
+
+    const int item = offsets.indexAt(value);
+    if(item >= 0 && offset) {
+        *offset = offsets.prefix(item) - value;
     }
-    return -1;
+    return item;
 }
 
 int TreeView::lastVisibleItem(int firstVisual, int offset) const
@@ -943,10 +946,17 @@ int TreeView::lastVisibleItem(int firstVisual, int offset) const
         }
     }
 
+    const int count = itemCount();
+
+    if(!m_p->m_uniformRowHeights) {
+        const auto& offsets = rowOffsets();
+        const int item      = offsets.indexAt(offsets.prefix(firstVisual) + offset + viewport()->height());
+        return item < 0 ? count - 1 : item;
+    }
+
     int y{-offset};
     const int value = viewport()->height();
 
-    const int count = itemCount();
     for(int i{firstVisual}; i < count; ++i) {
         y += itemHeight(i) + itemPadding(i);
         if(y > value) {
@@ -965,12 +975,8 @@ QPoint TreeView::coordinateForItem(int item) const
         if(m_p->m_uniformRowHeights) {
             return {0, (item * m_uniformRowHeight) - vertScrollValue};
         }
-        const auto& items = viewItems();
-        for(int index{0}, y{0}; const auto& viewItem : items) {
-            if(index == item) {
-                return {0, y - vertScrollValue};
-            }
-            y += itemHeight(index++) + viewItem.padding;
+        if(item >= 0 && item < itemCount()) {
+            return {0, rowOffsets().prefix(item) - vertScrollValue};
         }
     }
     else {
@@ -1026,19 +1032,16 @@ int TreeView::itemAtCoordinate(QPoint coordinate, bool includePadding) const
 
         const int contentsCoord = coordinate.y() + vertScrollValue;
 
-        int itemCoord{0};
-        for(int index{0}; index < count; ++index) {
-            const int height  = itemHeight(index);
-            const int padding = itemPadding(index);
-            itemCoord += height + padding;
+        const auto& offsets = rowOffsets();
 
-            if(itemCoord > contentsCoord) {
-                if(includePadding && (itemCoord - padding) < contentsCoord) {
-                    return -1;
-                }
-                return index >= count ? -1 : index;
-            }
+        const int index = offsets.indexAt(contentsCoord);
+        if(index < 0) {
+            return -1;
+        }
+        if(includePadding && (offsets.prefix(index + 1) - itemPadding(index)) < contentsCoord) {
+            return -1;
         }
+        return index;
     }
     else {
         const int topViewItemIndex{vertScrollValue};
@@ -1231,8 +1234,13 @@ void TreeView::updateScrollBars()
     }
     else {
         int contentsHeight{0};
-        for(int i{0}; i < count; ++i) {
-            contentsHeight += itemHeight(i) + itemPadding(i);
+        if(uniform) {
+            for(int i{0}; i < count; ++i) {
+                contentsHeight += itemHeight(i) + itemPadding(i);
+            }
+        }
+        else {
+            contentsHeight = rowOffsets().total();
         }
 
         const int vMax = contentsHeight - viewportHeight;
@@ -1300,6 +1308,10 @@ int TreeView::itemHeight(int item) const
     if(height <= 0) {
         height                = indexRowSizeHint(index);
         viewItem(item).height = height;
+
+        if(m_rowOffsetsValid && item < m_rowOffsets.size()) {
+            m_rowOffsets.set(item, std::max(height, 0) + viewItem(item).padding);
+        }
     }
 
     height = std::max(height, 0);
@@ -1311,6 +1323,25 @@ int TreeView::itemHeight(int item) const
     return height;
 }
 
+const PrefixSumTree& TreeView::rowOffsets() const
+{
+    const int count = itemCount();
+
+    if(!m_rowOffsetsValid || m_rowOffsets.size() != count) {
+        m_rowOffsetsValid = false;
+
+        std::vector<int> heights(count);
+        for(int i{0}; i < count; ++i) {
+            heights[i] = itemHeight(i) + itemPadding(i);
+        }
+
+        m_rowOffsets.build(heights);
+        m_rowOffsetsValid = true;
+    }
+
+    return m_rowOffsets;
+}
+
 int TreeView::itemPadding(int item) const
 {
     if(item < 0 || std::cmp_greater_equal(item, m_p->m_viewItems.size())) {
@@ -1630,6 +1661,8 @@ void TreeView::recalculatePadding()
             item.padding            = (max > sectionHeight) ? max - sectionHeight : 0;
         }
     }
+
+    m_rowOffsetsValid = false;
 }
 
 void TreeView::drawAndClipSpans(QPainter* painter, const QStyleOptionViewItem& option, int firstVisibleItem,
@@ -3642,6 +3675,8 @@ void ExpandedTreeView::dropEvent(QDropEvent* event)
 
 void ExpandedTreeView::paintEvent(QPaintEvent* event)
 {
+    const PaintTimer paintTimer{metaObject()->className()};
+
     p->layoutItems();
 
     QStylePainter painter{viewport()};
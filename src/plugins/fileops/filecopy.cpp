@@ -0,0 +1,190 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "filecopy.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryFile>
+
+#include <algorithm>
+#include <filesystem>
+
+#if defined(Q_OS_LINUX)
+#include <cerrno>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+using namespace Qt::StringLiterals;
+
+constexpr qint64 ChunkSize  = 8 * 1024 * 1024;
+constexpr qint64 BufferSize = 1024 * 1024;
+
+namespace {
+enum class CopyResult : uint8_t
+{
+    Copied = 0,
+    Unsupported,
+    Failed,
+};
+
+#if defined(Q_OS_LINUX)
+CopyResult cloneFile(int sourceFd, int destFd)
+{
+#ifdef FICLONE
+    if(::ioctl(destFd, FICLONE, sourceFd) == 0) {
+        return CopyResult::Copied;
+    }
+#else
+    Q_UNUSED(sourceFd)
+    Q_UNUSED(destFd)
+#endif
+    return CopyResult::Unsupported;
+}
+
+CopyResult copyInKernel(int sourceFd, int destFd, qint64 size, const Fooyin::FileOps::CopyProgress& progress,
+                        const Fooyin::FileOps::CopyCancel& cancelled)
+{
+    qint64 copied{0};
+
+    while(copied < size) {
+        if(cancelled && cancelled()) {
+            return CopyResult::Failed;
+        }
+
+        const auto length  = static_cast<size_t>(std::min(ChunkSize, size - copied));
+        const auto written = ::copy_file_range(sourceFd, nullptr, destFd, nullptr, length, 0);
+
+        if(written < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            // Older kernels can't copy across filesystems, and some filesystems don't support it at all
+            if(copied == 0 && (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP)) {
+                return CopyResult::Unsupported;
+            }
+            return CopyResult::Failed;
+        }
+
+        if(written == 0) {
+            break;
+        }
+
+        copied += written;
+        if(progress) {
+            progress(written);
+        }
+    }
+
+    return CopyResult::Copied;
+}
+#endif
+
+CopyResult copyBuffered(QFile& source, QFile& dest, const Fooyin::FileOps::CopyProgress& progress,
+                        const Fooyin::FileOps::CopyCancel& cancelled)
+{
+    QByteArray buffer(BufferSize, Qt::Uninitialized);
+
+    while(true) {
+        if(cancelled && cancelled()) {
+            return CopyResult::Failed;
+        }
+
+        const qint64 bytesRead = source.read(buffer.data(), buffer.size());
+        if(bytesRead < 0) {
+            return CopyResult::Failed;
+        }
+        if(bytesRead == 0) {
+            break;
+        }
+
+        if(dest.write(buffer.constData(), bytesRead) != bytesRead) {
+            return CopyResult::Failed;
+        }
+
+        if(progress) {
+            progress(bytesRead);
+        }
+    }
+
+    return dest.flush() ? CopyResult::Copied : CopyResult::Failed;
+}
+} // namespace
+
+namespace Fooyin::FileOps {
+bool fastCopy(const QString& source, const QString& destination, const CopyProgress& progress,
+              const CopyCancel& cancelled)
+{
+    if(QFileInfo::exists(destination)) {
+        return false;
+    }
+
+    QFile sourceFile{source};
+    if(!sourceFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    // Created alongside the destination so the final rename doesn't cross filesystems
+    QTemporaryFile destFile{destination + u".XXXXXX"_s};
+    if(!destFile.open()) {
+        return false;
+    }
+
+    const qint64 size = sourceFile.size();
+    CopyResult result{CopyResult::Unsupported};
+
+#if defined(Q_OS_LINUX)
+    result = cloneFile(sourceFile.handle(), destFile.handle());
+    if(result == CopyResult::Copied) {
+        if(progress) {
+            progress(size);
+        }
+    }
+    else {
+        result = copyInKernel(sourceFile.handle(), destFile.handle(), size, progress, cancelled);
+    }
+#endif
+
+    if(result == CopyResult::Unsupported) {
+        result = copyBuffered(sourceFile, destFile, progress, cancelled);
+    }
+
+    if(result != CopyResult::Copied) {
+        return false;
+    }
+
+    destFile.setPermissions(sourceFile.permissions());
+
+    return destFile.rename(destination);
+}
+
+bool renameFile(const QString& source, const QString& destination)
+{
+    if(QFileInfo::exists(destination)) {
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(std::filesystem::path{source.toStdU16String()},
+                            std::filesystem::path{destination.toStdU16String()}, error);
+    return !error;
+}
+} // namespace Fooyin::FileOps
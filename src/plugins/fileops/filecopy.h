@@ -0,0 +1,51 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QString>
+
+#include <functional>
+
+namespace Fooyin::FileOps {
+using CopyProgress = std::function<void(qint64 bytes)>;
+using CopyCancel   = std::function<bool()>;
+
+/*!
+ * Copies @p source to @p destination, which must not already exist.
+ *
+ * On Linux the copy is a reflink where the filesystem supports it, otherwise it's done
+ * in the kernel with copy_file_range. Anything else falls back to a buffered copy.
+ * The data is written to a temporary file next to @p destination and renamed once
+ * complete, so an interrupted copy never leaves a partial file behind.
+ *
+ * @p progress is called with the number of bytes copied since the previous call.
+ * @returns false if the copy failed or @p cancelled returned true.
+ */
+bool fastCopy(const QString& source, const QString& destination, const CopyProgress& progress,
+              const CopyCancel& cancelled);
+
+/*!
+ * Renames @p source to @p destination, which must not already exist.
+ *
+ * Unlike QFile::rename this never falls back to copying, so it fails if the two are on
+ * different filesystems.
+ */
+bool renameFile(const QString& source, const QString& destination);
+} // namespace Fooyin::FileOps
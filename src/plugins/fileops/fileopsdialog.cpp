@@ -38,6 +38,7 @@
 #include <QHeaderView>
 #include <QLabel>
 #include <QLineEdit>
+#include <QLocale>
 #include <QMessageBox>
 #include <QPushButton>
 #include <QRadioButton>
@@ -77,6 +78,7 @@ public:
     void simulateOp() const;
     void toggleRun();
     void modelUpdated();
+    void updateProgress(qint64 bytesProcessed, qint64 bytesTotal, qint64 bytesPerSecond);
 
     void browseDestination() const;
     std::vector<FileOpPreset>::iterator findPreset(const QString& name);
@@ -106,6 +108,7 @@ public:
     QPushButton* m_runButton{nullptr};
 
     std::vector<FileOpPreset> m_presets;
+    QString m_progress;
     bool m_loading{false};
     bool m_running{false};
 };
@@ -221,6 +224,7 @@ void FileOpsDialogPrivate::setup()
 
     QObject::connect(m_model, &FileOpsModel::simulated, this, &FileOpsDialogPrivate::modelUpdated);
     QObject::connect(m_model, &QAbstractItemModel::rowsRemoved, this, &FileOpsDialogPrivate::modelUpdated);
+    QObject::connect(m_model, &FileOpsModel::progressChanged, this, &FileOpsDialogPrivate::updateProgress);
 
     changeOperation(m_operation);
     loadPresets();
@@ -437,6 +441,7 @@ void FileOpsDialogPrivate::toggleRun()
     }
     else {
         m_runButton->setText(tr("&Abort"));
+        m_progress.clear();
         m_model->run();
     }
 
@@ -458,11 +463,24 @@ void FileOpsDialogPrivate::modelUpdated()
         m_runButton->setEnabled(false);
     }
     else {
-        m_status->setText(FileOpsDialog::tr("Pending operations") + u": %1"_s.arg(opCount));
+        QString status = FileOpsDialog::tr("Pending operations") + u": %1"_s.arg(opCount);
+        if(m_running && !m_progress.isEmpty()) {
+            status += u" – "_s + m_progress;
+        }
+        m_status->setText(status);
         m_runButton->setEnabled(true);
     }
 }
 
+void FileOpsDialogPrivate::updateProgress(qint64 bytesProcessed, qint64 bytesTotal, qint64 bytesPerSecond)
+{
+    const QLocale locale;
+    m_progress = FileOpsDialog::tr("%1 of %2 (%3/s)")
+                     .arg(locale.formattedDataSize(bytesProcessed), locale.formattedDataSize(bytesTotal),
+                          locale.formattedDataSize(bytesPerSecond));
+    modelUpdated();
+}
+
 void FileOpsDialogPrivate::browseDestination() const
 {
     const QString path = !m_destination->text().isEmpty() ? m_destination->text() : QDir::homePath();
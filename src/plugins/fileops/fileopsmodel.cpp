@@ -32,6 +32,7 @@ FileOpsModel::FileOpsModel(MusicLibrary* library, TrackList tracks, SettingsMana
 
     QObject::connect(&m_worker, &FileOpsWorker::simulated, this, &FileOpsModel::populate);
     QObject::connect(&m_worker, &FileOpsWorker::operationFinished, this, &FileOpsModel::operationFinished);
+    QObject::connect(&m_worker, &FileOpsWorker::progressChanged, this, &FileOpsModel::progressChanged);
 
     m_workerThread.start();
 }
@@ -158,10 +159,20 @@ void FileOpsModel::populate(const FileOperations& operations)
     emit simulated();
 }
 
-void FileOpsModel::operationFinished(const FileOpsItem& /*operation*/)
+void FileOpsModel::operationFinished(const FileOpsItem& operation)
 {
-    beginRemoveRows({}, 0, 0);
-    m_operations.pop_front();
+    // File operations run in parallel, so may not finish in order
+    const auto opIt = std::ranges::find_if(m_operations, [&operation](const FileOpsItem& item) {
+        return item.op == operation.op && item.source == operation.source && item.destination == operation.destination;
+    });
+    if(opIt == m_operations.cend()) {
+        return;
+    }
+
+    const auto row = static_cast<int>(std::distance(m_operations.begin(), opIt));
+
+    beginRemoveRows({}, row, row);
+    m_operations.erase(opIt);
     endRemoveRows();
 }
 
@@ -54,6 +54,7 @@ public:
 signals:
     void simulated();
     void finished();
+    void progressChanged(qint64 bytesProcessed, qint64 bytesTotal, qint64 bytesPerSecond);
 
 private:
     void populate(const FileOperations& operations);
@@ -19,6 +19,7 @@
 
 #include "fileopsworker.h"
 
+#include "filecopy.h"
 #include "fileopsregistry.h"
 
 #include <core/internalcoresettings.h>
@@ -30,11 +31,60 @@
 
 #include <QLoggingCategory>
 #include <QRegularExpression>
+#include <QtConcurrentMap>
+
+#include <numeric>
+#include <unordered_map>
 
 Q_LOGGING_CATEGORY(FILEOPS, "fy.fileops")
 
 using namespace Qt::StringLiterals;
 
+constexpr auto ProgressInterval = 250;
+
+namespace {
+// Groups operations which share a path, e.g. a rename whose destination is another's source,
+// so each group can be run in its original order while separate groups run in parallel
+std::vector<std::vector<size_t>> dependentGroups(const Fooyin::FileOps::FileOperations& operations)
+{
+    std::vector<size_t> parents(operations.size());
+    std::iota(parents.begin(), parents.end(), 0);
+
+    const auto findRoot = [&parents](size_t index) {
+        while(parents.at(index) != index) {
+            parents[index] = parents.at(parents.at(index));
+            index          = parents.at(index);
+        }
+        return index;
+    };
+
+    std::unordered_map<QString, size_t> pathUsers;
+
+    for(size_t i{0}; i < operations.size(); ++i) {
+        const auto& item = operations.at(i);
+        for(const QString& path : {item.source, item.destination}) {
+            const auto [it, inserted] = pathUsers.try_emplace(path, i);
+            if(!inserted) {
+                parents[findRoot(i)] = findRoot(it->second);
+            }
+        }
+    }
+
+    std::vector<std::vector<size_t>> groups;
+    std::unordered_map<size_t, size_t> rootGroups;
+
+    for(size_t i{0}; i < operations.size(); ++i) {
+        const auto [it, inserted] = rootGroups.try_emplace(findRoot(i), groups.size());
+        if(inserted) {
+            groups.emplace_back();
+        }
+        groups.at(it->second).push_back(i);
+    }
+
+    return groups;
+}
+} // namespace
+
 namespace Fooyin::FileOps {
 FileOpsWorker::FileOpsWorker(MusicLibrary* library, TrackList tracks, SettingsManager* settings, QObject* parent)
     : Worker{parent}
@@ -43,6 +93,9 @@ FileOpsWorker::FileOpsWorker(MusicLibrary* library, TrackList tracks, SettingsMa
     , m_scriptParser{new FileOpsRegistry()}
     , m_tracks{std::move(tracks)}
     , m_isMonitoring{settings->value<Settings::Core::Internal::MonitorLibraries>()}
+    , m_bytesTotal{0}
+    , m_bytesProcessed{0}
+    , m_lastProgress{0}
 { }
 
 void FileOpsWorker::simulate(const FileOpPreset& preset)
@@ -92,43 +145,63 @@ void FileOpsWorker::run()
         m_settings->set<Settings::Core::Internal::MonitorLibraries>(false);
     }
 
-    while(!m_operations.empty()) {
-        if(!mayRun()) {
-            return;
-        }
-
-        const FileOpsItem& item = m_operations.front();
+    // Directories are created before any files are moved into them, and only removed once they've been emptied.
+    // The file operations in between run in parallel, other than those sharing a path.
+    FileOperations dirsToCreate;
+    FileOperations fileOperations;
+    FileOperations dirsToRemove;
 
+    for(const FileOpsItem& item : m_operations) {
         switch(item.op) {
-            case(Operation::Create): {
-                if(!QDir{}.mkpath(item.destination)) {
-                    qCWarning(FILEOPS) << "Failed to create directory" << item.destination;
-                }
+            case(Operation::Create):
+                dirsToCreate.push_back(item);
                 break;
-            }
-            case(Operation::Remove): {
-                if(!QDir{}.rmdir(item.source)) {
-                    qCWarning(FILEOPS) << "Failed to remove directory" << item.destination;
-                }
+            case(Operation::Remove):
+                dirsToRemove.push_back(item);
                 break;
-            }
             case(Operation::Rename):
-            case(Operation::Move): {
-                renameFile(item);
-                break;
-            }
-            case(Operation::Copy): {
-                copyFile(item);
+            case(Operation::Move):
+            case(Operation::Copy):
+                fileOperations.push_back(item);
                 break;
-            }
         }
+    }
 
+    startProgress(fileOperations);
+
+    while(!dirsToCreate.empty() && mayRun()) {
+        const FileOpsItem& item = dirsToCreate.front();
+        if(!QDir{}.mkpath(item.destination)) {
+            qCWarning(FILEOPS) << "Failed to create directory" << item.destination;
+        }
         emit operationFinished(item);
-        m_operations.pop_front();
+        dirsToCreate.pop_front();
     }
 
+    if(mayRun()) {
+        runFileOperations(fileOperations);
+    }
+
+    while(!dirsToRemove.empty() && mayRun()) {
+        const FileOpsItem& item = dirsToRemove.front();
+        if(!QDir{}.rmdir(item.source)) {
+            qCWarning(FILEOPS) << "Failed to remove directory" << item.destination;
+        }
+        emit operationFinished(item);
+        dirsToRemove.pop_front();
+    }
+
+    // Keep anything left after aborting so it can be run again
+    m_operations = std::move(dirsToCreate);
+    m_operations.insert(m_operations.end(), fileOperations.cbegin(), fileOperations.cend());
+    m_operations.insert(m_operations.end(), dirsToRemove.cbegin(), dirsToRemove.cend());
+
+    reportProgress(true);
+
+    // Tracks which were moved before aborting still need their new paths stored
     if(!m_tracksToUpdate.empty()) {
         m_library->updateTrackMetadata(m_tracksToUpdate);
+        m_tracksToUpdate.clear();
     }
 
     setState(Idle);
@@ -296,65 +369,198 @@ void FileOpsWorker::simulateRename()
     }
 }
 
-void FileOpsWorker::renameFile(const FileOpsItem& item)
+void FileOpsWorker::runFileOperations(FileOperations& operations)
 {
-    QFile file{item.source};
-
-    if(!file.exists()) {
-        qCWarning(FILEOPS) << "File doesn't exist:" << item.source;
+    if(operations.empty()) {
         return;
     }
 
-    if(!file.rename(item.destination)) {
-        qCWarning(FILEOPS) << "Failed to move file from" << item.source << "to" << item.destination;
-        return;
-    }
+    std::vector<FileResult> results(operations.size(), FileResult::Cancelled);
 
-    if(m_trackPaths.contains(item.source)) {
-        auto tracks = m_trackPaths.equal_range(item.source);
-        for(auto it = tracks.first; it != tracks.second; ++it) {
-            auto& track = it->second;
+    auto groups = dependentGroups(operations);
 
-            if(track.hasCue() && m_filesToMove.contains(track.cuePath())) {
-                const QString cuePath = track.cuePath();
+    QtConcurrent::blockingMap(&m_filePool, groups, [this, &operations, &results](const std::vector<size_t>& group) {
+        for(const size_t index : group) {
+            if(!mayRun()) {
+                return;
+            }
 
-                const QDir srcDir{track.path()};
-                const QString relativeCuePath = srcDir.relativeFilePath(cuePath);
+            const FileOpsItem& item = operations.at(index);
 
-                track.setFilePath(item.destination);
-                const QString cueDest = QDir::cleanPath(track.path() + "/"_L1 + relativeCuePath);
-                track.setCuePath(cueDest);
-            }
-            else {
-                track.setFilePath(item.destination);
+            std::vector<IoScheduler::Lease> leases;
+            if(!acquireLeases(item, leases)) {
+                return;
             }
 
-            if(const auto library = m_library->libraryForPath(item.destination)) {
-                if(track.libraryId() != library->id) {
-                    track.setLibraryId(library->id);
-                }
-            }
-            else {
-                track.setLibraryId(-1);
+            const bool success = item.op == Operation::Copy ? copyFile(item) : moveFile(item);
+            if(!success && !mayRun()) {
+                return;
             }
 
-            m_tracksToUpdate.push_back(track);
+            results[index] = success ? FileResult::Done : FileResult::Failed;
+            emit operationFinished(item);
+        }
+    });
+
+    FileOperations cancelled;
+
+    for(size_t i{0}; i < operations.size(); ++i) {
+        const FileOpsItem& item = operations.at(i);
+        if(results.at(i) == FileResult::Cancelled) {
+            cancelled.push_back(item);
+        }
+        else if(results.at(i) == FileResult::Done && item.op != Operation::Copy) {
+            updateMovedTracks(item);
         }
     }
+
+    operations = std::move(cancelled);
 }
 
-void FileOpsWorker::copyFile(const FileOpsItem& item)
+bool FileOpsWorker::acquireLeases(const FileOpsItem& item, std::vector<IoScheduler::Lease>& leases) const
+{
+    auto* scheduler = IoScheduler::instance();
+
+    QStringList mounts{scheduler->mountPoint(item.destination)};
+    QStringList paths{item.destination};
+
+    const QString sourceMount = scheduler->mountPoint(item.source);
+    if(sourceMount != mounts.front()) {
+        // Always taken in the same order, so operations crossing the same two devices can't deadlock
+        const bool sourceFirst = sourceMount < mounts.front();
+        mounts.insert(sourceFirst ? 0 : 1, sourceMount);
+        paths.insert(sourceFirst ? 0 : 1, item.source);
+    }
+
+    const auto cancelled = [this]() {
+        return !mayRun();
+    };
+
+    for(const QString& path : std::as_const(paths)) {
+        auto lease = scheduler->acquire(path, IoScheduler::Priority::Background, cancelled);
+        if(!lease.isValid()) {
+            return false;
+        }
+        leases.push_back(std::move(lease));
+    }
+
+    return true;
+}
+
+bool FileOpsWorker::moveFile(const FileOpsItem& item)
 {
     QFile file{item.source};
 
     if(!file.exists()) {
         qCWarning(FILEOPS) << "File doesn't exist:" << item.source;
-        return;
+        return false;
+    }
+
+    const qint64 size = file.size();
+    if(renameFile(item.source, item.destination)) {
+        addProgress(size);
+        return true;
+    }
+
+    // Most likely across filesystems (EXDEV), so copy and then remove the source
+    if(!copyFile(item)) {
+        return false;
+    }
+
+    if(!file.remove()) {
+        qCWarning(FILEOPS) << "Failed to remove" << item.source << "after copying to" << item.destination;
+    }
+
+    return true;
+}
+
+bool FileOpsWorker::copyFile(const FileOpsItem& item)
+{
+    if(!QFile::exists(item.source)) {
+        qCWarning(FILEOPS) << "File doesn't exist:" << item.source;
+        return false;
     }
 
-    if(!file.copy(item.destination)) {
+    const bool copied = fastCopy(
+        item.source, item.destination, [this](qint64 bytes) { addProgress(bytes); }, [this]() { return !mayRun(); });
+
+    if(!copied && mayRun()) {
         qCWarning(FILEOPS) << "Failed to copy file from" << item.source << "to" << item.destination;
     }
+
+    return copied;
+}
+
+void FileOpsWorker::updateMovedTracks(const FileOpsItem& item)
+{
+    if(!m_trackPaths.contains(item.source)) {
+        return;
+    }
+
+    auto tracks = m_trackPaths.equal_range(item.source);
+    for(auto it = tracks.first; it != tracks.second; ++it) {
+        auto& track = it->second;
+
+        if(track.hasCue() && m_filesToMove.contains(track.cuePath())) {
+            const QString cuePath = track.cuePath();
+
+            const QDir srcDir{track.path()};
+            const QString relativeCuePath = srcDir.relativeFilePath(cuePath);
+
+            track.setFilePath(item.destination);
+            const QString cueDest = QDir::cleanPath(track.path() + "/"_L1 + relativeCuePath);
+            track.setCuePath(cueDest);
+        }
+        else {
+            track.setFilePath(item.destination);
+        }
+
+        if(const auto library = m_library->libraryForPath(item.destination)) {
+            if(track.libraryId() != library->id) {
+                track.setLibraryId(library->id);
+            }
+        }
+        else {
+            track.setLibraryId(-1);
+        }
+
+        m_tracksToUpdate.push_back(track);
+    }
+}
+
+void FileOpsWorker::startProgress(const FileOperations& operations)
+{
+    m_bytesTotal = 0;
+    for(const FileOpsItem& item : operations) {
+        m_bytesTotal += QFileInfo{item.source}.size();
+    }
+
+    m_bytesProcessed.store(0, std::memory_order_relaxed);
+    m_lastProgress.store(0, std::memory_order_relaxed);
+    m_timer.start();
+}
+
+void FileOpsWorker::addProgress(qint64 bytes)
+{
+    m_bytesProcessed.fetch_add(bytes, std::memory_order_relaxed);
+    reportProgress(false);
+}
+
+void FileOpsWorker::reportProgress(bool force)
+{
+    const qint64 elapsed = m_timer.elapsed();
+
+    if(!force) {
+        qint64 last = m_lastProgress.load(std::memory_order_relaxed);
+        if(elapsed - last < ProgressInterval || !m_lastProgress.compare_exchange_strong(last, elapsed)) {
+            return;
+        }
+    }
+
+    const qint64 processed = m_bytesProcessed.load(std::memory_order_relaxed);
+    const qint64 rate      = elapsed > 0 ? processed * 1000 / elapsed : 0;
+
+    emit progressChanged(processed, m_bytesTotal, rate);
 }
 
 void FileOpsWorker::createDir(const QDir& dir)
@@ -22,10 +22,14 @@
 #include "fileopsdefs.h"
 
 #include <core/scripting/scriptparser.h>
+#include <utils/ioscheduler.h>
 #include <utils/worker.h>
 
 #include <QDir>
+#include <QElapsedTimer>
+#include <QThreadPool>
 
+#include <atomic>
 #include <deque>
 #include <set>
 
@@ -66,14 +70,29 @@ public:
 signals:
     void simulated(const Fooyin::FileOps::FileOperations& operations);
     void operationFinished(const Fooyin::FileOps::FileOpsItem& operation);
+    void progressChanged(qint64 bytesProcessed, qint64 bytesTotal, qint64 bytesPerSecond);
 
 private:
+    enum class FileResult : uint8_t
+    {
+        Done = 0,
+        Failed,
+        Cancelled,
+    };
+
     void simulateMove();
     void simulateCopy();
     void simulateRename();
 
-    void renameFile(const FileOpsItem& item);
-    static void copyFile(const FileOpsItem& item);
+    void runFileOperations(FileOperations& operations);
+    bool acquireLeases(const FileOpsItem& item, std::vector<IoScheduler::Lease>& leases) const;
+    bool moveFile(const FileOpsItem& item);
+    bool copyFile(const FileOpsItem& item);
+    void updateMovedTracks(const FileOpsItem& item);
+
+    void startProgress(const FileOperations& operations);
+    void addProgress(qint64 bytes);
+    void reportProgress(bool force);
 
     void createDir(const QDir& dir);
     void removeDir(const QDir& dir);
@@ -98,6 +117,12 @@ private:
     std::set<QString> m_dirsToCreate;
     std::set<QString> m_dirsToRemove;
     TrackList m_tracksToUpdate;
+
+    QThreadPool m_filePool;
+    QElapsedTimer m_timer;
+    qint64 m_bytesTotal;
+    std::atomic<qint64> m_bytesProcessed;
+    std::atomic<qint64> m_lastProgress;
 };
 } // namespace FileOps
 } // namespace Fooyin
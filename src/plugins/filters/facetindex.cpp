@@ -0,0 +1,122 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "facetindex.h"
+
+#include <algorithm>
+
+namespace {
+constexpr int WordBits = 64;
+} // namespace
+
+namespace Fooyin::Filters {
+TrackIdSet::TrackIdSet(const TrackList& tracks)
+{
+    for(const Track& track : tracks) {
+        insert(track.id());
+    }
+}
+
+void TrackIdSet::insert(int id)
+{
+    if(id < 0) {
+        return;
+    }
+
+    const auto word = static_cast<size_t>(id / WordBits);
+    if(word >= m_words.size()) {
+        m_words.resize(word + 1, 0);
+    }
+    m_words[word] |= uint64_t{1} << (id % WordBits);
+}
+
+bool TrackIdSet::contains(int id) const
+{
+    if(id < 0) {
+        return false;
+    }
+
+    const auto word = static_cast<size_t>(id / WordBits);
+    return word < m_words.size() && (m_words[word] & (uint64_t{1} << (id % WordBits))) != 0;
+}
+
+void TrackIdSet::intersect(const TrackIdSet& other)
+{
+    m_words.resize(std::min(m_words.size(), other.m_words.size()));
+
+    for(size_t i{0}; i < m_words.size(); ++i) {
+        m_words[i] &= other.m_words[i];
+    }
+}
+
+TrackList TrackIdSet::filter(const TrackList& tracks) const
+{
+    TrackList result;
+    std::ranges::copy_if(tracks, std::back_inserter(result), [this](const Track& track) { return contains(track.id()); });
+    return result;
+}
+
+bool FacetIndex::isValidFor(const QString& columns, bool useVarious) const
+{
+    return m_isValid && m_columns == columns && m_useVarious == useVarious;
+}
+
+void FacetIndex::reset(const QString& columns, bool useVarious)
+{
+    m_columns    = columns;
+    m_useVarious = useVarious;
+    m_isValid    = true;
+
+    m_facets.clear();
+    m_facetIds.clear();
+    m_trackFacets.clear();
+}
+
+const FacetIndex::Facet& FacetIndex::facet(int facetId) const
+{
+    return m_facets.at(facetId);
+}
+
+const std::vector<int>* FacetIndex::trackFacets(int trackId) const
+{
+    const auto it = m_trackFacets.find(trackId);
+    return it != m_trackFacets.cend() ? &it->second : nullptr;
+}
+
+int FacetIndex::addFacet(const Md5Hash& key, const QStringList& columns)
+{
+    const auto [it, inserted] = m_facetIds.try_emplace(key, static_cast<int>(m_facets.size()));
+    if(inserted) {
+        m_facets.push_back({key, columns});
+    }
+    return it->second;
+}
+
+void FacetIndex::setTrackFacets(int trackId, std::vector<int> facetIds)
+{
+    m_trackFacets[trackId] = std::move(facetIds);
+}
+
+void FacetIndex::removeTracks(const TrackList& tracks)
+{
+    for(const Track& track : tracks) {
+        m_trackFacets.erase(track.id());
+    }
+}
+} // namespace Fooyin::Filters
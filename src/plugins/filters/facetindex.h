@@ -0,0 +1,89 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <core/track.h>
+#include <utils/crypto.h>
+
+#include <QStringList>
+
+#include <map>
+#include <unordered_map>
+
+namespace Fooyin::Filters {
+/*!
+ * A dense bitset of track ids, used to intersect filter selections without hashing each id.
+ */
+class TrackIdSet
+{
+public:
+    TrackIdSet() = default;
+    explicit TrackIdSet(const TrackList& tracks);
+
+    void insert(int id);
+    [[nodiscard]] bool contains(int id) const;
+    void intersect(const TrackIdSet& other);
+
+    /** Returns the tracks in @p tracks which are in this set, preserving their order. */
+    [[nodiscard]] TrackList filter(const TrackList& tracks) const;
+
+private:
+    std::vector<uint64_t> m_words;
+};
+
+/*!
+ * Records which filter items (facets) each track belongs to for a set of columns.
+ * Regrouping a subset of the library, as happens on every upstream selection change,
+ * can then skip script evaluation and key hashing for tracks which have been seen before.
+ * Entries must be invalidated whenever a track's metadata changes.
+ *
+ * Downstream filters are still repopulated from the subset, just with a lookup per track.
+ * Facets aren't kept as bitsets of track ids to intersect with the subset, as each item
+ * needs its tracks in order, which would take the same pass over the subset again.
+ */
+class FacetIndex
+{
+public:
+    struct Facet
+    {
+        Md5Hash key;
+        QStringList columns;
+    };
+
+    [[nodiscard]] bool isValidFor(const QString& columns, bool useVarious) const;
+    void reset(const QString& columns, bool useVarious);
+
+    [[nodiscard]] const Facet& facet(int facetId) const;
+    [[nodiscard]] const std::vector<int>* trackFacets(int trackId) const;
+
+    int addFacet(const Md5Hash& key, const QStringList& columns);
+    void setTrackFacets(int trackId, std::vector<int> facetIds);
+    void removeTracks(const TrackList& tracks);
+
+private:
+    QString m_columns;
+    bool m_useVarious{false};
+    bool m_isValid{false};
+
+    std::vector<Facet> m_facets;
+    std::map<Md5Hash, int> m_facetIds;
+    std::unordered_map<int, std::vector<int>> m_trackFacets;
+};
+} // namespace Fooyin::Filters
@@ -19,6 +19,7 @@
 
 #include "filtercontroller.h"
 
+#include "facetindex.h"
 #include "filtercolumnregistry.h"
 #include "filtermanager.h"
 #include "filterwidget.h"
@@ -44,20 +45,7 @@
 namespace {
 Fooyin::TrackList trackIntersection(const Fooyin::TrackList& v1, const Fooyin::TrackList& v2)
 {
-    Fooyin::TrackList result;
-    std::unordered_set<int> ids;
-
-    for(const auto& track : v1) {
-        ids.emplace(track.id());
-    }
-
-    for(const auto& track : v2) {
-        if(ids.contains(track.id())) {
-            result.push_back(track);
-        }
-    }
-
-    return result;
+    return Fooyin::Filters::TrackIdSet{v1}.filter(v2);
 }
 } // namespace
 
@@ -101,7 +89,7 @@ public:
     LibraryManager* m_libraryManager;
     TrackSelectionController* m_trackSelection;
     EditableLayout* m_editableLayout;
-    CoverProvider m_coverProvider;
+    std::shared_ptr<AudioLoader> m_audioLoader;
     SettingsManager* m_settings;
 
     FilterManager* m_manager;
@@ -124,7 +112,7 @@ FilterControllerPrivate::FilterControllerPrivate(FilterController* self, const C
     , m_libraryManager{core.libraryManager}
     , m_trackSelection{trackSelection}
     , m_editableLayout{editableLayout}
-    , m_coverProvider{core.audioLoader, settings}
+    , m_audioLoader{core.audioLoader}
     , m_settings{settings}
     , m_manager{new FilterManager(m_self, m_editableLayout, m_self)}
     , m_columnRegistry{new FilterColumnRegistry(settings, m_self)}
@@ -287,6 +275,7 @@ void FilterControllerPrivate::resetFiltersAfterFilter(FilterWidget* filter)
 
     const int resetIndex = filter->index() - 1;
 
+    // Downstream filters regroup the new subset, using their facet index for tracks already grouped
     for(const auto& filterWidget : m_groups.at(group).filters) {
         if(filterWidget->index() > resetIndex) {
             filterWidget->reset(tracks(group));
@@ -305,14 +294,27 @@ void FilterControllerPrivate::getFilteredTracks(const Id& groupId)
 
     auto activeFilters = group.filters | std::views::filter([](FilterWidget* widget) { return widget->isActive(); });
 
+    TrackList firstTracks;
+    TrackIdSet selectedIds;
+    int activeCount{0};
+
     for(auto& filter : activeFilters) {
-        if(group.filteredTracks.empty()) {
-            std::ranges::copy(filter->filteredTracks(), std::back_inserter(group.filteredTracks));
+        const TrackList filtered = filter->filteredTracks();
+        if(activeCount++ == 0) {
+            firstTracks = filtered;
+            selectedIds = TrackIdSet{filtered};
         }
         else {
-            group.filteredTracks = trackIntersection(filter->filteredTracks(), group.filteredTracks);
+            selectedIds.intersect(TrackIdSet{filtered});
         }
     }
+
+    if(activeCount == 1) {
+        group.filteredTracks = firstTracks;
+    }
+    else if(activeCount > 1) {
+        group.filteredTracks = selectedIds.filter(firstTracks);
+    }
 }
 
 void FilterControllerPrivate::clearActiveFilters(const Id& group, int index)
@@ -505,12 +507,20 @@ FilterController::FilterController(const CorePluginContext& core, TrackSelection
     : QObject{parent}
     , p{std::make_unique<FilterControllerPrivate>(this, core, trackSelection, editableLayout, settings)}
 {
-    QObject::connect(p->m_library, &MusicLibrary::tracksAdded, this,
-                     [this](const TrackList& tracks) { p->handleTracksAddedUpdated(tracks); });
-    QObject::connect(p->m_library, &MusicLibrary::tracksScanned, this,
-                     [this](int /*id*/, const TrackList& tracks) { p->handleTracksAddedUpdated(tracks); });
-    QObject::connect(p->m_library, &MusicLibrary::tracksMetadataChanged, this,
-                     [this](const TrackList& tracks) { p->handleTracksAddedUpdated(tracks, true); });
+    // Filters only receive the tracks which pass their upstream selection, so drop the cached
+    // groupings of every changed track before they are handled
+    QObject::connect(p->m_library, &MusicLibrary::tracksAdded, this, [this](const TrackList& tracks) {
+        emit tracksInvalidated(tracks);
+        p->handleTracksAddedUpdated(tracks);
+    });
+    QObject::connect(p->m_library, &MusicLibrary::tracksScanned, this, [this](int /*id*/, const TrackList& tracks) {
+        emit tracksInvalidated(tracks);
+        p->handleTracksAddedUpdated(tracks);
+    });
+    QObject::connect(p->m_library, &MusicLibrary::tracksMetadataChanged, this, [this](const TrackList& tracks) {
+        emit tracksInvalidated(tracks);
+        p->handleTracksAddedUpdated(tracks, true);
+    });
     QObject::connect(p->m_library, &MusicLibrary::tracksUpdated, this, &FilterController::tracksUpdated);
     QObject::connect(p->m_library, &MusicLibrary::tracksDeleted, this, &FilterController::tracksRemoved);
     QObject::connect(p->m_library, &MusicLibrary::tracksLoaded, this, [this]() { p->resetAll(); });
@@ -531,7 +541,10 @@ QString FilterController::defaultPlaylistName()
 
 FilterWidget* FilterController::createFilter()
 {
-    auto* widget = new FilterWidget(p->m_columnRegistry, p->m_libraryManager, &p->m_coverProvider, p->m_settings);
+    // Each filter has its own provider so scrolling one only cancels its own cover requests
+    auto* coverProvider = new CoverProvider(p->m_audioLoader, p->m_settings);
+    auto* widget        = new FilterWidget(p->m_columnRegistry, p->m_libraryManager, coverProvider, p->m_settings);
+    coverProvider->setParent(widget);
 
     auto& group = p->m_groups[p->m_defaultId];
     group.id    = p->m_defaultId;
@@ -553,6 +566,7 @@ FilterWidget* FilterController::createFilter()
     QObject::connect(this, &FilterController::tracksChanged, widget, &FilterWidget::tracksChanged);
     QObject::connect(this, &FilterController::tracksUpdated, widget, &FilterWidget::tracksUpdated);
     QObject::connect(this, &FilterController::tracksRemoved, widget, &FilterWidget::tracksRemoved);
+    QObject::connect(this, &FilterController::tracksInvalidated, widget, &FilterWidget::tracksInvalidated);
 
     widget->reset(p->tracks(p->m_defaultId));
     p->updateFilterPlaylistActions(widget);
@@ -76,6 +76,7 @@ signals:
     void tracksRemoved(const Fooyin::TrackList& tracks);
     void tracksChanged(const Fooyin::TrackList& tracks);
     void tracksUpdated(const Fooyin::TrackList& tracks);
+    void tracksInvalidated(const Fooyin::TrackList& tracks);
 
 private:
     std::unique_ptr<FilterControllerPrivate> p;
@@ -22,6 +22,9 @@
 #include <core/library/tracksort.h>
 #include <core/track.h>
 
+#include <unordered_map>
+#include <unordered_set>
+
 using namespace Qt::StringLiterals;
 
 namespace Fooyin::Filters {
@@ -104,6 +107,19 @@ void FilterItem::removeTrack(const Track& track)
     std::erase_if(m_tracks, [track](const Track& child) { return child.id() == track.id(); });
 }
 
+void FilterItem::removeTracks(const TrackList& tracks)
+{
+    if(m_tracks.empty()) {
+        return;
+    }
+
+    std::unordered_set<int> ids;
+    for(const Track& track : tracks) {
+        ids.emplace(track.id());
+    }
+    std::erase_if(m_tracks, [&ids](const Track& child) { return ids.contains(child.id()); });
+}
+
 void FilterItem::replaceTrack(const Track& track)
 {
     if(m_tracks.empty()) {
@@ -112,6 +128,23 @@ void FilterItem::replaceTrack(const Track& track)
     std::ranges::replace_if(m_tracks, [track](const Track& child) { return child.id() == track.id(); }, track);
 }
 
+void FilterItem::replaceTracks(const TrackList& tracks)
+{
+    if(m_tracks.empty()) {
+        return;
+    }
+
+    std::unordered_map<int, Track> updated;
+    for(const Track& track : tracks) {
+        updated.emplace(track.id(), track);
+    }
+    for(Track& child : m_tracks) {
+        if(const auto it = updated.find(child.id()); it != updated.end()) {
+            child = it->second;
+        }
+    }
+}
+
 void FilterItem::sortTracks()
 {
     m_tracks = TrackSorter::sortTracks(m_tracks);
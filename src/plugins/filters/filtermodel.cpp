@@ -43,6 +43,7 @@
 #include <QThread>
 
 #include <set>
+#include <unordered_map>
 #include <utility>
 
 namespace {
@@ -116,7 +117,11 @@ public:
     void updateSummary();
     int uniqueValues(int column) const;
 
+    using NodeTrackMap = std::unordered_map<Md5Hash, TrackList>;
+
     void batchFinished(PendingTreeData data);
+    void updateTracks(const PendingTreeData& data);
+    void removeFromNodes(const NodeTrackMap& nodeTracks);
     void populateModel(PendingTreeData& data);
 
     void coverUpdated(const Track& track);
@@ -146,8 +151,6 @@ public:
 
     bool m_showSummary{true};
     int m_rowHeight{0};
-
-    TrackList m_tracksPendingRemoval;
 };
 
 FilterModelPrivate::FilterModelPrivate(FilterModel* self, LibraryManager* libraryManager, CoverProvider* coverProvider,
@@ -238,8 +241,8 @@ void FilterModelPrivate::batchFinished(PendingTreeData data)
         beginReset();
     }
 
-    if(!m_tracksPendingRemoval.empty()) {
-        m_self->removeTracks(m_tracksPendingRemoval);
+    if(!data.updatedTracks.empty()) {
+        updateTracks(data);
     }
 
     populateModel(data);
@@ -252,6 +255,97 @@ void FilterModelPrivate::batchFinished(PendingTreeData data)
     QMetaObject::invokeMethod(m_self, &FilterModel::modelUpdated);
 }
 
+void FilterModelPrivate::updateTracks(const PendingTreeData& data)
+{
+    NodeTrackMap keptTracks;
+    NodeTrackMap removedTracks;
+
+    for(const Track& track : data.updatedTracks) {
+        const int id = track.id();
+
+        const auto keptIt = data.keptParents.find(id);
+        if(keptIt != data.keptParents.cend()) {
+            for(const auto& key : keptIt->second) {
+                keptTracks[key].push_back(track);
+            }
+            m_trackParents[id] = keptIt->second;
+        }
+        else {
+            m_trackParents.erase(id);
+        }
+
+        const auto removedIt = data.removedParents.find(id);
+        if(removedIt != data.removedParents.cend()) {
+            for(const auto& key : removedIt->second) {
+                removedTracks[key].push_back(track);
+            }
+        }
+    }
+
+    const int lastColumn = m_self->columnCount({}) - 1;
+
+    for(const auto& [key, tracks] : keptTracks) {
+        const auto nodeIt = m_nodes.find(key);
+        if(nodeIt == m_nodes.end()) {
+            continue;
+        }
+
+        FilterItem* item = &nodeIt->second;
+        item->replaceTracks(tracks);
+        item->sortTracks();
+
+        const QModelIndex index = m_self->indexOfItem(item);
+        emit m_self->dataChanged(index, index.siblingAtColumn(lastColumn));
+    }
+
+    removeFromNodes(removedTracks);
+}
+
+void FilterModelPrivate::removeFromNodes(const NodeTrackMap& nodeTracks)
+{
+    std::vector<int> rows;
+
+    for(const auto& [key, tracks] : nodeTracks) {
+        const auto nodeIt = m_nodes.find(key);
+        if(nodeIt == m_nodes.end()) {
+            continue;
+        }
+
+        FilterItem* item = &nodeIt->second;
+        item->removeTracks(tracks);
+
+        if(item->trackCount() == 0) {
+            rows.push_back(item->row());
+        }
+    }
+
+    if(rows.empty()) {
+        return;
+    }
+
+    auto* parent = m_self->rootItem();
+
+    // Remove from the bottom up in contiguous ranges so earlier rows stay valid
+    std::ranges::sort(rows, std::greater<>{});
+
+    for(auto it = rows.cbegin(); it != rows.cend();) {
+        const int last = *it;
+        int first      = last;
+        while(++it != rows.cend() && *it == first - 1) {
+            first = *it;
+        }
+
+        m_self->beginRemoveRows({}, first, last);
+        for(int row{last}; row >= first; --row) {
+            const Md5Hash key = parent->child(row)->key();
+            parent->removeChild(row);
+            m_nodes.erase(key);
+        }
+        parent->resetChildren();
+        m_self->endRemoveRows();
+    }
+}
+
 void FilterModelPrivate::populateModel(PendingTreeData& data)
 {
     std::vector<FilterItem> newItems;
@@ -270,8 +364,10 @@ void FilterModelPrivate::populateModel(PendingTreeData& data)
     auto* parent   = m_self->rootItem();
     const int row  = parent->childCount();
     const int last = row + static_cast<int>(newItems.size()) - 1;
+    // Updates often only touch existing nodes
+    const bool insertRows = !m_resetting && !newItems.empty();
 
-    if(!m_resetting) {
+    if(insertRows) {
         m_self->beginInsertRows({}, row, last);
     }
 
@@ -280,11 +376,14 @@ void FilterModelPrivate::populateModel(PendingTreeData& data)
         parent->appendChild(child);
     }
 
-    if(!m_resetting) {
+    if(insertRows) {
         m_self->endInsertRows();
     }
 
-    m_trackParents.merge(data.trackParents);
+    for(auto& [id, parents] : data.trackParents) {
+        auto& trackParents = m_trackParents[id];
+        trackParents.insert(trackParents.end(), parents.cbegin(), parents.cend());
+    }
 
     updateSummary();
 }
@@ -351,6 +450,11 @@ void FilterModel::setRowHeight(int height)
     p->dataUpdated();
 }
 
+bool FilterModel::cancelPendingCovers()
+{
+    return p->m_coverProvider->cancelPendingRequests();
+}
+
 void FilterModel::setShowSummary(bool show)
 {
     const bool prev = std::exchange(p->m_showSummary, show);
@@ -594,15 +698,19 @@ void FilterModel::updateTracks(const TrackList& tracks)
         return;
     }
 
-    p->m_tracksPendingRemoval = tracksToUpdate;
+    TrackIdNodeMap currentParents;
+    for(const Track& track : tracksToUpdate) {
+        currentParents.emplace(track.id(), p->m_trackParents.at(track.id()));
+    }
 
     p->m_populatorThread.start();
 
     QStringList columns;
     std::ranges::transform(p->m_columns, std::back_inserter(columns), [](const auto& column) { return column.field; });
 
-    QMetaObject::invokeMethod(&p->m_populator, [this, columns, tracksToUpdate] {
-        p->m_populator.run(columns, tracksToUpdate, p->m_settings->value<Settings::Core::UseVariousForCompilations>());
+    QMetaObject::invokeMethod(&p->m_populator, [this, columns, tracksToUpdate, currentParents] {
+        p->m_populator.update(columns, tracksToUpdate, currentParents,
+                              p->m_settings->value<Settings::Core::UseVariousForCompilations>());
     });
 
     addTracks(tracks);
@@ -610,54 +718,56 @@ void FilterModel::updateTracks(const TrackList& tracks)
 
 void FilterModel::refreshTracks(const TrackList& tracks)
 {
+    invalidateTracks(tracks);
+
+    FilterModelPrivate::NodeTrackMap nodeTracks;
+
     for(const Track& track : tracks) {
-        if(!p->m_trackParents.contains(track.id())) {
+        const auto parentsIt = p->m_trackParents.find(track.id());
+        if(parentsIt == p->m_trackParents.end()) {
             continue;
         }
 
-        const auto parents = p->m_trackParents.at(track.id());
-        for(const auto& parent : parents) {
-            if(p->m_nodes.contains(parent)) {
-                p->m_nodes.at(parent).replaceTrack(track);
-            }
+        for(const auto& parent : parentsIt->second) {
+            nodeTracks[parent].push_back(track);
+        }
+    }
+
+    for(const auto& [key, parentTracks] : nodeTracks) {
+        if(p->m_nodes.contains(key)) {
+            p->m_nodes.at(key).replaceTracks(parentTracks);
         }
     }
 }
 
 void FilterModel::removeTracks(const TrackList& tracks)
 {
-    std::set<FilterItem*> items;
+    invalidateTracks(tracks);
+
+    FilterModelPrivate::NodeTrackMap nodeTracks;
 
     for(const Track& track : tracks) {
-        const int id = track.id();
-        if(p->m_trackParents.contains(id)) {
-            const auto trackNodes = p->m_trackParents[id];
-            for(const auto& node : trackNodes) {
-                FilterItem* item = &p->m_nodes[node];
-                item->removeTrack(track);
-                items.emplace(item);
-            }
-            p->m_trackParents.erase(id);
+        const auto parentsIt = p->m_trackParents.find(track.id());
+        if(parentsIt == p->m_trackParents.end()) {
+            continue;
         }
-    }
 
-    auto* parent = rootItem();
-
-    for(FilterItem* item : items) {
-        if(item->trackCount() == 0) {
-            const QModelIndex parentIndex;
-            const int row = item->row();
-            beginRemoveRows(parentIndex, row, row);
-            parent->removeChild(row);
-            parent->resetChildren();
-            endRemoveRows();
-            p->m_nodes.erase(item->key());
+        for(const auto& node : parentsIt->second) {
+            nodeTracks[node].push_back(track);
         }
+        p->m_trackParents.erase(parentsIt);
     }
 
+    p->removeFromNodes(nodeTracks);
     p->updateSummary();
 }
 
+void FilterModel::invalidateTracks(const TrackList& tracks)
+{
+    // Queued behind any pending population so it applies before the tracks are next grouped
+    QMetaObject::invokeMethod(&p->m_populator, [this, tracks]() { p->m_populator.invalidateTracks(tracks); });
+}
+
 bool FilterModel::removeColumn(int column)
 {
     if(column < 0 || std::cmp_greater_equal(column, p->m_columns.size())) {
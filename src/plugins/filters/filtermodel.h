@@ -68,6 +68,7 @@ public:
     void setShowLabels(bool show);
     void setCoverType(Track::Cover type);
     void setColumnOrder(const std::vector<int>& order);
+    bool cancelPendingCovers();
 
     [[nodiscard]] Qt::ItemFlags flags(const QModelIndex& index) const override;
     [[nodiscard]] QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
@@ -90,6 +91,7 @@ public:
     void updateTracks(const TrackList& tracks);
     void refreshTracks(const TrackList& tracks);
     void removeTracks(const TrackList& tracks);
+    void invalidateTracks(const TrackList& tracks);
     bool removeColumn(int column);
 
     void reset(const FilterColumnList& columns, const TrackList& tracks);
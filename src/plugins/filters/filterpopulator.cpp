@@ -25,6 +25,8 @@
 #include <utils/crypto.h>
 #include <utils/settings/settingsmanager.h>
 
+#include <unordered_set>
+
 using namespace Qt::StringLiterals;
 
 namespace Fooyin::Filters {
@@ -48,6 +50,10 @@ void FilterPopulator::run(const QStringList& columns, const TrackList& tracks, b
         m_script = m_parser.parse(m_currentColumns);
     }
 
+    if(!m_index.isValidFor(m_currentColumns, useVarious)) {
+        m_index.reset(m_currentColumns, useVarious);
+    }
+
     const bool success = runBatch(tracks);
 
     setState(Idle);
@@ -57,23 +63,23 @@ void FilterPopulator::run(const QStringList& columns, const TrackList& tracks, b
     }
 }
 
-FilterItem* FilterPopulator::getOrInsertItem(const QStringList& columns)
+void FilterPopulator::update(const QStringList& columns, const TrackList& tracks, const TrackIdNodeMap& currentParents,
+                             bool useVarious)
 {
-    const auto key = Utils::generateMd5Hash(columns.join(QString{}));
-    if(!m_data.items.contains(key)) {
-        m_data.items.emplace(key, FilterItem{key, columns, &m_root});
-    }
-    return &m_data.items.at(key);
+    m_currentParents = currentParents;
+    run(columns, tracks, useVarious);
+    m_currentParents.clear();
 }
 
-std::vector<FilterItem*> FilterPopulator::getOrInsertItems(const QList<QStringList>& columnSet)
+void FilterPopulator::invalidateTracks(const TrackList& tracks)
 {
-    std::vector<FilterItem*> items;
-    for(const QStringList& columns : columnSet) {
-        auto* filterItem = getOrInsertItem(columns);
-        items.emplace_back(filterItem);
-    }
-    return items;
+    m_index.removeTracks(tracks);
+}
+
+FilterItem* FilterPopulator::getOrInsertItem(const Md5Hash& key, const QStringList& columns)
+{
+    auto [item, _] = m_data.items.try_emplace(key, key, columns, &m_root);
+    return &item->second;
 }
 
 void FilterPopulator::addTrackToNode(const Track& track, FilterItem* node)
@@ -84,21 +90,94 @@ void FilterPopulator::addTrackToNode(const Track& track, FilterItem* node)
 
 void FilterPopulator::iterateTrack(const Track& track)
 {
+    if(const auto* facetIds = m_index.trackFacets(track.id())) {
+        for(const int facetId : *facetIds) {
+            const auto& facet = m_index.facet(facetId);
+            addTrackToNode(track, getOrInsertItem(facet.key, facet.columns));
+        }
+        return;
+    }
+
     const QString columns = m_parser.evaluate(m_script, track);
 
+    std::vector<int> facetIds;
+
+    const auto addToItem = [this, &track, &facetIds](const QStringList& values) {
+        const auto key = Utils::generateMd5Hash(values.join(QString{}));
+        facetIds.push_back(m_index.addFacet(key, values));
+        addTrackToNode(track, getOrInsertItem(key, values));
+    };
+
     if(columns.contains(QLatin1String{Constants::UnitSeparator})) {
         const QStringList values = columns.split(QLatin1String{Constants::UnitSeparator});
-        QList<QStringList> colValues;
-        std::ranges::transform(values, std::back_inserter(colValues),
-                               [](const QString& col) { return col.split(QLatin1String{Constants::RecordSeparator}); });
-        const auto nodes = getOrInsertItems(colValues);
-        for(FilterItem* node : nodes) {
-            addTrackToNode(track, node);
+        for(const QString& value : values) {
+            addToItem(value.split(QLatin1String{Constants::RecordSeparator}));
         }
     }
     else {
-        FilterItem* node = getOrInsertItem(columns.split(QLatin1String{Constants::RecordSeparator}));
-        addTrackToNode(track, node);
+        addToItem(columns.split(QLatin1String{Constants::RecordSeparator}));
+    }
+
+    m_index.setTrackFacets(track.id(), std::move(facetIds));
+}
+
+void FilterPopulator::diffTrackParents(const TrackList& tracks)
+{
+    std::unordered_map<Md5Hash, TrackList> keptTracks;
+
+    for(const Track& track : tracks) {
+        const int id = track.id();
+
+        const auto currentIt = m_currentParents.find(id);
+        if(currentIt == m_currentParents.end()) {
+            continue;
+        }
+
+        std::unordered_set<Md5Hash> newParents;
+        const auto parentsIt = m_data.trackParents.find(id);
+        if(parentsIt != m_data.trackParents.end()) {
+            newParents.insert(parentsIt->second.cbegin(), parentsIt->second.cend());
+        }
+
+        std::vector<Md5Hash> kept;
+        std::vector<Md5Hash> removed;
+        for(const Md5Hash& key : currentIt->second) {
+            if(newParents.contains(key)) {
+                kept.push_back(key);
+                keptTracks[key].push_back(track);
+            }
+            else {
+                removed.push_back(key);
+            }
+        }
+
+        // Nodes the track stays in only need the track replacing, so don't add it again
+        if(parentsIt != m_data.trackParents.end() && !kept.empty()) {
+            const std::unordered_set<Md5Hash> keptKeys{kept.cbegin(), kept.cend()};
+            std::erase_if(parentsIt->second, [&keptKeys](const Md5Hash& key) { return keptKeys.contains(key); });
+            if(parentsIt->second.empty()) {
+                m_data.trackParents.erase(parentsIt);
+            }
+        }
+
+        m_data.updatedTracks.push_back(track);
+        if(!kept.empty()) {
+            m_data.keptParents.emplace(id, std::move(kept));
+        }
+        if(!removed.empty()) {
+            m_data.removedParents.emplace(id, std::move(removed));
+        }
+    }
+
+    for(const auto& [key, keptList] : keptTracks) {
+        auto itemIt = m_data.items.find(key);
+        if(itemIt == m_data.items.end()) {
+            continue;
+        }
+        itemIt->second.removeTracks(keptList);
+        if(itemIt->second.trackCount() == 0) {
+            m_data.items.erase(itemIt);
+        }
     }
 }
 
@@ -118,6 +197,10 @@ bool FilterPopulator::runBatch(const TrackList& tracks)
         return false;
     }
 
+    if(!m_currentParents.empty()) {
+        diffTrackParents(tracks);
+    }
+
     emit populated(m_data);
     m_data.clear();
 
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "facetindex.h"
 #include "filteritem.h"
 
 #include <core/scripting/scriptparser.h>
@@ -34,10 +35,19 @@ struct PendingTreeData
     ItemKeyMap items;
     TrackIdNodeMap trackParents;
 
+    // Only set when updating existing tracks: the nodes each track stays in or has left.
+    // Kept nodes aren't included in items/trackParents above.
+    TrackList updatedTracks;
+    TrackIdNodeMap keptParents;
+    TrackIdNodeMap removedParents;
+
     void clear()
     {
         items.clear();
         trackParents.clear();
+        updatedTracks.clear();
+        keptParents.clear();
+        removedParents.clear();
     }
 };
 
@@ -49,15 +59,19 @@ public:
     explicit FilterPopulator(LibraryManager* libraryManager, QObject* parent = nullptr);
 
     void run(const QStringList& columns, const TrackList& tracks, bool useVarious);
+    // Regroups tracks already in the model, diffing the result against their current parents
+    void update(const QStringList& columns, const TrackList& tracks, const TrackIdNodeMap& currentParents,
+                bool useVarious);
+    void invalidateTracks(const TrackList& tracks);
 
 signals:
     void populated(Fooyin::Filters::PendingTreeData data);
 
 private:
-    FilterItem* getOrInsertItem(const QStringList& columns);
-    std::vector<FilterItem*> getOrInsertItems(const QList<QStringList>& columnSet);
+    FilterItem* getOrInsertItem(const Md5Hash& key, const QStringList& columns);
     void addTrackToNode(const Track& track, FilterItem* node);
     void iterateTrack(const Track& track);
+    void diffTrackParents(const TrackList& tracks);
     bool runBatch(const TrackList& tracks);
 
     ScriptParser m_parser;
@@ -67,5 +81,7 @@ private:
 
     FilterItem m_root;
     PendingTreeData m_data;
+    TrackIdNodeMap m_currentParents;
+    FacetIndex m_index;
 };
 } // namespace Fooyin::Filters
@@ -45,6 +45,7 @@
 #include <QHeaderView>
 #include <QJsonObject>
 #include <QMenu>
+#include <QScrollBar>
 
 #include <set>
 
@@ -442,6 +443,11 @@ void FilterWidget::tracksRemoved(const TrackList& tracks)
     m_model->removeTracks(tracks);
 }
 
+void FilterWidget::tracksInvalidated(const TrackList& tracks)
+{
+    m_model->invalidateTracks(tracks);
+}
+
 void FilterWidget::contextMenuEvent(QContextMenuEvent* event)
 {
     if(m_view->selectionModel()->selectedRows().empty()) {
@@ -466,6 +472,13 @@ void FilterWidget::setupConnections()
     QObject::connect(m_resetThrottler, &SignalThrottler::triggered, this,
                      [this]() { m_model->reset(m_columns, m_tracks); });
 
+    QObject::connect(m_view->verticalScrollBar(), &QScrollBar::valueChanged, this, [this]() {
+        // Requeue covers which are still visible ahead of any which have scrolled away
+        if(m_model->cancelPendingCovers()) {
+            m_view->viewport()->update();
+        }
+    });
+
     QObject::connect(m_columnRegistry, &FilterColumnRegistry::columnChanged, this, &FilterWidget::columnChanged);
     QObject::connect(m_columnRegistry, &FilterColumnRegistry::itemRemoved, this, &FilterWidget::columnRemoved);
 
@@ -78,6 +78,7 @@ public:
     void tracksChanged(const TrackList& tracks);
     void tracksUpdated(const TrackList& tracks);
     void tracksRemoved(const TrackList& tracks);
+    void tracksInvalidated(const TrackList& tracks);
 
 signals:
     void doubleClicked();
@@ -0,0 +1,87 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ebur128analysisstage.h"
+
+#include "ebur128meter.h"
+#include "rgscannerdefs.h"
+
+#include <core/coresettings.h>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+class Ebur128Analysis : public Fooyin::TrackAnalysis
+{
+public:
+    Ebur128Analysis(const Fooyin::AudioFormat& format, bool truePeak)
+        : m_meter{format, truePeak}
+    { }
+
+    [[nodiscard]] bool isValid() const
+    {
+        return m_meter.isValid();
+    }
+
+    void process(std::span<const float> samples) override
+    {
+        m_meter.addFrames(samples);
+    }
+
+    bool finish(Fooyin::Track& track) override
+    {
+        const auto trackGain = m_meter.trackGain();
+        if(!trackGain) {
+            return false;
+        }
+
+        track.setRGTrackGain(trackGain.value());
+        track.setRGTrackPeak(m_meter.trackPeak());
+
+        return true;
+    }
+
+private:
+    Fooyin::RGScanner::Ebur128Meter m_meter;
+};
+} // namespace
+
+namespace Fooyin::RGScanner {
+QString Ebur128AnalysisStage::name() const
+{
+    return u"ReplayGain"_s;
+}
+
+std::unique_ptr<TrackAnalysis> Ebur128AnalysisStage::analyse(const Track& track, const AudioFormat& format)
+{
+    if(track.hasTrackGain() || !format.isValid()) {
+        return nullptr;
+    }
+
+    const FySettings settings;
+    const bool truePeak = settings.value(TruePeakSetting, false).toBool();
+
+    auto analysis = std::make_unique<Ebur128Analysis>(format, truePeak);
+    if(!analysis->isValid()) {
+        return nullptr;
+    }
+
+    return analysis;
+}
+} // namespace Fooyin::RGScanner
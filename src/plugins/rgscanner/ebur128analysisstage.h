@@ -0,0 +1,36 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <core/library/libraryanalyser.h>
+
+namespace Fooyin::RGScanner {
+/*!
+ * Calculates track gain and peak for new library tracks using libebur128,
+ * as part of the library's post-scan analysis.
+ * Tracks which already have a track gain are skipped.
+ */
+class Ebur128AnalysisStage : public AnalysisStage
+{
+public:
+    [[nodiscard]] QString name() const override;
+    [[nodiscard]] std::unique_ptr<TrackAnalysis> analyse(const Track& track, const AudioFormat& format) override;
+};
+} // namespace Fooyin::RGScanner
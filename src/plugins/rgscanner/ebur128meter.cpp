@@ -0,0 +1,133 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ebur128meter.h"
+
+#include <core/constants.h>
+#include <core/engine/audioconverter.h>
+
+#include <algorithm>
+#include <bit>
+
+constexpr auto ReferenceLUFS = -18;
+
+namespace Fooyin::RGScanner {
+Ebur128Meter::Ebur128Meter(const AudioFormat& format, bool truePeak)
+    : m_state{ebur128_init(static_cast<unsigned>(format.channelCount()),
+                           static_cast<unsigned long>(format.sampleRate()),
+                           EBUR128_MODE_I | (truePeak ? EBUR128_MODE_TRUE_PEAK : EBUR128_MODE_SAMPLE_PEAK))}
+    , m_format{format}
+    , m_truePeak{truePeak}
+    , m_valid{m_state != nullptr}
+{
+    m_format.setSampleFormat(inputFormat(format.sampleFormat()));
+}
+
+bool Ebur128Meter::isValid() const
+{
+    return m_valid;
+}
+
+SampleFormat Ebur128Meter::inputFormat(SampleFormat format)
+{
+    return format == SampleFormat::S32 || format == SampleFormat::F64 ? SampleFormat::F64 : SampleFormat::F32;
+}
+
+bool Ebur128Meter::addFrames(std::span<const float> samples)
+{
+    const auto channels = static_cast<size_t>(std::max(1, m_format.channelCount()));
+    return addFrames(std::bit_cast<const std::byte*>(samples.data()), SampleFormat::F32, samples.size() / channels);
+}
+
+bool Ebur128Meter::addBuffer(const AudioBuffer& buffer, std::vector<std::byte>& convertBuffer)
+{
+    const auto frames = static_cast<size_t>(buffer.frameCount());
+
+    if(buffer.format().sampleFormat() == m_format.sampleFormat()) {
+        return addFrames(buffer.constData().data(), m_format.sampleFormat(), frames);
+    }
+
+    convertBuffer.resize(static_cast<size_t>(m_format.bytesForFrames(buffer.frameCount())));
+    if(!Audio::convert(buffer.format(), buffer.constData().data(), m_format, convertBuffer.data(),
+                       buffer.frameCount())) {
+        m_valid = false;
+        return false;
+    }
+
+    return addFrames(convertBuffer.data(), m_format.sampleFormat(), frames);
+}
+
+std::optional<float> Ebur128Meter::trackGain() const
+{
+    double loudness{0.0};
+    if(!m_valid || ebur128_loudness_global(m_state.get(), &loudness) != EBUR128_SUCCESS) {
+        return {};
+    }
+    return static_cast<float>(ReferenceLUFS - loudness);
+}
+
+float Ebur128Meter::trackPeak() const
+{
+    double trackPeak{Constants::InvalidPeak};
+    if(!m_state) {
+        return static_cast<float>(trackPeak);
+    }
+
+    for(unsigned i{0}; i < m_state->channels; ++i) {
+        double channelPeak{Constants::InvalidPeak};
+        const int result = m_truePeak ? ebur128_true_peak(m_state.get(), i, &channelPeak)
+                                      : ebur128_sample_peak(m_state.get(), i, &channelPeak);
+        if(result == EBUR128_SUCCESS) {
+            trackPeak = std::max(trackPeak, channelPeak);
+        }
+    }
+
+    return static_cast<float>(trackPeak);
+}
+
+std::optional<float> Ebur128Meter::albumGain(const std::vector<Ebur128Meter>& meters)
+{
+    std::vector<ebur128_state*> states;
+    for(const auto& meter : meters) {
+        if(meter.m_valid) {
+            states.push_back(meter.m_state.get());
+        }
+    }
+
+    double loudness{0.0};
+    if(states.empty() || ebur128_loudness_global_multiple(states.data(), states.size(), &loudness) != EBUR128_SUCCESS) {
+        return {};
+    }
+    return static_cast<float>(ReferenceLUFS - loudness);
+}
+
+bool Ebur128Meter::addFrames(const std::byte* data, SampleFormat format, size_t frames)
+{
+    if(!m_valid) {
+        return false;
+    }
+
+    const int result = format == SampleFormat::F64
+                         ? ebur128_add_frames_double(m_state.get(), std::bit_cast<const double*>(data), frames)
+                         : ebur128_add_frames_float(m_state.get(), std::bit_cast<const float*>(data), frames);
+
+    m_valid = result == EBUR128_SUCCESS;
+    return m_valid;
+}
+} // namespace Fooyin::RGScanner
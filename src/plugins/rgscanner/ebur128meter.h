@@ -0,0 +1,82 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <core/engine/audiobuffer.h>
+
+#include <ebur128.h>
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Fooyin::RGScanner {
+/*!
+ * Measures the loudness and peak of a single track using libebur128.
+ * Used by both the ReplayGain scanner and the library analysis stage.
+ */
+class Ebur128Meter
+{
+public:
+    Ebur128Meter(const AudioFormat& format, bool truePeak);
+
+    [[nodiscard]] bool isValid() const;
+
+    /*!
+     * Returns the sample format frames are added in for a source decoded as @p format.
+     * Floats hold 16 and 24 bit samples exactly, so only wider sources are measured as doubles.
+     */
+    [[nodiscard]] static SampleFormat inputFormat(SampleFormat format);
+
+    /** Adds interleaved float samples. */
+    bool addFrames(std::span<const float> samples);
+    /*!
+     * Adds the frames of @p buffer, converting them to the input format first if needed.
+     * @p convertBuffer is used to hold the converted samples, so it can be reused between calls.
+     */
+    bool addBuffer(const AudioBuffer& buffer, std::vector<std::byte>& convertBuffer);
+
+    /** Returns the gain needed to reach the reference loudness, or std::nullopt if it couldn't be measured. */
+    [[nodiscard]] std::optional<float> trackGain() const;
+    [[nodiscard]] float trackPeak() const;
+
+    /** Returns the gain of @p meters measured as a single album. */
+    [[nodiscard]] static std::optional<float> albumGain(const std::vector<Ebur128Meter>& meters);
+
+private:
+    struct StateDeleter
+    {
+        void operator()(ebur128_state* state) const
+        {
+            if(state) {
+                ebur128_destroy(&state);
+            }
+        }
+    };
+
+    bool addFrames(const std::byte* data, SampleFormat format, size_t frames);
+
+    std::unique_ptr<ebur128_state, StateDeleter> m_state;
+    AudioFormat m_format;
+    bool m_truePeak;
+    bool m_valid;
+};
+} // namespace Fooyin::RGScanner
@@ -20,7 +20,7 @@
 #include "ebur128scanner.h"
 
 #include <core/constants.h>
-#include <core/engine/audioconverter.h>
+#include <utils/ioscheduler.h>
 
 #include <QFile>
 #include <QFuture>
@@ -29,10 +29,11 @@
 #include <QString>
 #include <QtConcurrentMap>
 
+#include <numeric>
+
 Q_LOGGING_CATEGORY(EBUR128, "fy.ebur128")
 
-constexpr auto ReferenceLUFS  = -18;
-constexpr auto BufferSize     = 10240;
+constexpr auto BufferSize     = 262144;
 constexpr auto SingleAlbumKey = "Album";
 
 namespace Fooyin::RGScanner {
@@ -40,9 +41,11 @@ Ebur128Scanner::Ebur128Scanner(std::shared_ptr<AudioLoader> audioLoader, QObject
     : RGWorker{parent}
     , m_audioLoader{std::move(audioLoader)}
     , m_watcher{nullptr}
-    , m_decoder{nullptr}
     , m_runningWatchers{0}
-{ }
+{
+    // Keep the threads, and the decoders they own, alive for the lifetime of the scanner
+    m_threadPool.setExpiryTimeout(-1);
+}
 
 void Ebur128Scanner::closeThread()
 {
@@ -68,6 +71,7 @@ void Ebur128Scanner::closeThread()
 void Ebur128Scanner::calculatePerTrack(const TrackList& tracks, bool truePeak)
 {
     setState(Running);
+    m_timer.start();
 
     qCDebug(EBUR128) << "Calculating RG using ebur128 for" << tracks.size() << "tracks";
 
@@ -81,17 +85,19 @@ void Ebur128Scanner::calculatePerTrack(const TrackList& tracks, bool truePeak)
         }
     });
 
-    auto future = QtConcurrent::map(m_scannedTracks, [this, truePeak](Track& track) { scanTrack(track, truePeak); });
+    auto future = QtConcurrent::map(&m_threadPool, m_scannedTracks,
+                                    [this, truePeak](Track& track) { scanTrack(track, truePeak); });
 
     m_watcher->setFuture(future);
     m_runningWatchers.fetch_add(1, std::memory_order_acquire);
 
     future.then(this, [this]() {
         if(mayRun()) {
-            qCDebug(EBUR128) << "Finished calculating RG for" << m_scannedTracks.size() << "tracks";
+            logFinished();
             emit calculationFinished(m_scannedTracks);
         }
         if(m_runningWatchers.fetch_sub(1, std::memory_order_release) <= 1) {
+            releaseConvertBuffers();
             emit finished();
         }
         setState(Idle);
@@ -101,6 +107,7 @@ void Ebur128Scanner::calculatePerTrack(const TrackList& tracks, bool truePeak)
 void Ebur128Scanner::calculateAsAlbum(const TrackList& tracks, bool truePeak)
 {
     setState(Running);
+    m_timer.start();
 
     qCDebug(EBUR128) << "Calculating RG using ebur128 for" << tracks.size() << "tracks";
 
@@ -114,7 +121,7 @@ void Ebur128Scanner::calculateAsAlbum(const TrackList& tracks, bool truePeak)
         }
     });
 
-    auto future = QtConcurrent::map(m_scannedTracks, [this, truePeak](Track& track) {
+    auto future = QtConcurrent::map(&m_threadPool, m_scannedTracks, [this, truePeak](Track& track) {
         scanTrack(track, truePeak, QString::fromLatin1(SingleAlbumKey));
     });
 
@@ -122,32 +129,28 @@ void Ebur128Scanner::calculateAsAlbum(const TrackList& tracks, bool truePeak)
     m_runningWatchers.fetch_add(1, std::memory_order_acquire);
 
     future.then(this, [this]() {
-        const auto albumState = m_albumStates.find(QString::fromLatin1(SingleAlbumKey));
-        if(albumState != m_albumStates.cend()) {
-            const auto& trackStates = albumState->second;
-            std::vector<ebur128_state*> states;
-            std::ranges::transform(trackStates, std::back_inserter(states),
-                                   [](const auto& state) { return state.get(); });
-
-            double albumGain{Constants::InvalidGain};
-            if(ebur128_loudness_global_multiple(states.data(), states.size(), &albumGain) == EBUR128_SUCCESS) {
-                albumGain = ReferenceLUFS - albumGain;
-            }
+        const auto albumMeters = m_albumMeters.find(QString::fromLatin1(SingleAlbumKey));
+        if(albumMeters != m_albumMeters.cend()) {
+            const float albumGain
+                = Ebur128Meter::albumGain(albumMeters->second).value_or(static_cast<float>(Constants::InvalidGain));
 
             const float albumPeak
                 = std::ranges::max_element(m_scannedTracks, std::ranges::less{}, &Track::rgTrackPeak)->rgTrackPeak();
 
             for(Track& track : m_scannedTracks) {
-                track.setRGAlbumGain(static_cast<float>(albumGain));
+                track.setRGAlbumGain(albumGain);
                 track.setRGAlbumPeak(albumPeak);
             }
+
+            m_albumMeters.erase(albumMeters);
         }
 
         if(mayRun()) {
-            qCDebug(EBUR128) << "Finished calculating RG for" << m_scannedTracks.size() << "tracks";
+            logFinished();
             emit calculationFinished(m_scannedTracks);
         }
         if(m_runningWatchers.fetch_sub(1, std::memory_order_release) <= 1) {
+            releaseConvertBuffers();
             emit finished();
         }
         setState(Idle);
@@ -157,6 +160,7 @@ void Ebur128Scanner::calculateAsAlbum(const TrackList& tracks, bool truePeak)
 void Ebur128Scanner::calculateByAlbumTags(const TrackList& tracks, const QString& groupScript, bool truePeak)
 {
     setState(Running);
+    m_timer.start();
 
     qCDebug(EBUR128) << "Calculating RG using ebur128 for" << tracks.size() << "tracks";
 
@@ -172,13 +176,21 @@ void Ebur128Scanner::calculateByAlbumTags(const TrackList& tracks, const QString
 void Ebur128Scanner::scanTrack(Track& track, bool truePeak, const QString& album)
 {
     if(!mayRun()) {
-        m_audioLoader->destroyThreadInstance();
         return;
     }
 
+    // Owned by this worker thread and reused for every track it scans
     auto* decoder = m_audioLoader->decoderForTrack(track);
     if(!decoder) {
-        m_audioLoader->destroyThreadInstance();
+        return;
+    }
+
+    const auto cancelled = [this]() {
+        return !mayRun();
+    };
+
+    auto lease = IoScheduler::instance()->acquire(track.filepath(), IoScheduler::Priority::Background, cancelled);
+    if(!lease.isValid()) {
         return;
     }
 
@@ -187,76 +199,82 @@ void Ebur128Scanner::scanTrack(Track& track, bool truePeak, const QString& album
     QFile file{source.filepath};
     if(!file.open(QIODevice::ReadOnly)) {
         qCWarning(EBUR128) << "Failed to open" << source.filepath;
-        m_audioLoader->destroyThreadInstance();
         return;
     }
     source.device = &file;
 
-    auto format = decoder->init(source, track, AudioDecoder::NoSeeking | AudioDecoder::NoInfiniteLooping);
+    const auto format = decoder->init(source, track, AudioDecoder::NoSeeking | AudioDecoder::NoInfiniteLooping);
     if(!format) {
-        m_audioLoader->destroyThreadInstance();
         return;
     }
 
-    format->setSampleFormat(SampleFormat::F64);
     decoder->start();
 
-    EburStatePtr state{ebur128_init(format->channelCount(), format->sampleRate(),
-                                    EBUR128_MODE_I | (truePeak ? EBUR128_MODE_TRUE_PEAK : EBUR128_MODE_SAMPLE_PEAK))};
+    Ebur128Meter meter{format.value(), truePeak};
 
-    AudioBuffer buffer;
-    while((buffer = decoder->readBuffer(BufferSize)).isValid()) {
-        if(!mayRun()) {
-            m_audioLoader->destroyThreadInstance();
-            return;
-        }
+    auto convertBuffer = takeConvertBuffer();
 
-        buffer = Audio::convert(buffer, *format);
-        if(ebur128_add_frames_double(state.get(), std::bit_cast<double*>(buffer.data()), buffer.frameCount())
-           != EBUR128_SUCCESS) {
+    AudioBuffer buffer;
+    while(mayRun() && lease.yield(cancelled) && (buffer = decoder->readBuffer(BufferSize)).isValid()) {
+        if(!meter.addBuffer(buffer, convertBuffer)) {
             break;
         }
     }
 
+    returnConvertBuffer(std::move(convertBuffer));
+    decoder->stop();
+
     if(!mayRun()) {
-        m_audioLoader->destroyThreadInstance();
         return;
     }
 
-    double trackGain{Constants::InvalidGain};
-    if(ebur128_loudness_global(state.get(), &trackGain) == EBUR128_SUCCESS) {
-        trackGain = ReferenceLUFS - trackGain;
-        track.setRGTrackGain(static_cast<float>(trackGain));
+    if(const auto trackGain = meter.trackGain()) {
+        track.setRGTrackGain(trackGain.value());
     }
+    track.setRGTrackPeak(meter.trackPeak());
 
-    double trackPeak{Constants::InvalidPeak};
-    const auto channels = static_cast<unsigned int>(format->channelCount());
-
-    if(truePeak) {
-        for(unsigned i{0}; i < channels; ++i) {
-            double channelPeak{Constants::InvalidPeak};
-            if(ebur128_true_peak(state.get(), i, &channelPeak) == EBUR128_SUCCESS) {
-                trackPeak = std::max(trackPeak, channelPeak);
-            }
-        }
-    }
-    else {
-        for(unsigned i{0}; i < channels; ++i) {
-            double channelPeak{Constants::InvalidPeak};
-            if(ebur128_sample_peak(state.get(), i, &channelPeak) == EBUR128_SUCCESS) {
-                trackPeak = std::max(trackPeak, channelPeak);
-            }
-        }
+    if(!album.isEmpty()) {
+        const std::scoped_lock lock{m_mutex};
+        m_albumMeters[album].emplace_back(std::move(meter));
     }
+}
 
-    track.setRGTrackPeak(static_cast<float>(trackPeak));
+void Ebur128Scanner::logFinished() const
+{
+    const uint64_t audioLength
+        = std::accumulate(m_scannedTracks.cbegin(), m_scannedTracks.cend(), uint64_t{0},
+                          [](uint64_t total, const Track& track) { return total + track.duration(); });
+    const qint64 elapsed = std::max<qint64>(m_timer.elapsed(), 1);
+
+    qCDebug(EBUR128) << "Finished calculating RG for" << m_scannedTracks.size() << "tracks:" << audioLength / 1000
+                     << "seconds of audio in" << elapsed << "ms,"
+                     << static_cast<double>(audioLength) / static_cast<double>(elapsed) << "x realtime";
+}
 
-    if(!album.isEmpty()) {
-        const std::scoped_lock lock{m_mutex};
-        m_albumStates[album].emplace_back(std::move(state));
+std::vector<std::byte> Ebur128Scanner::takeConvertBuffer()
+{
+    const std::scoped_lock lock{m_bufferMutex};
+
+    if(m_convertBuffers.empty()) {
+        return {};
     }
 
-    m_audioLoader->destroyThreadInstance();
+    auto buffer = std::move(m_convertBuffers.back());
+    m_convertBuffers.pop_back();
+    return buffer;
+}
+
+void Ebur128Scanner::returnConvertBuffer(std::vector<std::byte> buffer)
+{
+    const std::scoped_lock lock{m_bufferMutex};
+    m_convertBuffers.push_back(std::move(buffer));
+}
+
+void Ebur128Scanner::releaseConvertBuffers()
+{
+    const std::scoped_lock lock{m_bufferMutex};
+    m_convertBuffers.clear();
+    m_convertBuffers.shrink_to_fit();
 }
 
 void Ebur128Scanner::scanAlbum(bool truePeak)
@@ -266,10 +284,11 @@ void Ebur128Scanner::scanAlbum(bool truePeak)
             for(const auto& [_, tracks] : m_albums) {
                 m_scannedTracks.insert(m_scannedTracks.end(), tracks.cbegin(), tracks.cend());
             }
-            qCDebug(EBUR128) << "Finished calculating RG for" << m_scannedTracks.size() << "tracks";
+            logFinished();
             emit calculationFinished(m_scannedTracks);
         }
         if(m_runningWatchers.fetch_sub(1, std::memory_order_release) <= 1) {
+            releaseConvertBuffers();
             emit finished();
         }
         setState(Idle);
@@ -279,8 +298,9 @@ void Ebur128Scanner::scanAlbum(bool truePeak)
     const auto album = m_currentAlbum->first;
     m_tracks         = m_currentAlbum->second;
 
-    auto albumFuture = QtConcurrent::map(m_currentAlbum->second,
-                                         [this, truePeak, album](Track& track) { scanTrack(track, truePeak, album); });
+    auto albumFuture = QtConcurrent::map(&m_threadPool, m_currentAlbum->second, [this, truePeak, album](Track& track) {
+        scanTrack(track, truePeak, album);
+    });
 
     auto* albumWatcher = new QFutureWatcher<void>(this);
     m_albumWatchers.emplace(album, albumWatcher);
@@ -292,17 +312,10 @@ void Ebur128Scanner::scanAlbum(bool truePeak)
     });
 
     QObject::connect(albumWatcher, &QFutureWatcher<void>::finished, this, [this, truePeak, album]() {
-        const auto albumState = m_albumStates.find(album);
-        if(albumState != m_albumStates.cend()) {
-            const auto& trackStates = albumState->second;
-            std::vector<ebur128_state*> states;
-            std::ranges::transform(trackStates, std::back_inserter(states),
-                                   [](const auto& state) { return state.get(); });
-
-            double albumGain{Constants::InvalidGain};
-            if(ebur128_loudness_global_multiple(states.data(), states.size(), &albumGain) == EBUR128_SUCCESS) {
-                albumGain = ReferenceLUFS - albumGain;
-            }
+        const auto albumMeters = m_albumMeters.find(album);
+        if(albumMeters != m_albumMeters.cend()) {
+            const float albumGain
+                = Ebur128Meter::albumGain(albumMeters->second).value_or(static_cast<float>(Constants::InvalidGain));
 
             auto& albumTracks = m_currentAlbum->second;
 
@@ -310,11 +323,11 @@ void Ebur128Scanner::scanAlbum(bool truePeak)
                 = std::ranges::max_element(albumTracks, std::ranges::less{}, &Track::rgTrackPeak)->rgTrackPeak();
 
             for(Track& track : albumTracks) {
-                track.setRGAlbumGain(static_cast<float>(albumGain));
+                track.setRGAlbumGain(albumGain);
                 track.setRGAlbumPeak(albumPeak);
             }
 
-            albumState->second.clear();
+            albumMeters->second.clear();
         }
 
         ++m_currentAlbum;
@@ -19,14 +19,15 @@
 
 #pragma once
 
+#include "ebur128meter.h"
 #include "rgscanner.h"
 
 #include <core/scripting/scriptparser.h>
 
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFutureWatcher>
-
-#include <ebur128.h>
+#include <QThreadPool>
 
 namespace Fooyin::RGScanner {
 class Ebur128Scanner : public RGWorker
@@ -43,23 +44,17 @@ public:
     void calculateByAlbumTags(const TrackList& tracks, const QString& groupScript, bool truePeak) override;
 
 private:
-    struct EburStateDeleter
-    {
-        void operator()(ebur128_state* state) const
-        {
-            if(state) {
-                ebur128_destroy(&state);
-            }
-        }
-    };
-    using EburStatePtr = std::unique_ptr<ebur128_state, EburStateDeleter>;
-
     using Albums        = std::unordered_map<QString, TrackList>;
     using AlbumWatchers = std::unordered_map<QString, QFutureWatcher<void>*>;
-    using AlbumStates   = std::unordered_map<QString, std::vector<EburStatePtr>>;
+    using AlbumMeters   = std::unordered_map<QString, std::vector<Ebur128Meter>>;
 
     void scanTrack(Track& track, bool truePeak, const QString& album = {});
     void scanAlbum(bool truePeak);
+    void logFinished() const;
+
+    std::vector<std::byte> takeConvertBuffer();
+    void returnConvertBuffer(std::vector<std::byte> buffer);
+    void releaseConvertBuffers();
 
     std::shared_ptr<AudioLoader> m_audioLoader;
     ScriptParser m_parser;
@@ -70,13 +65,18 @@ private:
     Albums m_albums;
     Albums::iterator m_currentAlbum;
     AlbumWatchers m_albumWatchers;
-    AlbumStates m_albumStates;
+    AlbumMeters m_albumMeters;
 
     QFutureWatcher<void>* m_watcher;
-    AudioDecoder* m_decoder;
-    AudioFormat m_format;
 
     std::mutex m_mutex;
     std::atomic_int m_runningWatchers;
+
+    std::mutex m_bufferMutex;
+    // Handed to each scan in turn, so they're reused across tracks and freed once the scanner is idle
+    std::vector<std::vector<std::byte>> m_convertBuffers;
+
+    QElapsedTimer m_timer;
+    QThreadPool m_threadPool;
 };
 } // namespace Fooyin::RGScanner
@@ -23,6 +23,10 @@
 #include "rgscannerpage.h"
 #include "rgscanresults.h"
 
+#ifdef HAVE_EBUR128
+#include "ebur128analysisstage.h"
+#endif
+
 #include <core/library/musiclibrary.h>
 #include <gui/guiconstants.h>
 #include <gui/trackselectioncontroller.h>
@@ -47,6 +51,10 @@ void RGScannerPlugin::initialise(const CorePluginContext& context)
     m_audioLoader = context.audioLoader;
     m_library     = context.library;
     m_settings    = context.settingsManager;
+
+#ifdef HAVE_EBUR128
+    context.libraryAnalyser->addStage(std::make_shared<Ebur128AnalysisStage>());
+#endif
 }
 
 void RGScannerPlugin::initialise(const GuiPluginContext& context)
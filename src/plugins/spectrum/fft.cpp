@@ -0,0 +1,135 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "fft.h"
+
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+namespace Fooyin::Spectrum {
+Fft::Fft(int size)
+    : m_size{size}
+    , m_half{size / 2}
+    , m_bitReverse(m_half)
+    , m_twiddleReal(m_half / 2)
+    , m_twiddleImag(m_half / 2)
+    , m_splitReal(m_half)
+    , m_splitImag(m_half)
+    , m_real(m_half)
+    , m_imag(m_half)
+{
+    int bits{0};
+    while((1 << bits) < m_half) {
+        ++bits;
+    }
+
+    for(int i{0}; i < m_half; ++i) {
+        int reversed{0};
+        for(int bit{0}; bit < bits; ++bit) {
+            reversed |= ((i >> bit) & 1) << (bits - 1 - bit);
+        }
+        m_bitReverse[i] = reversed;
+    }
+
+    const double halfStep = -2.0 * std::numbers::pi / m_half;
+    for(int i{0}; i < m_half / 2; ++i) {
+        m_twiddleReal[i] = static_cast<float>(std::cos(halfStep * i));
+        m_twiddleImag[i] = static_cast<float>(std::sin(halfStep * i));
+    }
+
+    const double fullStep = -2.0 * std::numbers::pi / m_size;
+    for(int i{0}; i < m_half; ++i) {
+        m_splitReal[i] = static_cast<float>(std::cos(fullStep * i));
+        m_splitImag[i] = static_cast<float>(std::sin(fullStep * i));
+    }
+}
+
+int Fft::size() const
+{
+    return m_size;
+}
+
+int Fft::binCount() const
+{
+    return m_half + 1;
+}
+
+void Fft::magnitudes(std::span<const float> input, std::span<float> magnitudes)
+{
+    if(std::cmp_less(input.size(), m_size) || std::cmp_less(magnitudes.size(), binCount())) {
+        return;
+    }
+
+    // Even samples become the real part and odd samples the imaginary part
+    for(int i{0}; i < m_half; ++i) {
+        const int index = m_bitReverse[i];
+        m_real[index]   = input[2 * i];
+        m_imag[index]   = input[(2 * i) + 1];
+    }
+
+    transform();
+
+    magnitudes[0]      = std::abs(m_real[0] + m_imag[0]);
+    magnitudes[m_half] = std::abs(m_real[0] - m_imag[0]);
+
+    for(int k{1}; k < m_half; ++k) {
+        const int mirror = m_half - k;
+
+        // Even and odd spectra from Z[k] and conj(Z[M - k])
+        const float evenReal = 0.5F * (m_real[k] + m_real[mirror]);
+        const float evenImag = 0.5F * (m_imag[k] - m_imag[mirror]);
+        const float oddReal  = 0.5F * (m_imag[k] + m_imag[mirror]);
+        const float oddImag  = -0.5F * (m_real[k] - m_real[mirror]);
+
+        const float twiddledReal = (oddReal * m_splitReal[k]) - (oddImag * m_splitImag[k]);
+        const float twiddledImag = (oddReal * m_splitImag[k]) + (oddImag * m_splitReal[k]);
+
+        magnitudes[k] = std::hypot(evenReal + twiddledReal, evenImag + twiddledImag);
+    }
+}
+
+void Fft::transform()
+{
+    for(int length{2}; length <= m_half; length *= 2) {
+        const int halfLength = length / 2;
+        const int stride     = m_half / length;
+
+        for(int start{0}; start < m_half; start += length) {
+            float* evenReal = m_real.data() + start;
+            float* evenImag = m_imag.data() + start;
+            float* oddReal  = evenReal + halfLength;
+            float* oddImag  = evenImag + halfLength;
+
+            for(int i{0}; i < halfLength; ++i) {
+                const float wReal = m_twiddleReal[i * stride];
+                const float wImag = m_twiddleImag[i * stride];
+
+                const float real = (oddReal[i] * wReal) - (oddImag[i] * wImag);
+                const float imag = (oddReal[i] * wImag) + (oddImag[i] * wReal);
+
+                oddReal[i]  = evenReal[i] - real;
+                oddImag[i]  = evenImag[i] - imag;
+                evenReal[i] = evenReal[i] + real;
+                evenImag[i] = evenImag[i] + imag;
+            }
+        }
+    }
+}
+} // namespace Fooyin::Spectrum
@@ -0,0 +1,60 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+namespace Fooyin::Spectrum {
+/*!
+ * Radix-2 FFT of real input.
+ * The real signal is packed into a complex signal of half the length, transformed, then split back into
+ * the bins of the full transform. Real and imaginary parts are kept in separate arrays so the butterflies
+ * vectorise.
+ */
+class Fft
+{
+public:
+    /** @p size must be a power of two, and at least 4. */
+    explicit Fft(int size);
+
+    [[nodiscard]] int size() const;
+    [[nodiscard]] int binCount() const;
+
+    /*!
+     * Transforms @p input (size() samples) and writes the magnitude of each bin to @p magnitudes
+     * (binCount() values, from DC to Nyquist).
+     */
+    void magnitudes(std::span<const float> input, std::span<float> magnitudes);
+
+private:
+    void transform();
+
+    int m_size;
+    int m_half;
+    std::vector<int> m_bitReverse;
+    std::vector<float> m_twiddleReal;
+    std::vector<float> m_twiddleImag;
+    std::vector<float> m_splitReal;
+    std::vector<float> m_splitImag;
+    std::vector<float> m_real;
+    std::vector<float> m_imag;
+};
+} // namespace Fooyin::Spectrum
@@ -0,0 +1,273 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "spectrogramwidget.h"
+
+#include <core/engine/audioanalysistap.h>
+#include <core/player/playercontroller.h>
+#include <gui/painttimer.h>
+
+#include <QActionGroup>
+#include <QContextMenuEvent>
+#include <QJsonObject>
+#include <QMenu>
+#include <QPainter>
+#include <QTimerEvent>
+
+using namespace Qt::StringLiterals;
+
+constexpr auto UpdateInterval = 25;
+constexpr auto Overlap        = 4;
+constexpr auto DefaultFftSize = 2048;
+
+namespace {
+std::array<QRgb, 256> createColourMap()
+{
+    // Black through purple, red and orange to pale yellow
+    static constexpr std::array<std::pair<float, QRgb>, 5> stops{{{0.0F, 0xff000000},
+                                                                  {0.3F, 0xff3b0f70},
+                                                                  {0.55F, 0xffb5367a},
+                                                                  {0.8F, 0xfffb8861},
+                                                                  {1.0F, 0xfffcfdbf}}};
+
+    std::array<QRgb, 256> colours;
+
+    size_t stop{0};
+    for(size_t i{0}; i < colours.size(); ++i) {
+        const float value = static_cast<float>(i) / static_cast<float>(colours.size() - 1);
+        while(stop + 2 < stops.size() && value > stops.at(stop + 1).first) {
+            ++stop;
+        }
+
+        const auto& [startPos, start] = stops.at(stop);
+        const auto& [endPos, end]     = stops.at(stop + 1);
+        const float t                 = std::clamp((value - startPos) / (endPos - startPos), 0.0F, 1.0F);
+
+        auto mix = [t](int from, int to) {
+            return static_cast<int>(std::lround(static_cast<float>(from) + (static_cast<float>(to - from) * t)));
+        };
+
+        colours.at(i) = qRgb(mix(qRed(start), qRed(end)), mix(qGreen(start), qGreen(end)),
+                             mix(qBlue(start), qBlue(end)));
+    }
+
+    return colours;
+}
+} // namespace
+
+namespace Fooyin::Spectrum {
+SpectrogramWidget::SpectrogramWidget(PlayerController* playerController, AudioAnalysisTap* analysisTap,
+                                     QWidget* parent)
+    : FyWidget{parent}
+    , m_playerController{playerController}
+    , m_analysisTap{analysisTap}
+    , m_samplePosition{0}
+    , m_column{0}
+    , m_colours{createColourMap()}
+{
+    setObjectName(SpectrogramWidget::name());
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    m_analyser.setFftSize(DefaultFftSize);
+    m_analyser.setOverlap(Overlap);
+
+    m_analysisTap->addSampleReader();
+
+    QObject::connect(m_playerController, &PlayerController::playStateChanged, this,
+                     [this]() { playStateChanged(m_playerController->playState()); });
+
+    playStateChanged(m_playerController->playState());
+}
+
+SpectrogramWidget::~SpectrogramWidget()
+{
+    m_analysisTap->removeSampleReader();
+}
+
+QString SpectrogramWidget::name() const
+{
+    return tr("Spectrogram");
+}
+
+QString SpectrogramWidget::layoutName() const
+{
+    return u"Spectrogram"_s;
+}
+
+void SpectrogramWidget::saveLayoutData(QJsonObject& layout)
+{
+    layout["FftSize"_L1] = m_analyser.fftSize();
+}
+
+void SpectrogramWidget::loadLayoutData(const QJsonObject& layout)
+{
+    if(layout.contains("FftSize"_L1)) {
+        setFftSize(layout.value("FftSize"_L1).toInt());
+    }
+}
+
+void SpectrogramWidget::setFftSize(int size)
+{
+    if(size < 512 || (size & (size - 1)) != 0) {
+        return;
+    }
+
+    m_analyser.setFftSize(size);
+    m_analyser.reset();
+}
+
+void SpectrogramWidget::resizeEvent(QResizeEvent* event)
+{
+    FyWidget::resizeEvent(event);
+    resetImage();
+}
+
+void SpectrogramWidget::timerEvent(QTimerEvent* event)
+{
+    if(event->timerId() == m_updateTimer.timerId()) {
+        readFrames();
+    }
+    FyWidget::timerEvent(event);
+}
+
+void SpectrogramWidget::paintEvent(QPaintEvent* event)
+{
+    const PaintTimer paintTimer{"SpectrogramWidget"};
+
+    QPainter painter{this};
+
+    if(m_image.isNull()) {
+        painter.fillRect(event->rect(), Qt::black);
+        return;
+    }
+
+    // The oldest column is at m_column, so draw it at the left edge and wrap the rest
+    const int width  = m_image.width();
+    const int height = m_image.height();
+    const int split  = width - m_column;
+
+    painter.drawImage(QRect{0, 0, split, height}, m_image, QRect{m_column, 0, split, height});
+    if(m_column > 0) {
+        painter.drawImage(QRect{split, 0, m_column, height}, m_image, QRect{0, 0, m_column, height});
+    }
+}
+
+void SpectrogramWidget::contextMenuEvent(QContextMenuEvent* event)
+{
+    auto* menu = new QMenu(this);
+    menu->setAttribute(Qt::WA_DeleteOnClose);
+
+    auto* fftMenu  = new QMenu(tr("FFT size"), menu);
+    auto* fftGroup = new QActionGroup(fftMenu);
+    for(const int size : {1024, 2048, 4096, 8192}) {
+        auto* action = new QAction(QString::number(size), fftGroup);
+        action->setCheckable(true);
+        action->setChecked(m_analyser.fftSize() == size);
+        QObject::connect(action, &QAction::triggered, this, [this, size]() { setFftSize(size); });
+        fftMenu->addAction(action);
+    }
+
+    auto* clear = new QAction(tr("Clear"), menu);
+    QObject::connect(clear, &QAction::triggered, this, [this]() { resetImage(); });
+
+    menu->addMenu(fftMenu);
+    menu->addSeparator();
+    menu->addAction(clear);
+
+    menu->popup(event->globalPos());
+}
+
+void SpectrogramWidget::playStateChanged(Player::PlayState state)
+{
+    switch(state) {
+        case(Player::PlayState::Playing):
+            m_samplePosition = m_analysisTap->samplePosition();
+            m_analyser.reset();
+            m_updateTimer.start(UpdateInterval, this);
+            break;
+        case(Player::PlayState::Paused):
+        case(Player::PlayState::Stopped):
+            m_updateTimer.stop();
+            break;
+    }
+}
+
+void SpectrogramWidget::resetImage()
+{
+    const QSize imageSize = size();
+    if(imageSize.isEmpty()) {
+        m_image = {};
+        return;
+    }
+
+    m_image = QImage{imageSize, QImage::Format_RGB32};
+    m_image.fill(m_colours.front());
+    m_column = 0;
+
+    // One band per row
+    m_analyser.setBandCount(imageSize.height());
+    m_frame.assign(imageSize.height(), 0.0F);
+
+    update();
+}
+
+void SpectrogramWidget::readFrames()
+{
+    if(m_image.isNull()) {
+        return;
+    }
+
+    m_analyser.readFrom(*m_analysisTap, m_samplePosition);
+
+    int columns{0};
+    while(m_analyser.nextFrame(m_frame)) {
+        drawColumn();
+        ++columns;
+    }
+
+    if(columns == 0) {
+        return;
+    }
+
+    if(columns >= width()) {
+        update();
+    }
+    else {
+        // Shift the existing pixels and only repaint the new columns
+        scroll(-columns, 0);
+    }
+}
+
+void SpectrogramWidget::drawColumn()
+{
+    const int height = m_image.height();
+    const auto last  = static_cast<float>(m_colours.size() - 1);
+
+    for(int row{0}; row < height; ++row) {
+        // Lowest frequencies at the bottom
+        const float value = m_frame[height - 1 - row];
+        auto* line        = reinterpret_cast<QRgb*>(m_image.scanLine(row));
+        line[m_column]    = m_colours[static_cast<size_t>(value * last)];
+    }
+
+    m_column = (m_column + 1) % m_image.width();
+}
+} // namespace Fooyin::Spectrum
+
+#include "moc_spectrogramwidget.cpp"
@@ -0,0 +1,197 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "spectrumanalyser.h"
+
+#include <core/engine/audioanalysistap.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+constexpr auto DefaultFftSize = 4096;
+constexpr auto MinFrequency   = 20.0;
+constexpr auto MaxFrequency   = 20000.0;
+constexpr auto MinDb          = -80.0F;
+
+namespace Fooyin::Spectrum {
+SpectrumAnalyser::SpectrumAnalyser()
+    : m_fft{std::make_unique<Fft>(DefaultFftSize)}
+    , m_overlap{1}
+    , m_sampleRate{44100}
+    , m_bandCount{64}
+    , m_windowGain{1.0F}
+    , m_readOffset{0}
+{
+    updateWindow();
+    updateBands();
+}
+
+int SpectrumAnalyser::fftSize() const
+{
+    return m_fft->size();
+}
+
+void SpectrumAnalyser::setFftSize(int size)
+{
+    if(size == m_fft->size()) {
+        return;
+    }
+
+    m_fft = std::make_unique<Fft>(size);
+    updateWindow();
+    updateBands();
+}
+
+void SpectrumAnalyser::setOverlap(int overlap)
+{
+    m_overlap = std::max(1, overlap);
+}
+
+void SpectrumAnalyser::setSampleRate(int sampleRate)
+{
+    if(sampleRate <= 0 || std::exchange(m_sampleRate, sampleRate) == sampleRate) {
+        return;
+    }
+
+    updateBands();
+}
+
+void SpectrumAnalyser::setBandCount(int count)
+{
+    if(count <= 0 || std::exchange(m_bandCount, count) == count) {
+        return;
+    }
+
+    updateBands();
+}
+
+int SpectrumAnalyser::bandCount() const
+{
+    return m_bandCount;
+}
+
+void SpectrumAnalyser::reset()
+{
+    m_pending.clear();
+    m_readOffset = 0;
+}
+
+void SpectrumAnalyser::dropStale()
+{
+    const auto size      = static_cast<size_t>(m_fft->size());
+    const size_t pending = m_pending.size() - m_readOffset;
+
+    if(pending > size) {
+        m_readOffset = m_pending.size() - size;
+    }
+}
+
+void SpectrumAnalyser::addSamples(std::span<const float> samples)
+{
+    if(m_readOffset > 0 && m_readOffset >= m_pending.size() / 2) {
+        m_pending.erase(m_pending.begin(), m_pending.begin() + static_cast<std::ptrdiff_t>(m_readOffset));
+        m_readOffset = 0;
+    }
+
+    m_pending.insert(m_pending.end(), samples.begin(), samples.end());
+}
+
+void SpectrumAnalyser::readFrom(const AudioAnalysisTap& tap, uint64_t& position)
+{
+    setSampleRate(tap.sampleRate());
+
+    std::array<float, 4096> chunk;
+    while(const size_t count = tap.readSamples(position, chunk)) {
+        addSamples({chunk.data(), count});
+    }
+}
+
+bool SpectrumAnalyser::nextFrame(std::span<float> bands)
+{
+    const int size = m_fft->size();
+
+    if(m_pending.size() - m_readOffset < static_cast<size_t>(size)) {
+        return false;
+    }
+
+    const float* samples = m_pending.data() + m_readOffset;
+    for(int i{0}; i < size; ++i) {
+        m_frame[i] = samples[i] * m_window[i];
+    }
+
+    m_readOffset += static_cast<size_t>(size / m_overlap);
+
+    m_fft->magnitudes(m_frame, m_magnitudes);
+
+    const auto count = std::min(bands.size(), m_bands.size());
+    for(size_t band{0}; band < count; ++band) {
+        const auto& [first, last] = m_bands[band];
+
+        const auto bandMax = std::max_element(m_magnitudes.cbegin() + first, m_magnitudes.cbegin() + last + 1);
+        const float db     = 20.0F * std::log10(std::max(*bandMax * m_windowGain, 1e-9F));
+
+        bands[band] = std::clamp((db - MinDb) / -MinDb, 0.0F, 1.0F);
+    }
+
+    return true;
+}
+
+void SpectrumAnalyser::updateWindow()
+{
+    const int size = m_fft->size();
+
+    m_window.resize(size);
+    m_frame.resize(size);
+    m_magnitudes.resize(m_fft->binCount());
+
+    double sum{0.0};
+    for(int i{0}; i < size; ++i) {
+        const double value = 0.5 * (1.0 - std::cos(2.0 * std::numbers::pi * i / (size - 1)));
+        m_window[i]        = static_cast<float>(value);
+        sum += value;
+    }
+
+    // Scale so a full-scale sine reads 0dB
+    m_windowGain = static_cast<float>(2.0 / sum);
+}
+
+void SpectrumAnalyser::updateBands()
+{
+    const int size     = m_fft->size();
+    const int lastBin  = m_fft->binCount() - 1;
+    const double maxHz = std::min(MaxFrequency, m_sampleRate / 2.0);
+    const double ratio = maxHz / MinFrequency;
+    const double binHz = static_cast<double>(m_sampleRate) / size;
+
+    m_bands.resize(m_bandCount);
+
+    for(int band{0}; band < m_bandCount; ++band) {
+        const double low  = MinFrequency * std::pow(ratio, static_cast<double>(band) / m_bandCount);
+        const double high = MinFrequency * std::pow(ratio, static_cast<double>(band + 1) / m_bandCount);
+
+        const int first = std::clamp(static_cast<int>(std::lround(low / binHz)), 1, lastBin);
+        const int last  = std::clamp(static_cast<int>(std::lround(high / binHz)) - 1, first, lastBin);
+
+        m_bands[band] = {first, last};
+    }
+}
+} // namespace Fooyin::Spectrum
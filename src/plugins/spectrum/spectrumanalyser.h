@@ -0,0 +1,90 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fft.h"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace Fooyin {
+class AudioAnalysisTap;
+
+namespace Spectrum {
+/*!
+ * Turns a stream of mono samples into log-frequency band levels.
+ * Samples are split into Hann-windowed frames which overlap by the configured factor, and each frame's
+ * FFT bins are grouped into bands spaced logarithmically between 20Hz and 20kHz (or Nyquist).
+ * Band levels are scaled from the dB floor to 0dBFS as 0-1.
+ */
+class SpectrumAnalyser
+{
+public:
+    SpectrumAnalyser();
+
+    [[nodiscard]] int fftSize() const;
+    void setFftSize(int size);
+    void setOverlap(int overlap);
+    void setSampleRate(int sampleRate);
+    void setBandCount(int count);
+    [[nodiscard]] int bandCount() const;
+
+    /** Discards any buffered samples. */
+    void reset();
+    /** Discards buffered samples other than those needed for the most recent frame. */
+    void dropStale();
+
+    void addSamples(std::span<const float> samples);
+    /** Adds the samples played since @p position, and advances it. */
+    void readFrom(const AudioAnalysisTap& tap, uint64_t& position);
+    /*!
+     * Computes the next frame if enough samples are buffered, and writes its band levels to @p bands.
+     * @returns false if there aren't enough samples.
+     */
+    bool nextFrame(std::span<float> bands);
+
+private:
+    struct BandRange
+    {
+        int first{0};
+        int last{0};
+    };
+
+    void updateWindow();
+    void updateBands();
+
+    std::unique_ptr<Fft> m_fft;
+    int m_overlap;
+    int m_sampleRate;
+    int m_bandCount;
+
+    std::vector<float> m_window;
+    float m_windowGain;
+    std::vector<BandRange> m_bands;
+
+    std::vector<float> m_pending;
+    size_t m_readOffset;
+    std::vector<float> m_frame;
+    std::vector<float> m_magnitudes;
+};
+} // namespace Spectrum
+} // namespace Fooyin
@@ -0,0 +1,54 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "spectrumplugin.h"
+
+#include "spectrogramwidget.h"
+#include "spectrumwidget.h"
+
+#include <core/engine/enginecontroller.h>
+#include <gui/widgetprovider.h>
+
+using namespace Qt::StringLiterals;
+
+namespace Fooyin::Spectrum {
+void SpectrumPlugin::initialise(const CorePluginContext& context)
+{
+    m_playerController = context.playerController;
+    m_engine           = context.engine;
+}
+
+void SpectrumPlugin::initialise(const GuiPluginContext& context)
+{
+    m_widgetProvider = context.widgetProvider;
+
+    m_widgetProvider->registerWidget(
+        u"SpectrumAnalyser"_s,
+        [this]() { return new SpectrumWidget(m_playerController, m_engine->analysisTap()); },
+        u"Spectrum Analyser"_s);
+    m_widgetProvider->setSubMenus(u"SpectrumAnalyser"_s, {tr("Visualisations")});
+
+    m_widgetProvider->registerWidget(
+        u"Spectrogram"_s, [this]() { return new SpectrogramWidget(m_playerController, m_engine->analysisTap()); },
+        u"Spectrogram"_s);
+    m_widgetProvider->setSubMenus(u"Spectrogram"_s, {tr("Visualisations")});
+}
+} // namespace Fooyin::Spectrum
+
+#include "moc_spectrumplugin.cpp"
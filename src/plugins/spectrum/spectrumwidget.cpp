@@ -0,0 +1,275 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "spectrumwidget.h"
+
+#include <core/engine/audioanalysistap.h>
+#include <core/player/playercontroller.h>
+#include <gui/painttimer.h>
+
+#include <QActionGroup>
+#include <QContextMenuEvent>
+#include <QJsonObject>
+#include <QMenu>
+#include <QPainter>
+#include <QTimerEvent>
+
+using namespace Qt::StringLiterals;
+
+constexpr auto UpdateInterval = 25;
+constexpr auto Overlap        = 2;
+// Fraction of the full range a band falls per second
+constexpr auto Falloff   = 1.5F;
+constexpr auto PeakHold  = 750;
+constexpr auto BarGap    = 1;
+constexpr auto BandCount = 64;
+
+namespace Fooyin::Spectrum {
+SpectrumWidget::SpectrumWidget(PlayerController* playerController, AudioAnalysisTap* analysisTap, QWidget* parent)
+    : FyWidget{parent}
+    , m_playerController{playerController}
+    , m_analysisTap{analysisTap}
+    , m_samplePosition{0}
+    , m_showPeaks{true}
+    , m_stopping{false}
+{
+    setObjectName(SpectrumWidget::name());
+
+    m_analyser.setOverlap(Overlap);
+    setBandCount(BandCount);
+
+    m_analysisTap->addSampleReader();
+
+    QObject::connect(m_playerController, &PlayerController::playStateChanged, this,
+                     [this]() { playStateChanged(m_playerController->playState()); });
+
+    playStateChanged(m_playerController->playState());
+}
+
+SpectrumWidget::~SpectrumWidget()
+{
+    m_analysisTap->removeSampleReader();
+}
+
+QString SpectrumWidget::name() const
+{
+    return tr("Spectrum Analyser");
+}
+
+QString SpectrumWidget::layoutName() const
+{
+    return u"SpectrumAnalyser"_s;
+}
+
+void SpectrumWidget::saveLayoutData(QJsonObject& layout)
+{
+    layout["FftSize"_L1]   = m_analyser.fftSize();
+    layout["Bands"_L1]     = m_analyser.bandCount();
+    layout["ShowPeaks"_L1] = m_showPeaks;
+}
+
+void SpectrumWidget::loadLayoutData(const QJsonObject& layout)
+{
+    if(layout.contains("FftSize"_L1)) {
+        setFftSize(layout.value("FftSize"_L1).toInt());
+    }
+    if(layout.contains("Bands"_L1)) {
+        setBandCount(layout.value("Bands"_L1).toInt());
+    }
+    if(layout.contains("ShowPeaks"_L1)) {
+        m_showPeaks = layout.value("ShowPeaks"_L1).toBool();
+    }
+}
+
+void SpectrumWidget::setFftSize(int size)
+{
+    if(size < 512 || (size & (size - 1)) != 0) {
+        return;
+    }
+
+    m_analyser.setFftSize(size);
+    m_analyser.reset();
+}
+
+void SpectrumWidget::setBandCount(int count)
+{
+    if(count <= 0) {
+        return;
+    }
+
+    m_analyser.setBandCount(count);
+    m_frame.assign(count, 0.0F);
+    m_levels.assign(count, 0.0F);
+    m_peaks.assign(count, 0.0F);
+    m_peakTimes.assign(count, 0);
+    update();
+}
+
+void SpectrumWidget::timerEvent(QTimerEvent* event)
+{
+    if(event->timerId() == m_updateTimer.timerId()) {
+        updateLevels();
+    }
+    FyWidget::timerEvent(event);
+}
+
+void SpectrumWidget::paintEvent(QPaintEvent* /*event*/)
+{
+    const PaintTimer paintTimer{"SpectrumWidget"};
+
+    QPainter painter{this};
+    painter.fillRect(rect(), palette().base());
+
+    const auto count = static_cast<int>(m_levels.size());
+    if(count == 0) {
+        return;
+    }
+
+    const double barWidth = static_cast<double>(width()) / count;
+    const int barHeight   = height();
+
+    QLinearGradient gradient{0, static_cast<double>(barHeight), 0, 0};
+    gradient.setColorAt(0.0, palette().highlight().color().darker(150));
+    gradient.setColorAt(1.0, palette().highlight().color().lighter(130));
+    const QBrush barBrush{gradient};
+    const QColor peakColour = palette().text().color();
+
+    for(int band{0}; band < count; ++band) {
+        const int left  = static_cast<int>(band * barWidth);
+        const int right = std::max(left + 1, static_cast<int>((band + 1) * barWidth) - BarGap);
+
+        const auto level = static_cast<int>(m_levels[band] * static_cast<float>(barHeight));
+        if(level > 0) {
+            painter.fillRect(left, barHeight - level, right - left, level, barBrush);
+        }
+
+        if(m_showPeaks) {
+            const auto peak = static_cast<int>(m_peaks[band] * static_cast<float>(barHeight));
+            if(peak > 0) {
+                painter.fillRect(left, barHeight - peak, right - left, 1, peakColour);
+            }
+        }
+    }
+}
+
+void SpectrumWidget::contextMenuEvent(QContextMenuEvent* event)
+{
+    auto* menu = new QMenu(this);
+    menu->setAttribute(Qt::WA_DeleteOnClose);
+
+    auto* showPeaks = new QAction(tr("Show peaks"), menu);
+    showPeaks->setCheckable(true);
+    showPeaks->setChecked(m_showPeaks);
+    QObject::connect(showPeaks, &QAction::triggered, this, [this](const bool checked) {
+        m_showPeaks = checked;
+        update();
+    });
+
+    auto* fftMenu  = new QMenu(tr("FFT size"), menu);
+    auto* fftGroup = new QActionGroup(fftMenu);
+    for(const int size : {1024, 2048, 4096, 8192, 16384}) {
+        auto* action = new QAction(QString::number(size), fftGroup);
+        action->setCheckable(true);
+        action->setChecked(m_analyser.fftSize() == size);
+        QObject::connect(action, &QAction::triggered, this, [this, size]() { setFftSize(size); });
+        fftMenu->addAction(action);
+    }
+
+    auto* bandMenu  = new QMenu(tr("Bands"), menu);
+    auto* bandGroup = new QActionGroup(bandMenu);
+    for(const int count : {16, 32, 64, 128, 256}) {
+        auto* action = new QAction(QString::number(count), bandGroup);
+        action->setCheckable(true);
+        action->setChecked(m_analyser.bandCount() == count);
+        QObject::connect(action, &QAction::triggered, this, [this, count]() { setBandCount(count); });
+        bandMenu->addAction(action);
+    }
+
+    menu->addAction(showPeaks);
+    menu->addSeparator();
+    menu->addMenu(fftMenu);
+    menu->addMenu(bandMenu);
+
+    menu->popup(event->globalPos());
+}
+
+void SpectrumWidget::playStateChanged(Player::PlayState state)
+{
+    switch(state) {
+        case(Player::PlayState::Playing):
+            // Don't analyse anything played while paused or stopped
+            m_samplePosition = m_analysisTap->samplePosition();
+            m_analyser.reset();
+            m_stopping = false;
+            m_updateTimer.start(UpdateInterval, this);
+            m_elapsedTimer.start();
+            break;
+        case(Player::PlayState::Paused):
+            m_updateTimer.stop();
+            break;
+        case(Player::PlayState::Stopped):
+            if(m_updateTimer.isActive()) {
+                m_stopping = true;
+            }
+            break;
+    }
+}
+
+void SpectrumWidget::updateLevels()
+{
+    const qint64 elapsed = m_elapsedTimer.restart();
+    const qint64 now     = m_elapsedTimer.msecsSinceReference();
+    const float decay    = Falloff * static_cast<float>(elapsed) / 1000.0F;
+
+    bool hasFrame{false};
+    if(!m_stopping) {
+        // Bars only show the latest frame, so older samples don't need analysing
+        m_analyser.readFrom(*m_analysisTap, m_samplePosition);
+        m_analyser.dropStale();
+        hasFrame = m_analyser.nextFrame(m_frame);
+    }
+
+    bool silent{true};
+    const auto count = m_levels.size();
+    for(size_t band{0}; band < count; ++band) {
+        float& level = m_levels[band];
+        float& peak  = m_peaks[band];
+
+        level = std::max(level - decay, hasFrame ? m_frame[band] : 0.0F);
+
+        if(level >= peak || now - m_peakTimes[band] > PeakHold) {
+            peak              = level;
+            m_peakTimes[band] = now;
+        }
+
+        if(level > 0.0F || peak > 0.0F) {
+            silent = false;
+        }
+    }
+
+    if(m_stopping && silent) {
+        m_stopping = false;
+        m_updateTimer.stop();
+    }
+
+    update();
+}
+} // namespace Fooyin::Spectrum
+
+#include "moc_spectrumwidget.cpp"
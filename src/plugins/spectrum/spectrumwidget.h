@@ -0,0 +1,76 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "spectrumanalyser.h"
+
+#include <core/player/playerdefs.h>
+#include <gui/fywidget.h>
+
+#include <QBasicTimer>
+#include <QElapsedTimer>
+
+namespace Fooyin {
+class AudioAnalysisTap;
+class PlayerController;
+
+namespace Spectrum {
+class SpectrumWidget : public FyWidget
+{
+    Q_OBJECT
+
+public:
+    SpectrumWidget(PlayerController* playerController, AudioAnalysisTap* analysisTap, QWidget* parent = nullptr);
+    ~SpectrumWidget() override;
+
+    [[nodiscard]] QString name() const override;
+    [[nodiscard]] QString layoutName() const override;
+    void saveLayoutData(QJsonObject& layout) override;
+    void loadLayoutData(const QJsonObject& layout) override;
+
+    void setFftSize(int size);
+    void setBandCount(int count);
+
+protected:
+    void timerEvent(QTimerEvent* event) override;
+    void paintEvent(QPaintEvent* event) override;
+    void contextMenuEvent(QContextMenuEvent* event) override;
+
+private:
+    void playStateChanged(Player::PlayState state);
+    void updateLevels();
+
+    PlayerController* m_playerController;
+    AudioAnalysisTap* m_analysisTap;
+
+    SpectrumAnalyser m_analyser;
+    uint64_t m_samplePosition;
+    std::vector<float> m_frame;
+    std::vector<float> m_levels;
+    std::vector<float> m_peaks;
+    std::vector<qint64> m_peakTimes;
+
+    bool m_showPeaks;
+    bool m_stopping;
+    QBasicTimer m_updateTimer;
+    QElapsedTimer m_elapsedTimer;
+};
+} // namespace Spectrum
+} // namespace Fooyin
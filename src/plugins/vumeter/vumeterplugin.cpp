@@ -49,9 +49,8 @@ void VuMeterPlugin::initialise(const GuiPluginContext& context)
     m_widgetProvider->registerWidget(
         u"VUMeter"_s,
         [this]() {
-            auto* meter = new VuMeterWidget(VuMeterWidget::Type::Rms, m_playerController, m_settings);
-            QObject::connect(m_engine, &EngineController::bufferPlayed, meter, &VuMeterWidget::renderBuffer);
-            return meter;
+            return new VuMeterWidget(VuMeterWidget::Type::Rms, m_playerController, m_engine->analysisTap(),
+                                     m_settings);
         },
         u"VU Meter"_s);
     m_widgetProvider->setSubMenus(u"VUMeter"_s, {tr("Visualisations")});
@@ -59,9 +58,8 @@ void VuMeterPlugin::initialise(const GuiPluginContext& context)
     m_widgetProvider->registerWidget(
         u"PeakMeter"_s,
         [this]() {
-            auto* meter = new VuMeterWidget(VuMeterWidget::Type::Peak, m_playerController, m_settings);
-            QObject::connect(m_engine, &EngineController::bufferPlayed, meter, &VuMeterWidget::renderBuffer);
-            return meter;
+            return new VuMeterWidget(VuMeterWidget::Type::Peak, m_playerController, m_engine->analysisTap(),
+                                     m_settings);
         },
         u"Peak Meter"_s);
     m_widgetProvider->setSubMenus(u"PeakMeter"_s, {tr("Visualisations")});
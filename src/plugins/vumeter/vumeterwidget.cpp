@@ -22,11 +22,10 @@
 #include "vumetercolours.h"
 #include "vumetersettings.h"
 
-#include <core/engine/audiobuffer.h>
-#include <core/engine/audioconverter.h>
+#include <core/engine/audioanalysistap.h>
 #include <core/player/playercontroller.h>
 #include <gui/guisettings.h>
-#include <utils/async.h>
+#include <gui/painttimer.h>
 #include <utils/settings/settingsdialogcontroller.h>
 #include <utils/settings/settingsmanager.h>
 
@@ -40,7 +39,7 @@
 
 using namespace Qt::StringLiterals;
 
-constexpr auto MaxChannels    = 20;
+constexpr auto MaxChannels    = Fooyin::AudioLevels::MaxChannels;
 constexpr auto UpdateInterval = 25;
 constexpr auto MinDb          = -60.0F;
 constexpr auto MaxDb          = 3.0F;
@@ -89,10 +88,11 @@ class VuMeterWidgetPrivate
 {
 public:
     explicit VuMeterWidgetPrivate(VuMeterWidget* self, VuMeterWidget::Type type, PlayerController* playerController,
-                                  SettingsManager* settings);
+                                  AudioAnalysisTap* analysisTap, SettingsManager* settings);
 
     void reset();
     void updateSize();
+    void readLevels();
     void calculatePeak();
     void updateChannelLevels(int channel, qint64 elapsedTime, qint64 peakTime, float falloff, bool& zeroLevel);
     QRect calculateUpdateRect(int channel);
@@ -118,8 +118,10 @@ public:
 
     VuMeterWidget* m_self;
     PlayerController* m_playerController;
+    AudioAnalysisTap* m_analysisTap;
     SettingsManager* m_settings;
 
+    uint64_t m_analysisSequence{0};
     AudioFormat m_format;
     std::array<float, MaxChannels> m_channelDbLevels;
     std::array<float, MaxChannels> m_channelPeaks;
@@ -153,9 +155,11 @@ public:
 };
 
 VuMeterWidgetPrivate::VuMeterWidgetPrivate(VuMeterWidget* self, VuMeterWidget::Type type,
-                                           PlayerController* playerController, SettingsManager* settings)
+                                           PlayerController* playerController, AudioAnalysisTap* analysisTap,
+                                           SettingsManager* settings)
     : m_self{self}
     , m_playerController{playerController}
+    , m_analysisTap{analysisTap}
     , m_settings{settings}
     , m_type{type}
     , m_channelSpacing{static_cast<float>(m_settings->value<Settings::VuMeter::ChannelSpacing>())}
@@ -221,6 +225,36 @@ void VuMeterWidgetPrivate::updateSize()
     createGradient();
 }
 
+void VuMeterWidgetPrivate::readLevels()
+{
+    AudioLevels levels;
+    if(!m_analysisTap->readSince(m_analysisSequence, levels)) {
+        return;
+    }
+
+    const int channels = levels.channelCount;
+    m_format.setSampleRate(levels.sampleRate);
+    m_format.setChannelCount(channels);
+    m_lastPeakTimers.resize(channels);
+
+    const auto& bufferLevels = m_type == VuMeterWidget::Type::Peak ? levels.peak : levels.rms;
+
+    for(int i{0}; i < channels; ++i) {
+        const float bufferDb = dbOnRange(20 * std::log10(bufferLevels.at(i)));
+
+        float& channelLevel = m_channelDbLevels.at(i);
+        float& channelPeak  = m_channelPeaks.at(i);
+
+        if(bufferDb > channelLevel) {
+            channelLevel = bufferDb;
+        }
+        if(bufferDb > channelPeak) {
+            channelPeak = bufferDb;
+            m_lastPeakTimers.at(i).start();
+        }
+    }
+}
+
 void VuMeterWidgetPrivate::calculatePeak()
 {
     const qint64 elapsedTime = m_elapsedTimer.restart();
@@ -582,6 +616,8 @@ void VuMeterWidgetPrivate::playStateChanged(Player::PlayState state)
 
     switch(state) {
         case(Player::PlayState::Playing):
+            // Levels analysed while paused or stopped are stale
+            m_analysisSequence = m_analysisTap->sequence();
             m_updateTimer.start(UpdateInterval, m_self);
             m_elapsedTimer.start();
             break;
@@ -596,12 +632,15 @@ void VuMeterWidgetPrivate::playStateChanged(Player::PlayState state)
     }
 }
 
-VuMeterWidget::VuMeterWidget(Type type, PlayerController* playerController, SettingsManager* settings, QWidget* parent)
+VuMeterWidget::VuMeterWidget(Type type, PlayerController* playerController, AudioAnalysisTap* analysisTap,
+                             SettingsManager* settings, QWidget* parent)
     : FyWidget{parent}
-    , p{std::make_unique<VuMeterWidgetPrivate>(this, type, playerController, settings)}
+    , p{std::make_unique<VuMeterWidgetPrivate>(this, type, playerController, analysisTap, settings)}
 {
     setObjectName(VuMeterWidget::name());
 
+    p->m_analysisTap->addReader();
+
     p->m_settings->subscribe<Settings::VuMeter::ChannelSpacing>(this, &VuMeterWidget::setChannelSpacing);
     p->m_settings->subscribe<Settings::VuMeter::BarSize>(this, &VuMeterWidget::setBarSize);
     p->m_settings->subscribe<Settings::VuMeter::BarSpacing>(this, &VuMeterWidget::setBarSpacing);
@@ -618,7 +657,10 @@ VuMeterWidget::VuMeterWidget(Type type, PlayerController* playerController, Sett
     p->m_settings->subscribe<Settings::Gui::Style>(this, updateColours);
 }
 
-VuMeterWidget::~VuMeterWidget() = default;
+VuMeterWidget::~VuMeterWidget()
+{
+    p->m_analysisTap->removeReader();
+}
 
 QString VuMeterWidget::name() const
 {
@@ -650,68 +692,6 @@ void VuMeterWidget::loadLayoutData(const QJsonObject& layout)
     }
 }
 
-void VuMeterWidget::renderBuffer(const AudioBuffer& buffer)
-{
-    p->m_format.setSampleRate(buffer.format().sampleRate());
-    const int channels = buffer.format().channelCount();
-    p->m_format.setChannelCount(channels);
-
-    const AudioBuffer normalisedBuffer = Audio::convert(buffer, p->m_format);
-
-    p->m_lastPeakTimers.resize(channels);
-
-    auto calculatePeaks = Utils::asyncExec([this, normalisedBuffer, channels]() {
-        const int totalSamples = normalisedBuffer.sampleCount();
-        const int bps          = normalisedBuffer.format().bytesPerSample();
-
-        std::array<float, MaxChannels> peaks{0.0F};
-        std::array<int, MaxChannels> sampleCounts{0};
-
-        for(int i{0}; i < totalSamples; ++i) {
-            const int sampleIndex  = i / channels;
-            const int channelIndex = i % channels;
-
-            float sample;
-            const auto offset = (sampleIndex * channels + channelIndex) * bps;
-            std::memcpy(&sample, normalisedBuffer.data() + offset, bps);
-
-            if(p->m_type == Type::Peak) {
-                peaks.at(channelIndex) = std::max(peaks.at(channelIndex), std::abs(sample));
-            }
-            else {
-                peaks.at(channelIndex) += sample * sample;
-                sampleCounts.at(channelIndex)++;
-            }
-        }
-
-        if(p->m_type == Type::Rms) {
-            for(int i{0}; i < channels; ++i) {
-                peaks.at(i) = std::sqrt(peaks.at(i) / static_cast<float>(sampleCounts.at(i)));
-            }
-        }
-
-        return peaks;
-    });
-
-    calculatePeaks.then(this, [this, channels](const std::array<float, MaxChannels>& peaks) {
-        for(int i{0}; i < channels; ++i) {
-            const float bufferRMS = peaks.at(i);
-            const float bufferDb  = dbOnRange(20 * std::log10(bufferRMS));
-
-            float& channelLevel = p->m_channelDbLevels.at(i);
-            float& channelPeak  = p->m_channelPeaks.at(i);
-
-            if(bufferDb > channelLevel) {
-                channelLevel = bufferDb;
-            }
-            if(bufferDb > channelPeak) {
-                channelPeak = bufferDb;
-                p->m_lastPeakTimers.at(i).start();
-            }
-        }
-    });
-}
-
 void VuMeterWidget::setOrientation(Qt::Orientation orientation)
 {
     p->m_orientation = orientation;
@@ -770,6 +750,7 @@ void VuMeterWidget::resizeEvent(QResizeEvent* event)
 void VuMeterWidget::timerEvent(QTimerEvent* event)
 {
     if(event->timerId() == p->m_updateTimer.timerId()) {
+        p->readLevels();
         p->calculatePeak();
     }
     FyWidget::timerEvent(event);
@@ -777,6 +758,8 @@ void VuMeterWidget::timerEvent(QTimerEvent* event)
 
 void VuMeterWidget::paintEvent(QPaintEvent* event)
 {
+    const PaintTimer paintTimer{"VuMeterWidget"};
+
     QPainter painter{this};
     painter.fillRect(0, 0, width(), height(), p->m_colours.colour(Colours::Type::Background));
 
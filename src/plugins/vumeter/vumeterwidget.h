@@ -26,7 +26,7 @@
 #include <gui/fywidget.h>
 
 namespace Fooyin {
-class AudioBuffer;
+class AudioAnalysisTap;
 class PlayerController;
 class SettingsManager;
 
@@ -44,8 +44,8 @@ public:
         Rms
     };
 
-    explicit VuMeterWidget(Type type, PlayerController* playerController, SettingsManager* settings,
-                           QWidget* parent = nullptr);
+    explicit VuMeterWidget(Type type, PlayerController* playerController, AudioAnalysisTap* analysisTap,
+                           SettingsManager* settings, QWidget* parent = nullptr);
     ~VuMeterWidget() override;
 
     [[nodiscard]] QString name() const override;
@@ -53,8 +53,6 @@ public:
     void saveLayoutData(QJsonObject& layout) override;
     void loadLayoutData(const QJsonObject& layout) override;
 
-    void renderBuffer(const AudioBuffer& buffer);
-
     void setOrientation(Qt::Orientation orientation);
     void setShowLegend(bool show);
     void setChannelSpacing(int size);
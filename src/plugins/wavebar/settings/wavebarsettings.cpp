@@ -44,5 +44,6 @@ WaveBarSettings::WaveBarSettings(SettingsManager* settingsManager)
     m_settings->createSetting<CentreGap>(0, u"WaveBar/CentreGap"_s);
     m_settings->createSetting<ChannelScale>(0.9, u"WaveBar/ChannelScale"_s);
     m_settings->createSetting<NumSamples>(2048, u"WaveBar/NumSamples"_s);
+    m_settings->createSetting<Pregenerate>(false, u"WaveBar/PregeneratePlaylist"_s);
 }
 } // namespace Fooyin::WaveBar
@@ -40,6 +40,7 @@ enum WaveBarSettings : uint32_t
     CentreGap     = 9 | Type::Int,
     ChannelScale  = 10 | Type::Double,
     NumSamples    = 11 | Type::Int,
+    Pregenerate   = 12 | Type::Bool,
 };
 Q_ENUM_NS(WaveBarSettings)
 } // namespace Settings::WaveBar
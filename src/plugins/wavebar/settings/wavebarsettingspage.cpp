@@ -76,6 +76,7 @@ private:
 
     QLabel* m_cacheSizeLabel;
     QComboBox* m_numSamples;
+    QCheckBox* m_pregenerate;
 };
 
 WaveBarSettingsPageWidget::WaveBarSettingsPageWidget(SettingsManager* settings)
@@ -95,6 +96,7 @@ WaveBarSettingsPageWidget::WaveBarSettingsPageWidget(SettingsManager* settings)
     , m_centreGap{new QSpinBox(this)}
     , m_cacheSizeLabel{new QLabel(this)}
     , m_numSamples{new QComboBox(this)}
+    , m_pregenerate{new QCheckBox(tr("Generate waveforms for the active playlist in the background"), this)}
 {
     auto* layout = new QGridLayout(this);
 
@@ -188,13 +190,16 @@ WaveBarSettingsPageWidget::WaveBarSettingsPageWidget(SettingsManager* settings)
     });
 
     auto* numSamplesLabel = new QLabel(tr("Number of samples") + u":"_s, this);
+    m_pregenerate->setToolTip(tr("Upcoming tracks are generated first. Generation is paused if playback stutters."));
+
     const QString numSamplesTip{tr("Number of samples (per channel) to use \n"
                                    "for waveform data. Higher values will result \n"
                                    "in a more accurate and detailed waveform at the \n"
                                    "cost of using more disk space in the cache.")};
 
-    m_numSamples->addItem(QString::number(2048));
-    m_numSamples->addItem(QString::number(4096));
+    for(const int samples : {2048, 4096, 8192, 16384}) {
+        m_numSamples->addItem(QString::number(samples), samples);
+    }
 
     numSamplesLabel->setToolTip(numSamplesTip);
     m_numSamples->setToolTip(numSamplesTip);
@@ -203,6 +208,7 @@ WaveBarSettingsPageWidget::WaveBarSettingsPageWidget(SettingsManager* settings)
     generalGroupLayout->addWidget(m_numSamples, 0, 1);
     generalGroupLayout->addWidget(m_cacheSizeLabel, 1, 0);
     generalGroupLayout->addWidget(clearCacheButton, 1, 1);
+    generalGroupLayout->addWidget(m_pregenerate, 2, 0, 1, 3);
     generalGroupLayout->setColumnStretch(2, 1);
 
     row = 0;
@@ -243,7 +249,8 @@ void WaveBarSettingsPageWidget::load()
 
     updateCacheSize();
     const int samples = m_settings->value<Settings::WaveBar::NumSamples>();
-    m_numSamples->setCurrentIndex(samples == 2048 ? 0 : 1);
+    m_numSamples->setCurrentIndex(std::max(0, m_numSamples->findData(samples)));
+    m_pregenerate->setChecked(m_settings->value<Settings::WaveBar::Pregenerate>());
 }
 
 void WaveBarSettingsPageWidget::apply()
@@ -279,8 +286,9 @@ void WaveBarSettingsPageWidget::apply()
         mode |= WaveMode::Silence;
     }
     m_settings->set<Settings::WaveBar::Mode>(static_cast<int>(mode));
+    m_settings->set<Settings::WaveBar::Pregenerate>(m_pregenerate->isChecked());
 
-    if(m_settings->set<Settings::WaveBar::NumSamples>(m_numSamples->currentIndex() == 0 ? 2048 : 4096)) {
+    if(m_settings->set<Settings::WaveBar::NumSamples>(m_numSamples->currentData().toInt())) {
         emit clearCache();
         updateCacheSize();
     }
@@ -298,6 +306,7 @@ void WaveBarSettingsPageWidget::reset()
     m_settings->reset<Settings::WaveBar::ChannelScale>();
     m_settings->reset<Settings::WaveBar::Mode>();
     m_settings->reset<Settings::WaveBar::NumSamples>();
+    m_settings->reset<Settings::WaveBar::Pregenerate>();
 }
 
 void WaveBarSettingsPageWidget::updateCacheSize()
@@ -69,6 +69,11 @@ QByteArray serialiseData(const WaveformData<int16_t>& data)
 
     stream << data.channelData;
 
+    stream << static_cast<quint32>(data.levels.size());
+    for(const auto& level : data.levels) {
+        stream << level;
+    }
+
     out = qCompress(out, 9);
 
     return out;
@@ -81,6 +86,23 @@ void deserialiseData(const QByteArray& cacheData, WaveformData<int16_t>& data)
     stream.setVersion(QDataStream::Qt_6_0);
 
     stream >> data.channelData;
+
+    // Entries cached before the mip-pyramid was stored end here
+    if(stream.atEnd()) {
+        return;
+    }
+
+    quint32 levelCount;
+    stream >> levelCount;
+
+    data.levels.resize(levelCount);
+    for(auto& level : data.levels) {
+        stream >> level;
+    }
+
+    if(stream.status() != QDataStream::Ok) {
+        data.levels.clear();
+    }
 }
 } // namespace
 
@@ -24,7 +24,9 @@
 #include "settings/wavebarsettingspage.h"
 #include "wavebarconstants.h"
 #include "wavebarwidget.h"
+#include "waveformanalysisstage.h"
 #include "waveformbuilder.h"
+#include "waveformpregenerator.h"
 
 #include <core/engine/enginecontroller.h>
 #include <core/player/playercontroller.h>
@@ -62,13 +64,16 @@ WaveBarPlugin::WaveBarPlugin()
 
 WaveBarPlugin::~WaveBarPlugin()
 {
+    m_pregenerator.reset();
     m_waveBuilder.reset();
 }
 
 void WaveBarPlugin::initialise(const CorePluginContext& context)
 {
     m_playerController = context.playerController;
+    m_playlistHandler  = context.playlistHandler;
     m_engine           = context.engine;
+    m_libraryAnalyser  = context.libraryAnalyser;
     m_audioLoader      = context.audioLoader;
     m_settings         = context.settingsManager;
 
@@ -91,6 +96,15 @@ void WaveBarPlugin::initialise(const GuiPluginContext& context)
     m_waveBarSettingsPage    = std::make_unique<WaveBarSettingsPage>(m_settings);
     m_waveBarGuiSettingsPage = std::make_unique<WaveBarGuiSettingsPage>(m_settings);
 
+    m_analysisStage
+        = std::make_shared<WaveformAnalysisStage>(m_dbPool, m_settings->value<Settings::WaveBar::NumSamples>());
+    m_libraryAnalyser->addStage(m_analysisStage);
+    m_settings->subscribe<Settings::WaveBar::NumSamples>(
+        this, [this](const int samples) { m_analysisStage->setSamplesPerChannel(samples); });
+
+    m_pregenerator = std::make_unique<WaveformPregenerator>(m_audioLoader, m_dbPool, m_playlistHandler,
+                                                            m_playerController, m_settings);
+
     QObject::connect(m_waveBarSettingsPage.get(), &WaveBarSettingsPage::clearCache, this, &WaveBarPlugin::clearCache);
 
     m_widgetProvider->registerWidget(u"WaveBar"_s, [this]() { return createWavebar(); }, tr("Waveform Seekbar"));
@@ -219,6 +233,10 @@ void WaveBarPlugin::clearCache() const
     if(!waveDb.clearCache()) {
         qCWarning(WAVEBAR) << "Unable to clear waveform cache";
     }
+
+    if(m_pregenerator) {
+        m_pregenerator->reset();
+    }
 }
 } // namespace Fooyin::WaveBar
 
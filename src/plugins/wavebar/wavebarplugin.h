@@ -32,7 +32,9 @@ namespace WaveBar {
 class WaveBarSettings;
 class WaveBarSettingsPage;
 class WaveBarGuiSettingsPage;
+class WaveformAnalysisStage;
 class WaveformBuilder;
+class WaveformPregenerator;
 
 class WaveBarPlugin : public QObject,
                       public Plugin,
@@ -60,7 +62,9 @@ private:
 
     ActionManager* m_actionManager;
     PlayerController* m_playerController;
+    PlaylistHandler* m_playlistHandler;
     EngineController* m_engine;
+    LibraryAnalyser* m_libraryAnalyser;
     std::shared_ptr<AudioLoader> m_audioLoader;
     TrackSelectionController* m_trackSelection;
     WidgetProvider* m_widgetProvider;
@@ -69,6 +73,8 @@ private:
     Track m_playingTrack;
     DbConnectionPoolPtr m_dbPool;
     std::unique_ptr<WaveformBuilder> m_waveBuilder;
+    std::unique_ptr<WaveformPregenerator> m_pregenerator;
+    std::shared_ptr<WaveformAnalysisStage> m_analysisStage;
 
     std::unique_ptr<WaveBarSettings> m_waveBarSettings;
     std::unique_ptr<WaveBarSettingsPage> m_waveBarSettingsPage;
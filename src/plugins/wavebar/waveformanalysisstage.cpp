@@ -0,0 +1,243 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "waveformanalysisstage.h"
+
+#include "wavebardatabase.h"
+#include "waveformdata.h"
+#include "waveformgenerator.h"
+
+#include <utils/audioutils.h>
+#include <utils/database/dbconnectionhandler.h>
+#include <utils/database/dbconnectionprovider.h>
+
+using namespace Qt::StringLiterals;
+
+// Blocks accumulated for each entry of the expected length, so a track decoding to a different length
+// than its tags say can still be split evenly into entries once the real length is known
+constexpr auto BlocksPerEntry = 8;
+
+namespace {
+class WaveformAnalysis : public Fooyin::TrackAnalysis
+{
+public:
+    WaveformAnalysis(Fooyin::DbConnectionPoolPtr dbPool, const Fooyin::AudioFormat& format, uint64_t duration,
+                     int samplesPerChannel)
+        : m_dbPool{std::move(dbPool)}
+        , m_samplesPerChannel{samplesPerChannel}
+        , m_blockFrames{1}
+        , m_currentFrames{0}
+        , m_totalFrames{0}
+    {
+        m_data.format            = format;
+        m_data.channels          = format.channelCount();
+        m_data.samplesPerChannel = samplesPerChannel;
+        m_data.channelData.resize(m_data.channels);
+
+        const auto expectedFrames = static_cast<int64_t>(duration) * format.sampleRate() / 1000;
+        const auto expectedBlocks = static_cast<int64_t>(samplesPerChannel) * BlocksPerEntry;
+        m_blockFrames             = std::max<int64_t>(1, expectedFrames / expectedBlocks);
+
+        m_current.assign(m_data.channels, {});
+    }
+
+    void process(std::span<const float> samples) override
+    {
+        const int channels = m_data.channels;
+        const auto frames  = static_cast<int>(samples.size() / static_cast<size_t>(channels));
+        const auto* data   = samples.data();
+
+        int frame{0};
+        while(frame < frames) {
+            const auto count = static_cast<int>(std::min<int64_t>(frames - frame, m_blockFrames - m_currentFrames));
+            const std::span<const float> block{data + (static_cast<ptrdiff_t>(frame) * channels),
+                                               static_cast<size_t>(count) * channels};
+            Fooyin::Audio::accumulateFrames(block, channels, m_current);
+
+            frame += count;
+            m_currentFrames += count;
+            m_totalFrames += count;
+
+            if(m_currentFrames >= m_blockFrames) {
+                addBlock();
+            }
+        }
+    }
+
+    bool finish(Fooyin::Track& track) override
+    {
+        if(m_currentFrames > 0) {
+            addBlock();
+        }
+        if(m_totalFrames == 0) {
+            return false;
+        }
+
+        buildEntries();
+
+        // The duration comes from what was decoded, while the key must match the (possibly corrected)
+        // duration of the track the seekbar will look up
+        m_data.duration = static_cast<uint64_t>(m_totalFrames * 1000 / m_data.format.sampleRate());
+        m_data.complete = true;
+        m_data.buildLevels();
+
+        const QString key = Fooyin::WaveBar::WaveBarDatabase::cacheKey(track, m_data.channels);
+
+        const Fooyin::DbConnectionHandler handler{m_dbPool};
+        Fooyin::WaveBar::WaveBarDatabase waveDb;
+        waveDb.initialise(Fooyin::DbConnectionProvider{m_dbPool});
+
+        if(!waveDb.storeInCache(key, Fooyin::WaveBar::cacheData(m_data))) {
+            qCWarning(WAVEBAR) << "Unable to store waveform data";
+        }
+
+        // Waveforms are stored separately from the track
+        return false;
+    }
+
+private:
+    struct Block
+    {
+        int64_t frames{0};
+        std::vector<Fooyin::Audio::ChannelStats> stats;
+    };
+
+    static void combine(std::vector<Fooyin::Audio::ChannelStats>& into,
+                        const std::vector<Fooyin::Audio::ChannelStats>& stats)
+    {
+        for(size_t ch{0}; ch < into.size(); ++ch) {
+            into[ch].min = std::min(into[ch].min, stats[ch].min);
+            into[ch].max = std::max(into[ch].max, stats[ch].max);
+            into[ch].sumSquares += stats[ch].sumSquares;
+        }
+    }
+
+    void addBlock()
+    {
+        m_blocks.push_back({.frames = m_currentFrames, .stats = m_current});
+        m_current.assign(m_data.channels, {});
+        m_currentFrames = 0;
+
+        // Longer than expected, so halve the resolution of everything decoded so far
+        if(std::cmp_greater_equal(m_blocks.size(), 2 * m_samplesPerChannel * BlocksPerEntry)) {
+            std::vector<Block> merged;
+            merged.reserve((m_blocks.size() + 1) / 2);
+
+            for(size_t i{0}; i < m_blocks.size(); i += 2) {
+                Block block{std::move(m_blocks[i])};
+                if(i + 1 < m_blocks.size()) {
+                    block.frames += m_blocks[i + 1].frames;
+                    combine(block.stats, m_blocks[i + 1].stats);
+                }
+                merged.push_back(std::move(block));
+            }
+
+            m_blocks = std::move(merged);
+            m_blockFrames *= 2;
+        }
+    }
+
+    void buildEntries()
+    {
+        const int64_t framesPerEntry = std::max<int64_t>(1, m_totalFrames / m_samplesPerChannel);
+
+        Block entry{.frames = 0, .stats = std::vector<Fooyin::Audio::ChannelStats>(m_data.channels)};
+
+        const auto addEntry = [this, &entry]() {
+            for(int ch{0}; ch < m_data.channels; ++ch) {
+                const auto& stats = entry.stats.at(ch);
+                const auto rms    = std::sqrt(stats.sumSquares / static_cast<double>(entry.frames));
+
+                auto& [cMax, cMin, cRms] = m_data.channelData.at(ch);
+                cMax.emplace_back(stats.max);
+                cMin.emplace_back(stats.min);
+                cRms.emplace_back(static_cast<float>(rms));
+            }
+
+            entry.frames = 0;
+            entry.stats.assign(m_data.channels, {});
+        };
+
+        for(const Block& block : m_blocks) {
+            entry.frames += block.frames;
+            combine(entry.stats, block.stats);
+
+            if(entry.frames >= framesPerEntry) {
+                addEntry();
+            }
+        }
+
+        if(entry.frames > 0) {
+            addEntry();
+        }
+
+        m_blocks.clear();
+    }
+
+    Fooyin::DbConnectionPoolPtr m_dbPool;
+    int m_samplesPerChannel;
+    Fooyin::WaveBar::WaveformData<float> m_data;
+
+    std::vector<Block> m_blocks;
+    std::vector<Fooyin::Audio::ChannelStats> m_current;
+    int64_t m_blockFrames;
+    int64_t m_currentFrames;
+    int64_t m_totalFrames;
+};
+} // namespace
+
+namespace Fooyin::WaveBar {
+WaveformAnalysisStage::WaveformAnalysisStage(DbConnectionPoolPtr dbPool, int samplesPerChannel)
+    : m_dbPool{std::move(dbPool)}
+    , m_samplesPerChannel{samplesPerChannel}
+{
+    const DbConnectionHandler handler{m_dbPool};
+    WaveBarDatabase waveDb;
+    waveDb.initialise(DbConnectionProvider{m_dbPool});
+    waveDb.initialiseDatabase();
+}
+
+void WaveformAnalysisStage::setSamplesPerChannel(int samples)
+{
+    m_samplesPerChannel.store(samples, std::memory_order_relaxed);
+}
+
+QString WaveformAnalysisStage::name() const
+{
+    return u"Waveform"_s;
+}
+
+std::unique_ptr<TrackAnalysis> WaveformAnalysisStage::analyse(const Track& track, const AudioFormat& format)
+{
+    if(!format.isValid() || format.channelCount() <= 0 || track.duration() == 0) {
+        return nullptr;
+    }
+
+    const DbConnectionHandler handler{m_dbPool};
+    WaveBarDatabase waveDb;
+    waveDb.initialise(DbConnectionProvider{m_dbPool});
+
+    if(waveDb.existsInCache(WaveBarDatabase::cacheKey(track, format.channelCount()))) {
+        return nullptr;
+    }
+
+    return std::make_unique<WaveformAnalysis>(m_dbPool, format, track.duration(),
+                                              m_samplesPerChannel.load(std::memory_order_relaxed));
+}
+} // namespace Fooyin::WaveBar
@@ -0,0 +1,47 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <core/library/libraryanalyser.h>
+#include <utils/database/dbconnectionpool.h>
+
+#include <atomic>
+
+namespace Fooyin::WaveBar {
+/*!
+ * Generates and caches waveforms for new library tracks as part of the library's post-scan analysis,
+ * sharing the decode with any other analysis stages.
+ * Tracks which already have a cached waveform are skipped.
+ */
+class WaveformAnalysisStage : public AnalysisStage
+{
+public:
+    WaveformAnalysisStage(DbConnectionPoolPtr dbPool, int samplesPerChannel);
+
+    void setSamplesPerChannel(int samples);
+
+    [[nodiscard]] QString name() const override;
+    [[nodiscard]] std::unique_ptr<TrackAnalysis> analyse(const Track& track, const AudioFormat& format) override;
+
+private:
+    DbConnectionPoolPtr m_dbPool;
+    std::atomic<int> m_samplesPerChannel;
+};
+} // namespace Fooyin::WaveBar
@@ -21,6 +21,8 @@
 
 #include <core/engine/audioformat.h>
 
+#include <algorithm>
+#include <cmath>
 #include <tuple>
 #include <vector>
 
@@ -58,12 +60,14 @@ struct WaveformData
         }
     };
     std::vector<ChannelData> channelData;
+    // Mip-pyramid of channelData: level n holds one entry per 2^(n + 1) samples
+    std::vector<std::vector<ChannelData>> levels;
 
     bool operator==(const WaveformData<T>& other) const noexcept
     {
-        return std::tie(format, duration, channels, complete, samplesPerChannel, channelData)
+        return std::tie(format, duration, channels, complete, samplesPerChannel, channelData, levels)
             == std::tie(other.format, other.duration, other.channels, other.complete, other.samplesPerChannel,
-                        other.channelData);
+                        other.channelData, other.levels);
     }
 
     bool operator!=(const WaveformData<T>& other) const noexcept
@@ -84,5 +88,61 @@ struct WaveformData
 
         return static_cast<int>(channelData.front().max.size());
     }
+
+    /*!
+     * Returns the channel data with at most @p samplesPerEntry samples combined into each entry,
+     * and sets @p samplesPerEntry to the actual number.
+     */
+    [[nodiscard]] const std::vector<ChannelData>& levelFor(int& samplesPerEntry) const
+    {
+        int levelSamples{1};
+        const std::vector<ChannelData>* level = &channelData;
+
+        for(const auto& nextLevel : levels) {
+            if(levelSamples * 2 > samplesPerEntry) {
+                break;
+            }
+            levelSamples *= 2;
+            level = &nextLevel;
+        }
+
+        samplesPerEntry = levelSamples;
+        return *level;
+    }
+
+    /*!
+     * Builds the mip-pyramid from channelData by repeatedly combining pairs of entries.
+     * @note Only valid for floating point data, as rms values are combined as a quadratic mean.
+     */
+    void buildLevels()
+    {
+        levels.clear();
+
+        const std::vector<ChannelData>* previous = &channelData;
+
+        while(!previous->empty() && previous->front().max.size() > 1) {
+            std::vector<ChannelData> level(previous->size());
+
+            for(size_t ch{0}; ch < previous->size(); ++ch) {
+                const auto& [inMax, inMin, inRms] = previous->at(ch);
+                auto& [outMax, outMin, outRms]    = level.at(ch);
+
+                const size_t count = (inMax.size() + 1) / 2;
+                outMax.reserve(count);
+                outMin.reserve(count);
+                outRms.reserve(count);
+
+                for(size_t i{0}; i < inMax.size(); i += 2) {
+                    const size_t next = std::min(i + 1, inMax.size() - 1);
+                    outMax.push_back(std::max(inMax[i], inMax[next]));
+                    outMin.push_back(std::min(inMin[i], inMin[next]));
+                    outRms.push_back(std::sqrt(((inRms[i] * inRms[i]) + (inRms[next] * inRms[next])) / 2));
+                }
+            }
+
+            levels.push_back(std::move(level));
+            previous = &levels.back();
+        }
+    }
 };
 } // namespace Fooyin::WaveBar
@@ -21,6 +21,8 @@
 
 #include <core/engine/audioconverter.h>
 #include <core/engine/audioloader.h>
+#include <utils/audioutils.h>
+#include <utils/ioscheduler.h>
 #include <utils/math.h>
 #include <utils/paths.h>
 
@@ -32,6 +34,9 @@
 
 Q_LOGGING_CATEGORY(WAVEBAR, "fy.wavebar")
 
+// Number of frames processed between cancellation checks
+constexpr auto BlockFrames = 16384;
+
 namespace {
 float convertSampleToFloat(const int16_t inSample)
 {
@@ -55,46 +60,49 @@ int16_t convertSampleToInt16(const float inSample)
 }
 
 template <typename OutputType, typename InputType>
-Fooyin::WaveBar::WaveformData<OutputType> convertCache(const Fooyin::WaveBar::WaveformData<InputType>& cacheData)
+std::vector<OutputType> convertSamples(const std::vector<InputType>& samples)
 {
-    Fooyin::WaveBar::WaveformData<OutputType> data;
-    const size_t channels = cacheData.channelData.size();
-    data.channelData.resize(channels);
+    std::vector<OutputType> output;
+    output.reserve(samples.size());
 
-    for(size_t channel{0}; channel < channels; ++channel) {
-        auto& inChannelData  = cacheData.channelData[channel];
-        auto& outChannelData = data.channelData[channel];
-
-        outChannelData.max.reserve(inChannelData.max.size());
-        outChannelData.min.reserve(inChannelData.min.size());
-        outChannelData.rms.reserve(inChannelData.rms.size());
-
-        for(const auto& sample : inChannelData.max) {
-            if constexpr(std::is_same_v<InputType, int16_t>) {
-                outChannelData.max.emplace_back(convertSampleToFloat(sample));
-            }
-            else {
-                outChannelData.max.emplace_back(convertSampleToInt16(sample));
-            }
-        }
-        for(const auto& sample : inChannelData.min) {
-            if constexpr(std::is_same_v<InputType, int16_t>) {
-                outChannelData.min.emplace_back(convertSampleToFloat(sample));
-            }
-            else {
-                outChannelData.min.emplace_back(convertSampleToInt16(sample));
-            }
+    for(const auto& sample : samples) {
+        if constexpr(std::is_same_v<InputType, int16_t>) {
+            output.emplace_back(convertSampleToFloat(sample));
         }
-        for(const auto& sample : inChannelData.rms) {
-            if constexpr(std::is_same_v<InputType, int16_t>) {
-                outChannelData.rms.emplace_back(convertSampleToFloat(sample));
-            }
-            else {
-                outChannelData.rms.emplace_back(convertSampleToInt16(sample));
-            }
+        else {
+            output.emplace_back(convertSampleToInt16(sample));
         }
     }
 
+    return output;
+}
+
+template <typename OutputType, typename InputType>
+std::vector<typename Fooyin::WaveBar::WaveformData<OutputType>::ChannelData>
+convertChannels(const std::vector<typename Fooyin::WaveBar::WaveformData<InputType>::ChannelData>& channels)
+{
+    std::vector<typename Fooyin::WaveBar::WaveformData<OutputType>::ChannelData> output;
+    output.reserve(channels.size());
+
+    for(const auto& channel : channels) {
+        output.push_back({convertSamples<OutputType>(channel.max), convertSamples<OutputType>(channel.min),
+                          convertSamples<OutputType>(channel.rms)});
+    }
+
+    return output;
+}
+
+template <typename OutputType, typename InputType>
+Fooyin::WaveBar::WaveformData<OutputType> convertCache(const Fooyin::WaveBar::WaveformData<InputType>& cacheData)
+{
+    Fooyin::WaveBar::WaveformData<OutputType> data;
+    data.channelData = convertChannels<OutputType, InputType>(cacheData.channelData);
+
+    data.levels.reserve(cacheData.levels.size());
+    for(const auto& level : cacheData.levels) {
+        data.levels.push_back(convertChannels<OutputType, InputType>(level));
+    }
+
     return data;
 }
 } // namespace
@@ -136,9 +144,14 @@ void WaveformGenerator::generate(const Track& track, int samplesPerChannel, bool
         if(render) {
             WaveformData<int16_t> data;
             if(m_waveDb.loadCachedData(trackKey, data)) {
-                const auto floatData = convertCache<float>(data);
-                m_data.channelData   = floatData.channelData;
-                m_data.complete      = true;
+                auto floatData     = convertCache<float>(data);
+                m_data.channelData = std::move(floatData.channelData);
+                m_data.levels      = std::move(floatData.levels);
+                m_data.complete    = true;
+                if(m_data.levels.empty()) {
+                    // Cached before levels were stored
+                    m_data.buildLevels();
+                }
 
                 setState(Idle);
                 emit waveformGenerated(track, m_data);
@@ -151,6 +164,17 @@ void WaveformGenerator::generate(const Track& track, int samplesPerChannel, bool
         return;
     }
 
+    const auto cancelled = [this]() {
+        return !mayRun();
+    };
+
+    // The seekbar is waiting on a rendered waveform, so it shouldn't queue behind background work
+    const auto priority = render ? IoScheduler::Priority::Interactive : IoScheduler::Priority::Background;
+    auto lease          = IoScheduler::instance()->acquire(track.filepath(), priority, cancelled);
+    if(!lease.isValid()) {
+        return;
+    }
+
     emit generatingWaveform();
 
     const int bps               = m_format.bytesPerFrame();
@@ -170,7 +194,7 @@ void WaveformGenerator::generate(const Track& track, int samplesPerChannel, bool
     m_decoder->seek(track.offset());
 
     while(true) {
-        if(!mayRun()) {
+        if(!mayRun() || !lease.yield(cancelled)) {
             m_decoder->stop();
             return;
         }
@@ -204,6 +228,8 @@ void WaveformGenerator::generate(const Track& track, int samplesPerChannel, bool
 
     m_decoder->stop();
 
+    m_data.buildLevels();
+
     if(!m_waveDb.storeInCache(trackKey, convertCache<int16_t>(m_data))) {
         qCWarning(WAVEBAR) << "Unable to store waveform for track:" << m_track.filepath();
     }
@@ -267,40 +293,40 @@ QString WaveformGenerator::setup(const Track& track, int samplesPerChannel)
 
 void WaveformGenerator::processBuffer(const AudioBuffer& buffer)
 {
-    const int bps         = buffer.format().bytesPerSample();
-    const int sampleCount = buffer.frameCount();
-    const auto* samples   = buffer.data();
+    const int channels = m_data.channels;
+    const int frames   = buffer.frameCount();
+    if(channels <= 0 || frames <= 0) {
+        return;
+    }
+
+    const auto* samples = reinterpret_cast<const float*>(buffer.data());
+
+    std::vector<Audio::ChannelStats> stats(channels, {.min = 1.0F, .max = -1.0F});
 
-    for(int ch{0}; ch < m_data.channels; ++ch) {
+    for(int frame{0}; frame < frames; frame += BlockFrames) {
         if(!mayRun()) {
             return;
         }
 
-        float max{-1.0};
-        float min{1.0};
-        float rms{0.0};
-
-        for(int i{0}; i < sampleCount; ++i) {
-            if(!mayRun()) {
-                return;
-            }
-
-            const int offset = (i * m_data.channels + ch) * bps;
-            float sample;
-            std::memcpy(&sample, samples + offset, bps);
-
-            max = std::max(max, sample);
-            min = std::min(min, sample);
-            rms += sample * sample;
-        }
+        const int blockFrames = std::min(BlockFrames, frames - frame);
+        const std::span<const float> block{samples + (static_cast<ptrdiff_t>(frame) * channels),
+                                           static_cast<size_t>(blockFrames) * channels};
+        Audio::accumulateFrames(block, channels, stats);
+    }
 
-        rms /= static_cast<float>(sampleCount);
-        rms = std::sqrt(rms);
+    for(int ch{0}; ch < channels; ++ch) {
+        const auto& channelStats = stats.at(ch);
+        const auto rms           = std::sqrt(channelStats.sumSquares / static_cast<double>(frames));
 
         auto& [cMax, cMin, cRms] = m_data.channelData.at(ch);
-        cMax.emplace_back(max);
-        cMin.emplace_back(min);
-        cRms.emplace_back(rms);
+        cMax.emplace_back(channelStats.max);
+        cMin.emplace_back(channelStats.min);
+        cRms.emplace_back(static_cast<float>(rms));
     }
 }
+
+WaveformData<int16_t> cacheData(const WaveformData<float>& data)
+{
+    return convertCache<int16_t>(data);
+}
 } // namespace Fooyin::WaveBar
@@ -69,5 +69,8 @@ private:
     int m_samplesPerChannel;
     WaveformData<float> m_data;
 };
+
+/** Converts @p data to the 16-bit form stored in the cache. */
+WaveformData<int16_t> cacheData(const WaveformData<float>& data);
 } // namespace WaveBar
 } // namespace Fooyin
@@ -0,0 +1,324 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "waveformpregenerator.h"
+
+#include "settings/wavebarsettings.h"
+
+#include <core/player/playercontroller.h>
+#include <core/playlist/playlisthandler.h>
+#include <utils/settings/settingsmanager.h>
+
+#include <QTimerEvent>
+
+#include <algorithm>
+#include <utility>
+
+using namespace std::chrono_literals;
+
+constexpr auto MaxWorkers       = 2;
+constexpr auto RebuildDelay     = 1s;
+constexpr auto DispatchInterval = 250ms;
+constexpr auto PlaybackInterval = 1s;
+// Combined read rate of all workers once a track has been decoded
+constexpr auto MaxBytesPerSecond = 8 * 1024 * 1024;
+// Time to wait after playback stutters before resuming
+constexpr auto StutterCooldown = 30s;
+// Playback is considered to have stuttered if it advances less than this fraction of wall time
+constexpr auto StutterRatio = 0.75;
+
+namespace Fooyin::WaveBar {
+WaveformPregenerator::GeneratorSlot::GeneratorSlot(std::shared_ptr<AudioLoader> audioLoader, DbConnectionPoolPtr dbPool)
+    : generator{std::move(audioLoader), std::move(dbPool)}
+{
+    generator.moveToThread(&thread);
+    thread.start(QThread::LowestPriority);
+    QMetaObject::invokeMethod(&generator, &Worker::initialiseThread);
+}
+
+WaveformPregenerator::GeneratorSlot::~GeneratorSlot()
+{
+    generator.closeThread();
+    thread.quit();
+    thread.wait();
+}
+
+WaveformPregenerator::WaveformPregenerator(std::shared_ptr<AudioLoader> audioLoader, DbConnectionPoolPtr dbPool,
+                                           PlaylistHandler* playlistHandler, PlayerController* playerController,
+                                           SettingsManager* settings, QObject* parent)
+    : QObject{parent}
+    , m_audioLoader{std::move(audioLoader)}
+    , m_dbPool{std::move(dbPool)}
+    , m_playlistHandler{playlistHandler}
+    , m_playerController{playerController}
+    , m_settings{settings}
+    , m_pool{0}
+    , m_lastPosition{0}
+    , m_paused{false}
+{
+    const auto activeChanged = [this](Playlist* playlist) {
+        if(playlist && playlist == m_playlistHandler->activePlaylist()) {
+            scheduleRebuild();
+        }
+    };
+
+    QObject::connect(m_playlistHandler, &PlaylistHandler::activePlaylistChanged, this,
+                     &WaveformPregenerator::scheduleRebuild);
+    QObject::connect(m_playlistHandler, &PlaylistHandler::tracksAdded, this, activeChanged);
+    QObject::connect(m_playlistHandler, &PlaylistHandler::tracksChanged, this, activeChanged);
+    QObject::connect(m_playlistHandler, &PlaylistHandler::tracksRemoved, this, activeChanged);
+    QObject::connect(m_playerController, &PlayerController::currentTrackChanged, this,
+                     &WaveformPregenerator::scheduleRebuild);
+    QObject::connect(m_playerController, &PlayerController::positionMoved, this, [this](uint64_t ms) {
+        m_lastPosition = ms;
+        m_playbackClock.restart();
+    });
+
+    m_settings->subscribe<Settings::WaveBar::Pregenerate>(this, &WaveformPregenerator::setEnabled);
+
+    setEnabled(m_settings->value<Settings::WaveBar::Pregenerate>());
+}
+
+WaveformPregenerator::~WaveformPregenerator() = default;
+
+void WaveformPregenerator::reset()
+{
+    m_generated.clear();
+    scheduleRebuild();
+}
+
+void WaveformPregenerator::timerEvent(QTimerEvent* event)
+{
+    if(event->timerId() == m_rebuildTimer.timerId()) {
+        m_rebuildTimer.stop();
+        rebuildQueue();
+        dispatch();
+    }
+    else if(event->timerId() == m_dispatchTimer.timerId()) {
+        dispatch();
+    }
+    else if(event->timerId() == m_playbackTimer.timerId()) {
+        checkPlayback();
+    }
+
+    QObject::timerEvent(event);
+}
+
+void WaveformPregenerator::setEnabled(bool enabled)
+{
+    if(!enabled) {
+        m_rebuildTimer.stop();
+        m_dispatchTimer.stop();
+        m_playbackTimer.stop();
+        m_queue.clear();
+        m_slots.clear();
+        // Drop any results still queued from the old pool
+        ++m_pool;
+        return;
+    }
+
+    if(!m_slots.empty()) {
+        return;
+    }
+
+    const int workers = std::clamp(QThread::idealThreadCount() / 4, 1, MaxWorkers);
+    for(int i{0}; i < workers; ++i) {
+        auto& slot = m_slots.emplace_back(std::make_unique<GeneratorSlot>(m_audioLoader, m_dbPool));
+        QObject::connect(&slot->generator, &WaveformGenerator::generatingWaveform, this,
+                         [this, pool = m_pool, target = slot.get()]() {
+                             if(pool == m_pool) {
+                                 target->decoded = true;
+                             }
+                         });
+    }
+
+    m_lastPosition = m_playerController->currentPosition();
+    m_playbackClock.start();
+    m_playbackTimer.start(PlaybackInterval, this);
+
+    scheduleRebuild();
+}
+
+void WaveformPregenerator::scheduleRebuild()
+{
+    if(!m_slots.empty()) {
+        m_rebuildTimer.start(RebuildDelay, this);
+    }
+}
+
+void WaveformPregenerator::rebuildQueue()
+{
+    m_queue.clear();
+
+    const Playlist* playlist = m_playlistHandler->activePlaylist();
+    if(!playlist) {
+        return;
+    }
+
+    const TrackList tracks = playlist->tracks();
+    const auto count       = static_cast<int>(tracks.size());
+    if(count == 0) {
+        return;
+    }
+
+    // The playing track is already handled by the waveform seekbar
+    const Track currentTrack = m_playerController->currentTrack();
+    const int currentIndex   = std::clamp(playlist->currentTrackIndex(), -1, count - 1);
+
+    QSet<QString> queued;
+    for(const auto& slot : m_slots) {
+        if(slot->busy) {
+            queued.insert(WaveBarDatabase::cacheKey(slot->track));
+        }
+    }
+
+    // Upcoming tracks first, then wrap around to those before the current track
+    for(int i{1}; i <= count; ++i) {
+        const Track& track = tracks.at((currentIndex + i) % count);
+        if(!track.isValid() || track == currentTrack) {
+            continue;
+        }
+        const QString key = WaveBarDatabase::cacheKey(track);
+        if(m_generated.contains(key) || queued.contains(key)) {
+            continue;
+        }
+        queued.insert(key);
+        m_queue.push_back(track);
+    }
+}
+
+void WaveformPregenerator::dispatch()
+{
+    if(m_paused) {
+        if(m_pausedClock.elapsed() < std::chrono::milliseconds{StutterCooldown}.count()) {
+            return;
+        }
+        m_paused = false;
+    }
+
+    bool waiting{false};
+
+    for(const auto& slot : m_slots) {
+        if(m_queue.empty()) {
+            break;
+        }
+        if(slot->busy) {
+            continue;
+        }
+        if(slot->throttle.isValid() && slot->throttle.elapsed() < slot->throttleMs) {
+            waiting = true;
+            continue;
+        }
+
+        slot->track   = m_queue.front();
+        slot->busy    = true;
+        slot->decoded = false;
+        slot->aborted = false;
+        m_queue.pop_front();
+
+        const Track track     = slot->track;
+        const int samples     = m_settings->value<Settings::WaveBar::NumSamples>();
+        GeneratorSlot* target = slot.get();
+
+        QMetaObject::invokeMethod(&slot->generator, [this, pool = m_pool, target, track, samples]() {
+            target->generator.generate(track, samples, false);
+            QMetaObject::invokeMethod(this, [this, pool, target]() {
+                if(pool == m_pool) {
+                    finishJob(target);
+                }
+            });
+        });
+    }
+
+    if(waiting) {
+        m_dispatchTimer.start(DispatchInterval, this);
+    }
+    else {
+        m_dispatchTimer.stop();
+    }
+}
+
+void WaveformPregenerator::finishJob(GeneratorSlot* slot)
+{
+    slot->busy = false;
+
+    if(slot->aborted) {
+        // Stopped because of a stutter; try again once playback has settled
+        m_queue.push_front(slot->track);
+    }
+    else {
+        m_generated.insert(WaveBarDatabase::cacheKey(slot->track));
+    }
+
+    if(slot->decoded) {
+        // Spread the next read out so the combined rate of all workers stays below the limit
+        const auto workers = static_cast<int64_t>(m_slots.size());
+        slot->throttleMs   = static_cast<int64_t>(slot->track.fileSize()) * workers * 1000 / MaxBytesPerSecond;
+        slot->throttle.start();
+    }
+    else {
+        slot->throttleMs = 0;
+        slot->throttle.invalidate();
+    }
+
+    slot->track = {};
+    dispatch();
+}
+
+void WaveformPregenerator::checkPlayback()
+{
+    const uint64_t position = m_playerController->currentPosition();
+    const int64_t elapsed   = m_playbackClock.restart();
+    const uint64_t previous = std::exchange(m_lastPosition, position);
+
+    if(m_playerController->playState() != Player::PlayState::Playing || position < previous) {
+        return;
+    }
+
+    if(static_cast<double>(position - previous) < static_cast<double>(elapsed) * StutterRatio) {
+        pause();
+    }
+}
+
+void WaveformPregenerator::pause()
+{
+    const bool active = std::ranges::any_of(m_slots, [](const auto& slot) { return slot->busy; });
+    if(!active && m_queue.empty()) {
+        return;
+    }
+
+    if(!m_paused) {
+        qCInfo(WAVEBAR) << "Playback stuttered; pausing waveform pre-generation";
+    }
+
+    m_paused = true;
+    m_pausedClock.start();
+
+    for(const auto& slot : m_slots) {
+        if(slot->busy) {
+            slot->aborted = true;
+            slot->generator.stopThread();
+        }
+    }
+
+    m_dispatchTimer.start(DispatchInterval, this);
+}
+} // namespace Fooyin::WaveBar
+
+#include "moc_waveformpregenerator.cpp"
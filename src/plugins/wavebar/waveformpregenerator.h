@@ -0,0 +1,112 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "waveformgenerator.h"
+
+#include <core/track.h>
+#include <utils/database/dbconnectionpool.h>
+
+#include <QBasicTimer>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QSet>
+#include <QThread>
+
+#include <deque>
+
+namespace Fooyin {
+class AudioLoader;
+class Playlist;
+class PlaylistHandler;
+class PlayerController;
+class SettingsManager;
+
+namespace WaveBar {
+/*!
+ * Generates and caches waveforms for the active playlist in the background, so seeking to
+ * any track shows its waveform immediately. The tracks after the current one are generated
+ * first, followed by the rest of the playlist. The queue is rebuilt whenever the playing
+ * track or the active playlist changes.
+ *
+ * Work is spread over a small pool of lowest priority threads. Reads are throttled after each
+ * decoded track, and all work is stopped for a short while if playback appears to stutter.
+ */
+class WaveformPregenerator : public QObject
+{
+    Q_OBJECT
+
+public:
+    WaveformPregenerator(std::shared_ptr<AudioLoader> audioLoader, DbConnectionPoolPtr dbPool,
+                         PlaylistHandler* playlistHandler, PlayerController* playerController,
+                         SettingsManager* settings, QObject* parent = nullptr);
+    ~WaveformPregenerator() override;
+
+    /** Forgets which tracks have been generated, e.g. after the cache has been cleared. */
+    void reset();
+
+protected:
+    void timerEvent(QTimerEvent* event) override;
+
+private:
+    struct GeneratorSlot
+    {
+        GeneratorSlot(std::shared_ptr<AudioLoader> audioLoader, DbConnectionPoolPtr dbPool);
+        ~GeneratorSlot();
+
+        QThread thread;
+        WaveformGenerator generator;
+        Track track;
+        bool busy{false};
+        bool decoded{false};
+        bool aborted{false};
+        QElapsedTimer throttle;
+        int64_t throttleMs{0};
+    };
+
+    void setEnabled(bool enabled);
+    void scheduleRebuild();
+    void rebuildQueue();
+    void dispatch();
+    void finishJob(GeneratorSlot* slot);
+    void checkPlayback();
+    void pause();
+
+    std::shared_ptr<AudioLoader> m_audioLoader;
+    DbConnectionPoolPtr m_dbPool;
+    PlaylistHandler* m_playlistHandler;
+    PlayerController* m_playerController;
+    SettingsManager* m_settings;
+
+    std::vector<std::unique_ptr<GeneratorSlot>> m_slots;
+    std::deque<Track> m_queue;
+    QSet<QString> m_generated;
+
+    QBasicTimer m_rebuildTimer;
+    QBasicTimer m_dispatchTimer;
+    QBasicTimer m_playbackTimer;
+    QElapsedTimer m_playbackClock;
+    QElapsedTimer m_pausedClock;
+    int m_pool;
+    uint64_t m_lastPosition;
+    bool m_paused;
+};
+} // namespace WaveBar
+} // namespace Fooyin
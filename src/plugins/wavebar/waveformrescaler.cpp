@@ -22,32 +22,23 @@
 #include <utils/settings/settingsmanager.h>
 
 namespace {
-int buildSample(Fooyin::WaveBar::WaveformSample& sample, Fooyin::WaveBar::WaveformData<float>& data, int channel,
+using ChannelData = Fooyin::WaveBar::WaveformData<float>::ChannelData;
+
+int buildSample(Fooyin::WaveBar::WaveformSample& sample, const std::vector<ChannelData>& level, int channel,
                 double start, double end)
 {
-    int sampleCount{0};
-
-    auto& [inMax, inMin, inRms] = data.channelData.at(channel);
-
-    const int lastIndex = std::floor(end);
-
-    for(int i = std::floor(start); i < std::ceil(end); ++i) {
-        for(int index{i}; index < lastIndex; ++index) {
-            if(std::cmp_less(index, inMax.size())) {
-                const float sampleMax = inMax.at(index);
-                const float sampleMin = inMin.at(index);
-                const float sampleRms = inRms.at(index);
+    const auto& [inMax, inMin, inRms] = level.at(channel);
 
-                sample.max = std::max(sample.max, sampleMax);
-                sample.min = std::min(sample.min, sampleMin);
-                sample.rms += sampleRms * sampleRms;
+    const auto first = static_cast<size_t>(std::floor(start));
+    const auto last  = std::min(static_cast<size_t>(std::floor(end)), inMax.size());
 
-                ++sampleCount;
-            }
-        }
+    for(size_t index{first}; index < last; ++index) {
+        sample.max = std::max(sample.max, inMax[index]);
+        sample.min = std::min(sample.min, inMin[index]);
+        sample.rms += inRms[index] * inRms[index];
     }
 
-    return sampleCount;
+    return last > first ? static_cast<int>(last - first) : 0;
 }
 } // namespace
 
@@ -83,6 +74,11 @@ void WaveformRescaler::rescale()
         = static_cast<double>(m_data.complete ? m_data.sampleCount() : m_data.samplesPerChannel) * m_sampleWidth;
     const auto samplesPerPixel = sampleSize / m_width;
 
+    // Use the coarsest level which still has at least one entry per pixel, so each pixel only combines a few entries
+    int levelSamples           = std::max(1, static_cast<int>(samplesPerPixel));
+    const auto& level          = m_data.levelFor(levelSamples);
+    const auto entriesPerPixel = samplesPerPixel / levelSamples;
+
     for(int ch{0}; ch < data.channels; ++ch) {
         auto& [outMax, outMin, outRms] = data.channelData.at(ch);
 
@@ -93,18 +89,18 @@ void WaveformRescaler::rescale()
                 return;
             }
 
-            const double end = std::max(1.0, (x + 1) * samplesPerPixel);
+            const double end = std::max(1.0, (x + 1) * entriesPerPixel);
 
             int sampleCount{0};
             WaveformSample sample;
 
             if(m_downMix == DownmixOption::Mono || (m_downMix == DownmixOption::Stereo && m_data.channels > 2)) {
                 for(int mixCh{0}; mixCh < m_data.channels; ++mixCh) {
-                    sampleCount += buildSample(sample, m_data, mixCh, start, end);
+                    sampleCount += buildSample(sample, level, mixCh, start, end);
                 }
             }
             else {
-                sampleCount += buildSample(sample, m_data, ch, start, end);
+                sampleCount += buildSample(sample, level, ch, start, end);
             }
 
             if(sampleCount > 0) {
@@ -138,6 +134,9 @@ void WaveformRescaler::rescale(int width)
 void WaveformRescaler::rescale(const WaveformData<float>& data, int width)
 {
     if(std::exchange(m_data, data) != data) {
+        if(m_data.complete && m_data.levels.empty()) {
+            m_data.buildLevels();
+        }
         rescale(width);
     }
 }
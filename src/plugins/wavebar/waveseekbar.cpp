@@ -23,6 +23,7 @@
 
 #include <core/track.h>
 #include <gui/guisettings.h>
+#include <gui/painttimer.h>
 #include <utils/settings/settingsmanager.h>
 #include <utils/stringutils.h>
 
@@ -182,6 +183,8 @@ void WaveSeekBar::stopSeeking()
 
 void WaveSeekBar::paintEvent(QPaintEvent* event)
 {
+    const PaintTimer paintTimer{"WaveSeekBar"};
+
     QPainter painter{this};
     painter.scale(m_scale, 1.0);
 
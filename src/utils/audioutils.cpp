@@ -20,8 +20,59 @@
 #include <utils/audioutils.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 
+constexpr size_t MaxLanes      = 64;
+constexpr size_t PowerOf2Lanes = 32;
+constexpr size_t SurroundLanes = 24;
+
+namespace {
+/*!
+ * Folds whole blocks of samples into independent lanes, then merges the lanes into @p stats.
+ * Each lane count is a multiple of the channel count, so lane j always holds channel j % channels.
+ * A FixedLanes of 0 uses the largest multiple of the channel count which fits in MaxLanes.
+ * @returns the number of samples processed.
+ */
+template <size_t FixedLanes>
+size_t accumulateLanes(std::span<const float> samples, size_t channels, std::span<Fooyin::Audio::ChannelStats> stats)
+{
+    const size_t laneCount  = FixedLanes > 0 ? FixedLanes : (MaxLanes / channels) * channels;
+    const size_t blockCount = samples.size() / laneCount;
+    if(blockCount == 0) {
+        return 0;
+    }
+
+    constexpr size_t LaneStorage = FixedLanes > 0 ? FixedLanes : MaxLanes;
+
+    std::array<float, LaneStorage> mins;
+    std::array<float, LaneStorage> maxes;
+    std::array<float, LaneStorage> squares;
+    mins.fill(std::numeric_limits<float>::max());
+    maxes.fill(std::numeric_limits<float>::lowest());
+    squares.fill(0.0F);
+
+    const float* data = samples.data();
+    for(size_t block{0}; block < blockCount; ++block, data += laneCount) {
+        for(size_t lane{0}; lane < laneCount; ++lane) {
+            const float sample = data[lane];
+            mins[lane]         = sample < mins[lane] ? sample : mins[lane];
+            maxes[lane]        = sample > maxes[lane] ? sample : maxes[lane];
+            squares[lane] += sample * sample;
+        }
+    }
+
+    for(size_t lane{0}; lane < laneCount; ++lane) {
+        auto& channel = stats[lane % channels];
+        channel.min   = std::min(channel.min, mins[lane]);
+        channel.max   = std::max(channel.max, maxes[lane]);
+        channel.sumSquares += squares[lane];
+    }
+
+    return blockCount * laneCount;
+}
+} // namespace
+
 namespace Fooyin::Audio {
 double dbToVolume(double db)
 {
@@ -35,4 +86,33 @@ double volumeToDb(double volume)
     }
     return 20.0 * std::log10(volume);
 }
+
+void accumulateFrames(std::span<const float> samples, int channels, std::span<ChannelStats> stats)
+{
+    if(channels <= 0 || samples.empty() || stats.size() < static_cast<size_t>(channels)) {
+        return;
+    }
+
+    const auto channelCount = static_cast<size_t>(channels);
+
+    // Fixed lane counts let the compiler fully vectorise the common layouts
+    size_t offset{0};
+    if(PowerOf2Lanes % channelCount == 0) {
+        offset = accumulateLanes<PowerOf2Lanes>(samples, channelCount, stats);
+    }
+    else if(SurroundLanes % channelCount == 0) {
+        offset = accumulateLanes<SurroundLanes>(samples, channelCount, stats);
+    }
+    else if(channelCount <= MaxLanes) {
+        offset = accumulateLanes<0>(samples, channelCount, stats);
+    }
+
+    for(size_t i{offset}; i < samples.size(); ++i) {
+        const float sample    = samples[i];
+        ChannelStats& channel = stats[i % channelCount];
+        channel.min           = std::min(channel.min, sample);
+        channel.max           = std::max(channel.max, sample);
+        channel.sumSquares += static_cast<double>(sample) * sample;
+    }
+}
 } // namespace Fooyin::Audio
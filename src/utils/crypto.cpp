@@ -23,7 +23,70 @@
 #include <QRandomGenerator>
 #include <QUuid>
 
+#include <bit>
+#include <cstring>
+
+namespace {
+constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t Prime3 = 0x165667B19E3779F9ULL;
+
+uint64_t avalanche(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+} // namespace
+
 namespace Fooyin::Utils {
+void FastHash::addData(QByteArrayView data)
+{
+    const auto size = static_cast<uint64_t>(data.size());
+
+    // Mix in the length of each part so ("ab", "c") and ("a", "bc") hash differently
+    round(size);
+
+    const char* ptr = data.data();
+    auto remaining  = data.size();
+
+    while(remaining >= 8) {
+        uint64_t word;
+        std::memcpy(&word, ptr, 8);
+        round(word);
+        ptr += 8;
+        remaining -= 8;
+    }
+
+    if(remaining > 0) {
+        uint64_t word{0};
+        std::memcpy(&word, ptr, static_cast<size_t>(remaining));
+        round(word ^ (static_cast<uint64_t>(remaining) << 56));
+    }
+
+    m_length += size;
+}
+
+QByteArray FastHash::result() const
+{
+    const uint64_t lo = avalanche(m_lo ^ (m_length * Prime3));
+    const uint64_t hi = avalanche(m_hi + lo);
+
+    QByteArray hash(16, Qt::Uninitialized);
+    std::memcpy(hash.data(), &lo, 8);
+    std::memcpy(hash.data() + 8, &hi, 8);
+    return hash;
+}
+
+void FastHash::round(uint64_t word)
+{
+    m_lo = std::rotl(m_lo + (word * Prime2), 31) * Prime1;
+    m_hi = std::rotl(m_hi ^ (word * Prime1), 27) * Prime3 + m_lo;
+}
+
 QString generateUniqueHash()
 {
     return QUuid::createUuid().toString(QUuid::Id128);
@@ -0,0 +1,536 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/ioscheduler.h>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QLoggingCategory>
+#include <QStorageInfo>
+#include <QThread>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <utility>
+
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+Q_LOGGING_CATEGORY(IO_SCHEDULER, "fy.ioscheduler")
+
+using namespace std::chrono_literals;
+using namespace Qt::StringLiterals;
+
+// Interval at which waiting requests check whether they have been cancelled
+constexpr auto CancelInterval  = 100ms;
+// While playback reads from a rotational or network mount, background holders keep it for a slice
+// between yields, after which playback has it to itself for a window
+constexpr auto BackgroundSlice = 250ms;
+constexpr auto PlaybackWindow  = 250ms;
+constexpr auto MaxCachedDirs   = 4096;
+
+namespace {
+struct LocalityKey
+{
+    QString dir;
+    quint64 inode{0};
+
+    bool operator<(const LocalityKey& other) const
+    {
+        const int cmp = dir.compare(other.dir);
+        return cmp < 0 || (cmp == 0 && inode < other.inode);
+    }
+};
+
+LocalityKey localityKey(const QString& path)
+{
+    LocalityKey key{.dir = QFileInfo{path}.absolutePath()};
+
+#ifdef Q_OS_UNIX
+    struct stat info{};
+    if(::stat(QFile::encodeName(path).constData(), &info) == 0) {
+        key.inode = static_cast<quint64>(info.st_ino);
+    }
+#endif
+
+    return key;
+}
+
+bool isNetworkFileSystem(const QByteArray& type)
+{
+    static constexpr std::array NetworkTypes{"nfs",         "nfs4",  "cifs", "smb3", "smbfs", "sshfs",     "fuse.sshfs",
+                                             "fuse.rclone", "davfs", "9p",   "afs",  "ceph",  "glusterfs"};
+
+    return std::ranges::any_of(NetworkTypes, [&type](const char* networkType) { return type == networkType; });
+}
+
+Fooyin::IoScheduler::StorageType detectStorageType(const QStorageInfo& storage)
+{
+    using StorageType = Fooyin::IoScheduler::StorageType;
+
+    if(!storage.isValid()) {
+        return StorageType::Solid;
+    }
+
+    if(isNetworkFileSystem(storage.fileSystemType())) {
+        return StorageType::Network;
+    }
+
+#ifdef Q_OS_LINUX
+    // Resolve e.g. /dev/mapper/root to /dev/dm-0, then check the block device (or parent device for partitions)
+    const QString device = QFileInfo{QFile::decodeName(storage.device())}.canonicalFilePath();
+    if(device.startsWith("/dev/"_L1)) {
+        const QString blockPath = QFileInfo{u"/sys/class/block/"_s + QFileInfo{device}.fileName()}.canonicalFilePath();
+        for(const QString& queuePath : {blockPath + "/queue/rotational"_L1, blockPath + "/../queue/rotational"_L1}) {
+            QFile rotational{queuePath};
+            if(rotational.open(QIODevice::ReadOnly)) {
+                return rotational.readAll().trimmed() == "1" ? StorageType::Rotational : StorageType::Solid;
+            }
+        }
+    }
+#endif
+
+    return StorageType::Solid;
+}
+
+int defaultConcurrency(Fooyin::IoScheduler::StorageType type)
+{
+    switch(type) {
+        case(Fooyin::IoScheduler::StorageType::Rotational):
+            return 1;
+        case(Fooyin::IoScheduler::StorageType::Network):
+            return 2;
+        case(Fooyin::IoScheduler::StorageType::Solid):
+            break;
+    }
+    return std::max(2, QThread::idealThreadCount());
+}
+} // namespace
+
+namespace Fooyin {
+class IoSchedulerPrivate
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Mount
+    {
+        QString rootPath;
+        IoScheduler::StorageType type{IoScheduler::StorageType::Solid};
+        int limitOverride{0};
+        int active{0};
+        int playback{0};
+        LocalityKey lastKey;
+        Clock::time_point backgroundReleased;
+    };
+
+    struct Waiter
+    {
+        int mount{-1};
+        IoScheduler::Priority priority{IoScheduler::Priority::Background};
+        LocalityKey key;
+    };
+    using WaiterList = std::list<Waiter>;
+
+    int mountFor(const QString& path);
+    [[nodiscard]] int limit(const Mount& mount) const;
+
+    bool acquire(int mount, IoScheduler::Priority priority, const QString& path,
+                 const IoScheduler::CancelCheck& cancelled);
+    void release(int mount, IoScheduler::Priority priority);
+    [[nodiscard]] bool shouldYield(int mount, IoScheduler::Priority priority, Clock::time_point granted) const;
+
+    [[nodiscard]] static bool sharesWithPlayback(const Mount& mount);
+    [[nodiscard]] static Clock::time_point playbackWindowEnd(const Mount& mount);
+    [[nodiscard]] bool canStart(WaiterList::const_iterator waiter) const;
+    [[nodiscard]] WaiterList::const_iterator nextWaiter(int mount) const;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    std::vector<Mount> m_mounts;
+    QHash<QString, int> m_mountIndexes;
+    QHash<QString, int> m_dirMounts;
+    WaiterList m_waiters;
+    std::array<int, 3> m_typeLimits{};
+};
+
+int IoSchedulerPrivate::mountFor(const QString& path)
+{
+    const QFileInfo info{path};
+
+    {
+        // Directories are cached as themselves and files by their parent, so a hit needs no stat
+        const std::scoped_lock lock{m_mutex};
+        for(const QString& dir : {info.absoluteFilePath(), info.absolutePath()}) {
+            if(const auto it = m_dirMounts.constFind(dir); it != m_dirMounts.cend()) {
+                return it.value();
+            }
+        }
+    }
+
+    const QString dir = info.isDir() ? info.absoluteFilePath() : info.absolutePath();
+
+    // Querying the mount table is comparatively slow, so do it outside the lock
+    const QStorageInfo storage{dir};
+    const QString rootPath = storage.isValid() ? storage.rootPath() : QString{};
+    const auto type        = detectStorageType(storage);
+
+    const std::scoped_lock lock{m_mutex};
+
+    int index = m_mountIndexes.value(rootPath, -1);
+    if(index < 0) {
+        index = static_cast<int>(m_mounts.size());
+        m_mounts.push_back({.rootPath = rootPath, .type = type});
+        m_mountIndexes.insert(rootPath, index);
+        qCDebug(IO_SCHEDULER) << "Using concurrency of" << limit(m_mounts.back()) << "for" << rootPath;
+    }
+
+    if(m_dirMounts.size() >= MaxCachedDirs && !m_dirMounts.contains(dir)) {
+        m_dirMounts.erase(m_dirMounts.begin());
+    }
+    m_dirMounts.insert(dir, index);
+
+    return index;
+}
+
+int IoSchedulerPrivate::limit(const Mount& mount) const
+{
+    if(mount.limitOverride > 0) {
+        return mount.limitOverride;
+    }
+    if(const int typeLimit = m_typeLimits.at(static_cast<size_t>(mount.type)); typeLimit > 0) {
+        return typeLimit;
+    }
+    return defaultConcurrency(mount.type);
+}
+
+bool IoSchedulerPrivate::acquire(int mount, IoScheduler::Priority priority, const QString& path,
+                                 const IoScheduler::CancelCheck& cancelled)
+{
+    if(priority == IoScheduler::Priority::Playback) {
+        const std::scoped_lock lock{m_mutex};
+        auto& playbackMount = m_mounts.at(mount);
+        ++playbackMount.active;
+        ++playbackMount.playback;
+        return true;
+    }
+
+    // Stat outside the lock
+    LocalityKey key = localityKey(path);
+
+    std::unique_lock lock{m_mutex};
+
+    const auto waiter
+        = m_waiters.emplace(m_waiters.end(), Waiter{.mount = mount, .priority = priority, .key = std::move(key)});
+
+    while(!canStart(waiter)) {
+        if(cancelled && cancelled()) {
+            m_waiters.erase(waiter);
+            // The next waiter may now be able to start
+            m_condition.notify_all();
+            return false;
+        }
+
+        // Nothing is released when the playback window ends, so wake up for it
+        auto wakeAt = Clock::time_point::max();
+        if(priority == IoScheduler::Priority::Background) {
+            const auto& waitMount = m_mounts.at(mount);
+            if(sharesWithPlayback(waitMount)) {
+                wakeAt = playbackWindowEnd(waitMount);
+            }
+        }
+        if(cancelled) {
+            wakeAt = std::min(wakeAt, Clock::now() + CancelInterval);
+        }
+
+        if(wakeAt == Clock::time_point::max()) {
+            m_condition.wait(lock);
+        }
+        else {
+            m_condition.wait_until(lock, wakeAt);
+        }
+    }
+
+    auto& grantedMount = m_mounts.at(mount);
+    ++grantedMount.active;
+    grantedMount.lastKey = waiter->key;
+    m_waiters.erase(waiter);
+
+    // Other waiters may fit in the remaining slots
+    m_condition.notify_all();
+
+    return true;
+}
+
+void IoSchedulerPrivate::release(int mount, IoScheduler::Priority priority)
+{
+    {
+        const std::scoped_lock lock{m_mutex};
+        auto& releasedMount = m_mounts.at(mount);
+        --releasedMount.active;
+        if(priority == IoScheduler::Priority::Playback) {
+            --releasedMount.playback;
+        }
+        else if(priority == IoScheduler::Priority::Background && sharesWithPlayback(releasedMount)) {
+            releasedMount.backgroundReleased = Clock::now();
+        }
+    }
+    m_condition.notify_all();
+}
+
+bool IoSchedulerPrivate::shouldYield(int mount, IoScheduler::Priority priority, Clock::time_point granted) const
+{
+    const std::scoped_lock lock{m_mutex};
+
+    if(priority == IoScheduler::Priority::Background && sharesWithPlayback(m_mounts.at(mount))
+       && Clock::now() - granted >= BackgroundSlice) {
+        return true;
+    }
+
+    return std::ranges::any_of(m_waiters, [mount, priority](const Waiter& waiter) {
+        return waiter.mount == mount && waiter.priority < priority;
+    });
+}
+
+bool IoSchedulerPrivate::sharesWithPlayback(const Mount& mount)
+{
+    return mount.playback > 0 && mount.type != IoScheduler::StorageType::Solid;
+}
+
+IoSchedulerPrivate::Clock::time_point IoSchedulerPrivate::playbackWindowEnd(const Mount& mount)
+{
+    return mount.backgroundReleased + PlaybackWindow;
+}
+
+bool IoSchedulerPrivate::canStart(WaiterList::const_iterator waiter) const
+{
+    const auto& mount = m_mounts.at(waiter->mount);
+
+    if(mount.active - mount.playback >= limit(mount)) {
+        return false;
+    }
+
+    // Background reads compete with playback for the heads (or link)
+    if(waiter->priority == IoScheduler::Priority::Background && sharesWithPlayback(mount)
+       && Clock::now() < playbackWindowEnd(mount)) {
+        return false;
+    }
+
+    return nextWaiter(waiter->mount) == waiter;
+}
+
+IoSchedulerPrivate::WaiterList::const_iterator IoSchedulerPrivate::nextWaiter(int mount) const
+{
+    const auto& lastKey = m_mounts.at(mount).lastKey;
+
+    // Highest priority first, then the nearest request at or after the last one started, wrapping around
+    auto best     = m_waiters.cend();
+    bool bestNext = false;
+
+    for(auto it = m_waiters.cbegin(); it != m_waiters.cend(); ++it) {
+        if(it->mount != mount) {
+            continue;
+        }
+
+        const bool isNext = !(it->key < lastKey);
+
+        if(best == m_waiters.cend() || it->priority < best->priority) {
+            best     = it;
+            bestNext = isNext;
+            continue;
+        }
+        if(it->priority > best->priority) {
+            continue;
+        }
+
+        if(isNext != bestNext) {
+            if(isNext) {
+                best     = it;
+                bestNext = true;
+            }
+        }
+        else if(it->key < best->key) {
+            best = it;
+        }
+    }
+
+    return best;
+}
+
+IoScheduler::Lease::Lease(IoSchedulerPrivate* scheduler, int mount, Priority priority, QString path)
+    : m_scheduler{scheduler}
+    , m_mount{mount}
+    , m_priority{priority}
+    , m_path{std::move(path)}
+    , m_granted{std::chrono::steady_clock::now()}
+{ }
+
+IoScheduler::Lease::~Lease()
+{
+    release();
+}
+
+IoScheduler::Lease::Lease(Lease&& other) noexcept
+    : m_scheduler{std::exchange(other.m_scheduler, nullptr)}
+    , m_mount{other.m_mount}
+    , m_priority{other.m_priority}
+    , m_path{std::move(other.m_path)}
+    , m_granted{other.m_granted}
+{ }
+
+IoScheduler::Lease& IoScheduler::Lease::operator=(Lease&& other) noexcept
+{
+    if(this != &other) {
+        release();
+        m_scheduler = std::exchange(other.m_scheduler, nullptr);
+        m_mount     = other.m_mount;
+        m_priority  = other.m_priority;
+        m_path      = std::move(other.m_path);
+        m_granted   = other.m_granted;
+    }
+    return *this;
+}
+
+bool IoScheduler::Lease::isValid() const
+{
+    return m_scheduler != nullptr;
+}
+
+bool IoScheduler::Lease::yield(const CancelCheck& cancelled)
+{
+    if(!m_scheduler) {
+        return false;
+    }
+
+    if(!m_scheduler->shouldYield(m_mount, m_priority, m_granted)) {
+        return true;
+    }
+
+    m_scheduler->release(m_mount, m_priority);
+
+    if(!m_scheduler->acquire(m_mount, m_priority, m_path, cancelled)) {
+        m_scheduler = nullptr;
+        return false;
+    }
+    m_granted = std::chrono::steady_clock::now();
+
+    return true;
+}
+
+void IoScheduler::Lease::release()
+{
+    if(auto* scheduler = std::exchange(m_scheduler, nullptr)) {
+        scheduler->release(m_mount, m_priority);
+    }
+}
+
+IoScheduler::IoScheduler()
+    : p{std::make_unique<IoSchedulerPrivate>()}
+{ }
+
+IoScheduler::~IoScheduler() = default;
+
+IoScheduler* IoScheduler::instance()
+{
+    static IoScheduler scheduler;
+    return &scheduler;
+}
+
+IoScheduler::Lease IoScheduler::acquire(const QString& path, Priority priority, const CancelCheck& cancelled)
+{
+    const int mount = p->mountFor(path);
+
+    if(!p->acquire(mount, priority, path, cancelled)) {
+        return {};
+    }
+
+    return Lease{p.get(), mount, priority, path};
+}
+
+QString IoScheduler::mountPoint(const QString& path) const
+{
+    const int mount = p->mountFor(path);
+
+    const std::scoped_lock lock{p->m_mutex};
+    return p->m_mounts.at(mount).rootPath;
+}
+
+IoScheduler::StorageType IoScheduler::storageType(const QString& path) const
+{
+    const int mount = p->mountFor(path);
+
+    const std::scoped_lock lock{p->m_mutex};
+    return p->m_mounts.at(mount).type;
+}
+
+int IoScheduler::concurrency(const QString& path) const
+{
+    const int mount = p->mountFor(path);
+
+    const std::scoped_lock lock{p->m_mutex};
+    return p->limit(p->m_mounts.at(mount));
+}
+
+int IoScheduler::waiting(const QString& path) const
+{
+    const int mount = p->mountFor(path);
+
+    const std::scoped_lock lock{p->m_mutex};
+    return static_cast<int>(
+        std::ranges::count_if(p->m_waiters, [mount](const auto& waiter) { return waiter.mount == mount; }));
+}
+
+void IoScheduler::setConcurrency(StorageType type, int limit)
+{
+    {
+        const std::scoped_lock lock{p->m_mutex};
+        p->m_typeLimits.at(static_cast<size_t>(type)) = std::max(0, limit);
+    }
+    p->m_condition.notify_all();
+}
+
+void IoScheduler::setMountStorageType(const QString& mountPoint, StorageType type)
+{
+    const int mount = p->mountFor(mountPoint);
+
+    {
+        const std::scoped_lock lock{p->m_mutex};
+        p->m_mounts.at(mount).type = type;
+    }
+    p->m_condition.notify_all();
+}
+
+void IoScheduler::setMountConcurrency(const QString& mountPoint, int limit)
+{
+    const int mount = p->mountFor(mountPoint);
+
+    {
+        const std::scoped_lock lock{p->m_mutex};
+        p->m_mounts.at(mount).limitOverride = std::max(0, limit);
+    }
+    p->m_condition.notify_all();
+}
+} // namespace Fooyin
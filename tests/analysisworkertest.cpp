@@ -0,0 +1,246 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "core/library/analysisworker.h"
+
+#include <core/engine/audiobuffer.h>
+#include <core/engine/audioloader.h>
+
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace Qt::StringLiterals;
+
+constexpr auto SampleRate          = 8000;
+constexpr auto Channels            = 2;
+constexpr auto DecodedSeconds      = 3;
+constexpr uint64_t DecodedDuration = DecodedSeconds * 1000;
+
+namespace {
+// Produces a fixed length of silence in S16, so the worker has to convert it before analysis
+class SilenceDecoder : public Fooyin::AudioDecoder
+{
+public:
+    [[nodiscard]] QStringList extensions() const override
+    {
+        return {u"fytest"_s};
+    }
+
+    [[nodiscard]] bool isSeekable() const override
+    {
+        return false;
+    }
+
+    std::optional<Fooyin::AudioFormat> init(const Fooyin::AudioSource& /*source*/, const Fooyin::Track& /*track*/,
+                                            DecoderOptions /*options*/) override
+    {
+        m_remainingFrames = static_cast<int64_t>(SampleRate) * DecodedSeconds;
+        return m_format;
+    }
+
+    void stop() override
+    {
+        m_remainingFrames = 0;
+    }
+
+    void seek(uint64_t /*pos*/) override { }
+
+    Fooyin::AudioBuffer readBuffer(size_t bytes) override
+    {
+        const auto frames = std::min<int64_t>(m_remainingFrames, m_format.framesForBytes(static_cast<int>(bytes)));
+        if(frames <= 0) {
+            return {};
+        }
+        m_remainingFrames -= frames;
+
+        const std::vector<std::byte> data(static_cast<size_t>(m_format.bytesForFrames(static_cast<int>(frames))));
+        return Fooyin::AudioBuffer{data, m_format, 0};
+    }
+
+private:
+    Fooyin::AudioFormat m_format{Fooyin::SampleFormat::S16, SampleRate, Channels};
+    int64_t m_remainingFrames{0};
+};
+
+// Counts the frames it is fed, and marks each analysed track by setting its track gain
+class CountingStage : public Fooyin::AnalysisStage
+{
+public:
+    class Analysis : public Fooyin::TrackAnalysis
+    {
+    public:
+        explicit Analysis(CountingStage* stage)
+            : m_stage{stage}
+        { }
+
+        void process(std::span<const float> samples) override
+        {
+            m_frames += static_cast<int64_t>(samples.size()) / Channels;
+            m_silent &= std::ranges::all_of(samples, [](float sample) { return sample == 0.0F; });
+        }
+
+        bool finish(Fooyin::Track& track) override
+        {
+            m_stage->frames.push_back(m_frames);
+            if(!m_silent) {
+                return false;
+            }
+            track.setRGTrackGain(-1.0F);
+            return true;
+        }
+
+    private:
+        CountingStage* m_stage;
+        int64_t m_frames{0};
+        bool m_silent{true};
+    };
+
+    [[nodiscard]] QString name() const override
+    {
+        return u"Counting"_s;
+    }
+
+    [[nodiscard]] std::unique_ptr<Fooyin::TrackAnalysis> analyse(const Fooyin::Track& /*track*/,
+                                                                 const Fooyin::AudioFormat& format) override
+    {
+        EXPECT_EQ(format.sampleFormat(), Fooyin::SampleFormat::F32);
+        return std::make_unique<Analysis>(this);
+    }
+
+    std::vector<int64_t> frames;
+};
+} // namespace
+
+namespace Fooyin::Testing {
+class AnalysisWorkerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_dir.isValid());
+
+        QFile file{filepath()};
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+
+        m_audioLoader->addDecoder(u"Silence"_s, []() { return std::make_unique<SilenceDecoder>(); });
+
+        QObject::connect(&m_worker, &AnalysisWorker::tracksAnalysed, &m_worker,
+                         [this](const TrackList& originalTracks, const TrackList& analysedTracks) {
+                             EXPECT_EQ(originalTracks.size(), analysedTracks.size());
+                             m_batches.push_back(analysedTracks);
+                         });
+    }
+
+    [[nodiscard]] QString filepath() const
+    {
+        return m_dir.filePath(u"track.fytest"_s);
+    }
+
+    [[nodiscard]] TrackList makeTracks(int count, uint64_t duration) const
+    {
+        TrackList tracks;
+        for(int i{0}; i < count; ++i) {
+            Track track{filepath()};
+            track.setId(i);
+            track.setDuration(duration);
+            tracks.push_back(track);
+        }
+        return tracks;
+    }
+
+    QTemporaryDir m_dir;
+    std::shared_ptr<AudioLoader> m_audioLoader{std::make_shared<AudioLoader>()};
+    AnalysisWorker m_worker{m_audioLoader};
+    std::shared_ptr<CountingStage> m_stage{std::make_shared<CountingStage>()};
+    std::vector<TrackList> m_batches;
+};
+
+TEST_F(AnalysisWorkerTest, FeedsEveryDecodedFrame)
+{
+    m_worker.analyse(makeTracks(1, DecodedDuration), {m_stage});
+
+    ASSERT_EQ(m_stage->frames.size(), 1U);
+    EXPECT_EQ(m_stage->frames.front(), SampleRate * DecodedSeconds);
+}
+
+TEST_F(AnalysisWorkerTest, CorrectsDuration)
+{
+    m_worker.analyse(makeTracks(1, 10000), {m_stage});
+
+    ASSERT_EQ(m_batches.size(), 1U);
+    ASSERT_EQ(m_batches.front().size(), 1U);
+    EXPECT_EQ(m_batches.front().front().duration(), DecodedDuration);
+}
+
+TEST_F(AnalysisWorkerTest, KeepsDurationWithinTolerance)
+{
+    m_worker.analyse(makeTracks(1, DecodedDuration + 500), {m_stage});
+
+    ASSERT_EQ(m_batches.size(), 1U);
+    EXPECT_EQ(m_batches.front().front().duration(), DecodedDuration + 500);
+}
+
+TEST_F(AnalysisWorkerTest, SavesInBatches)
+{
+    m_worker.analyse(makeTracks(120, DecodedDuration), {m_stage});
+
+    ASSERT_EQ(m_batches.size(), 3U);
+    EXPECT_EQ(m_batches.at(0).size(), 50U);
+    EXPECT_EQ(m_batches.at(1).size(), 50U);
+    EXPECT_EQ(m_batches.at(2).size(), 20U);
+
+    std::vector<int> ids;
+    for(const auto& batch : m_batches) {
+        std::ranges::transform(batch, std::back_inserter(ids), &Track::id);
+    }
+
+    std::vector<int> expectedIds(120);
+    std::iota(expectedIds.begin(), expectedIds.end(), 0);
+    EXPECT_EQ(ids, expectedIds);
+}
+
+TEST_F(AnalysisWorkerTest, AppliesOnlyAnalysedFields)
+{
+    Track original{filepath()};
+    original.setId(1);
+    original.setTitle(u"Title"_s);
+    original.setDuration(10000);
+
+    Track analysed{original};
+    analysed.setDuration(DecodedDuration);
+    analysed.setRGTrackGain(-3.0F);
+
+    // Edited while the analysis was running
+    Track current{original};
+    current.setTitle(u"Edited"_s);
+    current.setRating(0.8F);
+
+    ASSERT_TRUE(AnalysisWorker::applyAnalysis(original, analysed, current));
+    EXPECT_EQ(current.title(), u"Edited"_s);
+    EXPECT_FLOAT_EQ(current.rating(), 0.8F);
+    EXPECT_EQ(current.duration(), DecodedDuration);
+    EXPECT_FLOAT_EQ(current.rgTrackGain(), -3.0F);
+
+    EXPECT_FALSE(AnalysisWorker::applyAnalysis(original, original, current));
+}
+} // namespace Fooyin::Testing
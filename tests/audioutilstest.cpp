@@ -0,0 +1,95 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/audioutils.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+namespace Fooyin::Testing {
+namespace {
+std::vector<float> generateFrames(int channels, int frames)
+{
+    std::vector<float> samples(static_cast<size_t>(channels) * frames);
+    for(size_t i{0}; i < samples.size(); ++i) {
+        const auto channel = static_cast<float>((i % channels) + 1);
+        samples[i]         = std::sin(static_cast<float>(i) * 0.013F) / channel;
+    }
+    return samples;
+}
+
+// Per-sample reference, equivalent to the original waveform loop
+std::vector<Audio::ChannelStats> referenceStats(const std::vector<float>& samples, int channels)
+{
+    std::vector<Audio::ChannelStats> stats(channels);
+    const size_t frames = samples.size() / channels;
+
+    for(int ch{0}; ch < channels; ++ch) {
+        auto& channel = stats[ch];
+        for(size_t frame{0}; frame < frames; ++frame) {
+            const float sample = samples[(frame * channels) + ch];
+            channel.min        = std::min(channel.min, sample);
+            channel.max        = std::max(channel.max, sample);
+            channel.sumSquares += static_cast<double>(sample) * sample;
+        }
+    }
+
+    return stats;
+}
+} // namespace
+
+TEST(AudioUtilsTest, AccumulateFramesMatchesReference)
+{
+    for(const int channels : {1, 2, 6, 20, 70}) {
+        for(const int frames : {1, 7, 100, 4097}) {
+            const auto samples  = generateFrames(channels, frames);
+            const auto expected = referenceStats(samples, channels);
+
+            std::vector<Audio::ChannelStats> stats(channels);
+            Audio::accumulateFrames(samples, channels, stats);
+
+            for(int ch{0}; ch < channels; ++ch) {
+                EXPECT_EQ(stats[ch].min, expected[ch].min);
+                EXPECT_EQ(stats[ch].max, expected[ch].max);
+                EXPECT_NEAR(stats[ch].sumSquares, expected[ch].sumSquares, 1e-3 * (expected[ch].sumSquares + 1.0));
+            }
+        }
+    }
+}
+
+TEST(AudioUtilsTest, AccumulateFramesAcrossBlocks)
+{
+    const auto samples = generateFrames(2, 1000);
+
+    std::vector<Audio::ChannelStats> whole(2);
+    Audio::accumulateFrames(samples, 2, whole);
+
+    std::vector<Audio::ChannelStats> blocks(2);
+    Audio::accumulateFrames({samples.data(), 600}, 2, blocks);
+    Audio::accumulateFrames({samples.data() + 600, samples.size() - 600}, 2, blocks);
+
+    for(int ch{0}; ch < 2; ++ch) {
+        EXPECT_EQ(blocks[ch].min, whole[ch].min);
+        EXPECT_EQ(blocks[ch].max, whole[ch].max);
+        EXPECT_NEAR(blocks[ch].sumSquares, whole[ch].sumSquares, 1e-3);
+    }
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,174 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "plugins/rgscanner/ebur128scanner.h"
+
+#include <core/constants.h>
+#include <core/engine/audiobuffer.h>
+#include <core/engine/audioloader.h>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numbers>
+
+using namespace Qt::StringLiterals;
+
+constexpr auto SampleRate   = 44100;
+constexpr auto Channels     = 2;
+constexpr auto TrackCount   = 12;
+constexpr auto TrackSeconds = 240;
+constexpr auto ToneHz       = 1000.0;
+
+namespace {
+// Generates a tone in S16 for each track, at a level which varies by track, so an album's worth of audio
+// can be scanned without shipping one
+class ToneDecoder : public Fooyin::AudioDecoder
+{
+public:
+    [[nodiscard]] QStringList extensions() const override
+    {
+        return {u"fytone"_s};
+    }
+
+    [[nodiscard]] bool isSeekable() const override
+    {
+        return false;
+    }
+
+    std::optional<Fooyin::AudioFormat> init(const Fooyin::AudioSource& /*source*/, const Fooyin::Track& track,
+                                            DecoderOptions /*options*/) override
+    {
+        m_remainingFrames = static_cast<int64_t>(SampleRate) * TrackSeconds;
+        m_frame           = 0;
+        m_amplitude       = 0.1 * (1 + (track.id() % 5));
+        return m_format;
+    }
+
+    void stop() override
+    {
+        m_remainingFrames = 0;
+    }
+
+    void seek(uint64_t /*pos*/) override { }
+
+    Fooyin::AudioBuffer readBuffer(size_t bytes) override
+    {
+        const auto frames = std::min<int64_t>(m_remainingFrames, m_format.framesForBytes(static_cast<int>(bytes)));
+        if(frames <= 0) {
+            return {};
+        }
+        m_remainingFrames -= frames;
+
+        std::vector<int16_t> samples(static_cast<size_t>(frames) * Channels);
+        for(int64_t frame{0}; frame < frames; ++frame, ++m_frame) {
+            const double value = m_amplitude * std::sin(2.0 * std::numbers::pi * ToneHz * m_frame / SampleRate);
+            const auto sample  = static_cast<int16_t>(value * 32767.0);
+            for(int ch{0}; ch < Channels; ++ch) {
+                samples[static_cast<size_t>((frame * Channels) + ch)] = sample;
+            }
+        }
+
+        return Fooyin::AudioBuffer{std::as_bytes(std::span{samples}), m_format, 0};
+    }
+
+private:
+    Fooyin::AudioFormat m_format{Fooyin::SampleFormat::S16, SampleRate, Channels};
+    int64_t m_remainingFrames{0};
+    int64_t m_frame{0};
+    double m_amplitude{0.0};
+};
+} // namespace
+
+namespace Fooyin::Testing {
+class Ebur128ScannerBenchmark : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        if(!QCoreApplication::instance()) {
+            static int argc{1};
+            static char arg[] = "benchmark";
+            static char* argv[]{arg};
+            static QCoreApplication app{argc, argv};
+        }
+    }
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_dir.isValid());
+
+        m_audioLoader->addDecoder(u"Tone"_s, []() { return std::make_unique<ToneDecoder>(); });
+
+        for(int i{0}; i < TrackCount; ++i) {
+            const QString filepath = m_dir.filePath(u"track%1.fytone"_s.arg(i));
+
+            QFile file{filepath};
+            ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+
+            Track track{filepath};
+            track.setId(i);
+            track.setDuration(static_cast<uint64_t>(TrackSeconds) * 1000);
+            m_tracks.push_back(track);
+        }
+    }
+
+    QTemporaryDir m_dir;
+    std::shared_ptr<AudioLoader> m_audioLoader{std::make_shared<AudioLoader>()};
+    TrackList m_tracks;
+};
+
+TEST_F(Ebur128ScannerBenchmark, ScanAlbum)
+{
+    RGScanner::Ebur128Scanner scanner{m_audioLoader};
+
+    TrackList scannedTracks;
+    QEventLoop loop;
+    QObject::connect(&scanner, &RGScanner::RGWorker::calculationFinished, &loop,
+                     [&scannedTracks, &loop](const TrackList& tracks) {
+                         scannedTracks = tracks;
+                         loop.quit();
+                     });
+
+    QElapsedTimer timer;
+    timer.start();
+
+    scanner.calculateAsAlbum(m_tracks, true);
+    loop.exec();
+
+    const qint64 elapsed = std::max<qint64>(timer.elapsed(), 1);
+
+    ASSERT_EQ(scannedTracks.size(), m_tracks.size());
+    constexpr auto InvalidGain = static_cast<float>(Constants::InvalidGain);
+    for(const Track& track : scannedTracks) {
+        EXPECT_NE(track.rgTrackGain(), InvalidGain);
+        EXPECT_NE(track.rgAlbumGain(), InvalidGain);
+        EXPECT_FLOAT_EQ(track.rgAlbumGain(), scannedTracks.front().rgAlbumGain());
+    }
+
+    const auto audioMs = static_cast<qint64>(TrackCount) * TrackSeconds * 1000;
+    RecordProperty("ScanMs", static_cast<int>(elapsed));
+    RecordProperty("TimesRealtime", static_cast<int>(audioMs / elapsed));
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,110 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gui/widgets/expandedtreeview.h>
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QScrollBar>
+#include <QStandardItemModel>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace Qt::StringLiterals;
+
+constexpr auto RowCount       = 100000;
+constexpr auto ViewportHeight = 800;
+// Scrolls half a viewport at a time, so every row is painted twice
+constexpr auto ScrollStep = ViewportHeight / 2;
+
+namespace Fooyin::Testing {
+class ExpandedTreeViewBenchmark : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        if(!QApplication::instance()) {
+            if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+                qputenv("QT_QPA_PLATFORM", "offscreen");
+            }
+            static int argc{1};
+            static char arg[] = "benchmark";
+            static char* argv[]{arg};
+            static QApplication app{argc, argv};
+        }
+    }
+
+    void SetUp() override
+    {
+        // Header rows interspersed with track rows, as in a grouped playlist
+        QList<QStandardItem*> rows;
+        rows.reserve(RowCount);
+        for(int row{0}; row < RowCount; ++row) {
+            auto* item = new QStandardItem(u"Row %1"_s.arg(row));
+            item->setSizeHint({0, row % 12 == 0 ? 48 : 20});
+            rows.push_back(item);
+        }
+        m_model.invisibleRootItem()->appendRows(rows);
+    }
+
+    QStandardItemModel m_model;
+};
+
+TEST_F(ExpandedTreeViewBenchmark, ScrollNonUniformRows)
+{
+    ExpandedTreeView view;
+    view.setModel(&m_model);
+    view.resize(400, ViewportHeight);
+    view.show();
+    QCoreApplication::processEvents();
+
+    auto* scrollBar = view.verticalScrollBar();
+    ASSERT_GT(scrollBar->maximum(), 0);
+
+    const QPoint centre{view.viewport()->width() / 2, view.viewport()->height() / 2};
+
+    int steps{0};
+    int hits{0};
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Each step lays out and paints the visible rows, then hit tests the centre of the viewport
+    for(int value{0}; value <= scrollBar->maximum(); value += ScrollStep) {
+        scrollBar->setValue(value);
+        view.viewport()->repaint();
+        if(view.indexAt(centre).isValid()) {
+            ++hits;
+        }
+        ++steps;
+    }
+
+    const qint64 elapsed = std::max<qint64>(timer.elapsed(), 1);
+
+    EXPECT_EQ(hits, steps);
+
+    std::cout << "Scrolled " << RowCount << " rows in " << steps << " steps: " << elapsed << " ms ("
+              << (elapsed * 1000 / steps) << " us per step)\n";
+    RecordProperty("Steps", steps);
+    RecordProperty("ScrollMs", static_cast<int>(elapsed));
+}
+} // namespace Fooyin::Testing
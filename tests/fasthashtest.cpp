@@ -0,0 +1,74 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/crypto.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <unordered_set>
+
+using namespace Qt::StringLiterals;
+
+namespace Fooyin::Testing {
+TEST(FastHashTest, Deterministic)
+{
+    const Md5Hash parent = Utils::generateFastHash(u"Artist"_s);
+
+    EXPECT_EQ(16, parent.size());
+    EXPECT_EQ(parent, Utils::generateFastHash(u"Artist"_s));
+    EXPECT_EQ(Utils::generateFastHash(parent, u"Album"_s), Utils::generateFastHash(parent, u"Album"_s));
+    EXPECT_NE(Utils::generateFastHash(parent, u"Album"_s), Utils::generateFastHash(parent, u"Album "_s));
+}
+
+TEST(FastHashTest, PartBoundaries)
+{
+    EXPECT_NE(Utils::generateFastHash(u"ab"_s, u"c"_s), Utils::generateFastHash(u"a"_s, u"bc"_s));
+    EXPECT_NE(Utils::generateFastHash(QString{}), Utils::generateFastHash(QString{}, QString{}));
+}
+
+TEST(FastHashTest, TreeKeys)
+{
+    constexpr int ArtistCount = 2000;
+    constexpr int AlbumCount  = 10;
+    constexpr int TrackCount  = 20;
+
+    std::unordered_set<Md5Hash> keys;
+    const Md5Hash root;
+
+    // Mirrors the library tree's Artist > Album > Title grouping of 400k tracks
+    const auto start = std::chrono::steady_clock::now();
+    for(int artist{0}; artist < ArtistCount; ++artist) {
+        const Md5Hash artistKey = Utils::generateFastHash(root, u"Artist %1"_s.arg(artist));
+        keys.emplace(artistKey);
+        for(int album{0}; album < AlbumCount; ++album) {
+            const Md5Hash albumKey = Utils::generateFastHash(artistKey, u"Album %1"_s.arg(album));
+            keys.emplace(albumKey);
+            for(int track{0}; track < TrackCount; ++track) {
+                keys.emplace(Utils::generateFastHash(albumKey, u"%1. Title"_s.arg(track)));
+            }
+        }
+    }
+    const auto elapsed
+        = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    EXPECT_EQ(ArtistCount * (1 + AlbumCount * (1 + TrackCount)), static_cast<int>(keys.size()));
+    RecordProperty("BuildKeysMs", static_cast<int>(elapsed.count()));
+}
+} // namespace Fooyin::Testing
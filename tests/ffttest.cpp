@@ -0,0 +1,122 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "plugins/spectrum/fft.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace Fooyin::Testing {
+namespace {
+// Direct evaluation of the DFT, to compare the packed real transform against
+std::vector<float> naiveMagnitudes(const std::vector<float>& input)
+{
+    const auto size = static_cast<int>(input.size());
+    std::vector<float> magnitudes((size / 2) + 1);
+
+    for(int k{0}; std::cmp_less(k, magnitudes.size()); ++k) {
+        std::complex<double> sum;
+        for(int n{0}; n < size; ++n) {
+            const double angle = -2.0 * std::numbers::pi * k * n / size;
+            sum += static_cast<double>(input[n]) * std::polar(1.0, angle);
+        }
+        magnitudes[k] = static_cast<float>(std::abs(sum));
+    }
+
+    return magnitudes;
+}
+
+std::vector<float> fftMagnitudes(const std::vector<float>& input)
+{
+    Spectrum::Fft fft{static_cast<int>(input.size())};
+    std::vector<float> magnitudes(fft.binCount());
+    fft.magnitudes(input, magnitudes);
+    return magnitudes;
+}
+} // namespace
+
+class FftTest : public ::testing::TestWithParam<int>
+{ };
+
+TEST_P(FftTest, MatchesNaiveDft)
+{
+    const int size = GetParam();
+
+    std::mt19937 generator{static_cast<uint32_t>(size)};
+    std::uniform_real_distribution<float> distribution{-1.0F, 1.0F};
+
+    std::vector<float> input(size);
+    for(float& sample : input) {
+        sample = distribution(generator);
+    }
+
+    const auto expected = naiveMagnitudes(input);
+    const auto actual   = fftMagnitudes(input);
+
+    ASSERT_EQ(actual.size(), expected.size());
+    for(size_t k{0}; k < expected.size(); ++k) {
+        EXPECT_NEAR(actual[k], expected[k], 1e-4 * size) << "bin " << k;
+    }
+}
+
+TEST_P(FftTest, PureSine)
+{
+    const int size = GetParam();
+    const int bin  = size / 8;
+
+    std::vector<float> input(size);
+    for(int n{0}; n < size; ++n) {
+        input[n] = static_cast<float>(std::sin(2.0 * std::numbers::pi * bin * n / size));
+    }
+
+    const auto magnitudes = fftMagnitudes(input);
+
+    // All of the energy lands in one bin, at half the amplitude times the size
+    for(int k{0}; std::cmp_less(k, magnitudes.size()); ++k) {
+        const float expected = k == bin ? static_cast<float>(size) / 2.0F : 0.0F;
+        EXPECT_NEAR(magnitudes[k], expected, 1e-4 * size) << "bin " << k;
+    }
+}
+
+TEST_P(FftTest, DcAndNyquist)
+{
+    const int size = GetParam();
+
+    std::vector<float> input(size);
+    for(int n{0}; n < size; ++n) {
+        input[n] = 0.25F + (n % 2 == 0 ? 0.5F : -0.5F);
+    }
+
+    const auto magnitudes = fftMagnitudes(input);
+
+    EXPECT_NEAR(magnitudes.front(), 0.25 * size, 1e-4 * size);
+    EXPECT_NEAR(magnitudes.back(), 0.5 * size, 1e-4 * size);
+    for(size_t k{1}; k + 1 < magnitudes.size(); ++k) {
+        EXPECT_NEAR(magnitudes[k], 0.0F, 1e-4 * size) << "bin " << k;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Sizes, FftTest, ::testing::Values(8, 64, 1024, 4096));
+} // namespace Fooyin::Testing
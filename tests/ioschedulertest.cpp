@@ -0,0 +1,195 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/ioscheduler.h>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+using namespace Qt::StringLiterals;
+
+namespace Fooyin::Testing {
+class IoSchedulerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_dir.isValid());
+
+        for(const auto& subdir : {u"a"_s, u"b"_s, u"c"_s}) {
+            QDir{m_dir.path()}.mkpath(subdir);
+            QFile file{path(subdir + u"/file"_s)};
+            ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        }
+
+        m_scheduler.setMountStorageType(m_dir.path(), IoScheduler::StorageType::Solid);
+        m_scheduler.setMountConcurrency(m_dir.path(), 1);
+    }
+
+    [[nodiscard]] QString path(const QString& file) const
+    {
+        return m_dir.filePath(file);
+    }
+
+    void waitForWaiters(int count) const
+    {
+        while(m_scheduler.waiting(m_dir.path()) != count) {
+            std::this_thread::yield();
+        }
+    }
+
+    QTemporaryDir m_dir;
+    IoScheduler m_scheduler;
+};
+
+TEST_F(IoSchedulerTest, RespectsConcurrency)
+{
+    m_scheduler.setMountConcurrency(m_dir.path(), 2);
+
+    static constexpr int Requests{8};
+
+    std::atomic<int> active{0};
+    std::atomic<int> maxActive{0};
+    std::atomic<int> granted{0};
+
+    std::vector<std::thread> threads;
+    for(int i{0}; i < Requests; ++i) {
+        threads.emplace_back([this, &active, &maxActive, &granted]() {
+            const auto lease = m_scheduler.acquire(path(u"a/file"_s));
+
+            const int current = ++active;
+            int previous      = maxActive.load();
+            while(current > previous && !maxActive.compare_exchange_weak(previous, current)) { }
+
+            // Hold the slot until every other request has either been granted or is queued behind it
+            ++granted;
+            while(m_scheduler.waiting(m_dir.path()) != Requests - granted.load()) {
+                std::this_thread::yield();
+            }
+            --active;
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(maxActive.load(), 2);
+}
+
+TEST_F(IoSchedulerTest, OrdersByPriorityThenLocality)
+{
+    auto lease = m_scheduler.acquire(path(u"b/file"_s));
+
+    std::mutex mutex;
+    QStringList order;
+    std::vector<std::thread> threads;
+
+    const auto request = [&](const QString& file, IoScheduler::Priority priority) {
+        threads.emplace_back([&, file, priority]() {
+            const auto waiting = m_scheduler.acquire(path(file), priority);
+            const std::scoped_lock lock{mutex};
+            order.push_back(file);
+        });
+        // Let the request start waiting before the next is made
+        waitForWaiters(static_cast<int>(threads.size()));
+    };
+
+    request(u"a/file"_s, IoScheduler::Priority::Background);
+    request(u"c/file"_s, IoScheduler::Priority::Background);
+    request(u"b/file"_s, IoScheduler::Priority::Interactive);
+
+    // Playback never waits, even on a full mount
+    EXPECT_TRUE(m_scheduler.acquire(path(u"b/file"_s), IoScheduler::Priority::Playback).isValid());
+
+    lease.release();
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    // Interactive first, then onwards from b/ for the elevator, wrapping round to a/
+    const QStringList expected{u"b/file"_s, u"c/file"_s, u"a/file"_s};
+    EXPECT_EQ(order, expected);
+}
+
+TEST_F(IoSchedulerTest, CancelsWhileWaiting)
+{
+    const auto lease = m_scheduler.acquire(path(u"a/file"_s));
+
+    const auto cancelled
+        = m_scheduler.acquire(path(u"b/file"_s), IoScheduler::Priority::Background, []() { return true; });
+    EXPECT_FALSE(cancelled.isValid());
+}
+
+TEST_F(IoSchedulerTest, BackgroundYieldsToPlayback)
+{
+    m_scheduler.setMountStorageType(m_dir.path(), IoScheduler::StorageType::Rotational);
+
+    auto lease = m_scheduler.acquire(path(u"a/file"_s));
+    ASSERT_TRUE(lease.isValid());
+
+    const auto playback = m_scheduler.acquire(path(u"b/file"_s), IoScheduler::Priority::Playback);
+
+    std::atomic<bool> requeued{false};
+    std::atomic<bool> resumed{true};
+    std::thread holder{[&lease, &requeued, &resumed]() {
+        // Keeps the slot until its slice runs out
+        while(!requeued && resumed) {
+            resumed = lease.yield();
+        }
+    }};
+
+    // The lease is given up and queued again, even though no other request is waiting
+    waitForWaiters(1);
+    requeued = true;
+
+    holder.join();
+    EXPECT_TRUE(resumed);
+    EXPECT_TRUE(lease.isValid());
+}
+
+TEST_F(IoSchedulerTest, BackgroundProgressesDuringPlayback)
+{
+    m_scheduler.setMountStorageType(m_dir.path(), IoScheduler::StorageType::Rotational);
+
+    const auto playback = m_scheduler.acquire(path(u"b/file"_s), IoScheduler::Priority::Playback);
+
+    for(const auto& file : {u"a/file"_s, u"b/file"_s, u"c/file"_s}) {
+        auto lease = m_scheduler.acquire(path(file));
+        EXPECT_TRUE(lease.isValid());
+        EXPECT_TRUE(lease.yield());
+    }
+}
+
+TEST_F(IoSchedulerTest, SolidMountIgnoresPlayback)
+{
+    auto lease          = m_scheduler.acquire(path(u"a/file"_s));
+    const auto playback = m_scheduler.acquire(path(u"b/file"_s), IoScheduler::Priority::Playback);
+
+    // Nothing is waiting and playback doesn't contend on solid state, so the slot is kept
+    EXPECT_TRUE(lease.yield());
+    EXPECT_EQ(m_scheduler.waiting(m_dir.path()), 0);
+}
+} // namespace Fooyin::Testing
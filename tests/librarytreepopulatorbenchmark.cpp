@@ -0,0 +1,93 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "gui/librarytree/librarytreepopulator.h"
+
+#include <gtest/gtest.h>
+
+#include <QElapsedTimer>
+
+#include <unordered_set>
+
+using namespace Qt::StringLiterals;
+
+constexpr auto ArtistCount = 2000;
+constexpr auto AlbumCount  = 10;
+constexpr auto TrackCount  = 20;
+// The default Artist/Album grouping
+constexpr auto Grouping = "[%albumartist%]||[%album%][ (%year%)]||[%disc%.][$num(%track%,2). ]%title%";
+
+namespace Fooyin::Testing {
+namespace {
+TrackList generateTracks()
+{
+    TrackList tracks;
+    tracks.reserve(static_cast<size_t>(ArtistCount) * AlbumCount * TrackCount);
+
+    for(int artist{0}; artist < ArtistCount; ++artist) {
+        const QString artistName = u"Artist %1"_s.arg(artist);
+        for(int album{0}; album < AlbumCount; ++album) {
+            const QString albumName = u"Album %1"_s.arg(album);
+            for(int number{1}; number <= TrackCount; ++number) {
+                Track track{u"/music/%1/%2/%3.flac"_s.arg(artistName, albumName).arg(number)};
+                track.setId(static_cast<int>(tracks.size()));
+                track.setLibraryId(0);
+                track.setAlbumArtists({artistName});
+                track.setAlbum(albumName);
+                track.setYear(1990 + album);
+                track.setTrackNumber(QString::number(number));
+                track.setTitle(u"Title %1"_s.arg(number));
+                tracks.push_back(track);
+            }
+        }
+    }
+
+    return tracks;
+}
+} // namespace
+
+TEST(LibraryTreePopulatorBenchmark, PopulateLibrary)
+{
+    const TrackList tracks = generateTracks();
+
+    LibraryTreePopulator populator{nullptr};
+
+    std::unordered_set<Md5Hash> keys;
+    size_t groupedTracks{0};
+    QObject::connect(&populator, &LibraryTreePopulator::populated, &populator, [&](const PendingTreeData& data) {
+        for(const auto& [key, _] : data.items) {
+            keys.emplace(key);
+        }
+        groupedTracks += data.trackParents.size();
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+
+    populator.run(QString::fromLatin1(Grouping), tracks, false);
+
+    const qint64 elapsed = timer.elapsed();
+
+    EXPECT_EQ(groupedTracks, tracks.size());
+    EXPECT_EQ(keys.size(), static_cast<size_t>(ArtistCount) * (1 + (AlbumCount * (1 + TrackCount))));
+
+    RecordProperty("Tracks", static_cast<int>(tracks.size()));
+    RecordProperty("PopulateMs", static_cast<int>(elapsed));
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,149 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "gui/playlist/playlistrowloader.h"
+
+#include <QCoreApplication>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace Fooyin::Testing {
+class PlaylistRowLoaderTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        if(!QCoreApplication::instance()) {
+            static int argc{1};
+            static char arg[] = "test";
+            static char* argv[]{arg};
+            static QCoreApplication app{argc, argv};
+        }
+    }
+
+    void SetUp() override
+    {
+        QObject::connect(&m_loader, &PlaylistRowLoader::rowsRequested, &m_loader,
+                         [this](const std::vector<int>& indexes) { m_requests.push_back(indexes); });
+    }
+
+    // Loads @p count new rows, returning their keys and collecting anything evicted
+    std::vector<UId> loadRows(int count)
+    {
+        std::vector<UId> keys;
+        for(int i{0}; i < count; ++i) {
+            const UId key = UId::create();
+            m_loader.setLoading(key);
+            std::ranges::move(m_loader.setLoaded(key), std::back_inserter(m_evicted));
+            keys.push_back(key);
+        }
+        return keys;
+    }
+
+    PlaylistRowLoader m_loader{3};
+    std::vector<std::vector<int>> m_requests;
+    std::vector<UId> m_evicted;
+};
+
+TEST_F(PlaylistRowLoaderTest, CoalescesRequests)
+{
+    m_loader.request(UId::create(), 5);
+    m_loader.request(UId::create(), 2);
+    m_loader.request(UId::create(), 5);
+    EXPECT_TRUE(m_requests.empty());
+
+    QCoreApplication::processEvents();
+
+    ASSERT_EQ(m_requests.size(), 1U);
+    EXPECT_EQ(m_requests.front(), (std::vector<int>{2, 5}));
+}
+
+TEST_F(PlaylistRowLoaderTest, SkipsRowsAlreadyLoading)
+{
+    const UId key = UId::create();
+    m_loader.setLoading(key);
+    m_loader.request(key, 1);
+
+    QCoreApplication::processEvents();
+
+    EXPECT_TRUE(m_requests.empty());
+}
+
+TEST_F(PlaylistRowLoaderTest, LoadedRowsCanBeRequestedAgain)
+{
+    const auto keys = loadRows(1);
+    EXPECT_FALSE(m_loader.isLoading(keys.front()));
+
+    m_loader.request(keys.front(), 0);
+    QCoreApplication::processEvents();
+
+    EXPECT_EQ(m_requests.size(), 1U);
+}
+
+TEST_F(PlaylistRowLoaderTest, RemovedRowsCanBeRequestedAgain)
+{
+    const UId key = UId::create();
+    m_loader.setLoading(key);
+    m_loader.remove(key);
+    EXPECT_FALSE(m_loader.isLoading(key));
+
+    m_loader.request(key, 0);
+    QCoreApplication::processEvents();
+
+    EXPECT_EQ(m_requests.size(), 1U);
+}
+
+TEST_F(PlaylistRowLoaderTest, EvictsLeastRecentlyUsed)
+{
+    const auto keys = loadRows(3);
+    EXPECT_TRUE(m_evicted.empty());
+
+    m_loader.touch(keys.at(0));
+    loadRows(1);
+
+    ASSERT_EQ(m_evicted.size(), 1U);
+    EXPECT_EQ(m_evicted.front(), keys.at(1));
+    EXPECT_EQ(m_loader.loadedCount(), 3);
+}
+
+TEST_F(PlaylistRowLoaderTest, ReloadingDoesNotGrow)
+{
+    const auto keys = loadRows(3);
+
+    // A row refreshed after being evaluated is loaded again without taking another slot
+    m_loader.setLoading(keys.at(0));
+    std::ranges::move(m_loader.setLoaded(keys.at(0)), std::back_inserter(m_evicted));
+
+    EXPECT_TRUE(m_evicted.empty());
+    EXPECT_FALSE(m_loader.isLoading(keys.at(0)));
+    EXPECT_EQ(m_loader.loadedCount(), 3);
+}
+
+TEST_F(PlaylistRowLoaderTest, RemovedRowsFreeBudget)
+{
+    const auto keys = loadRows(3);
+    m_loader.remove(keys.at(1));
+    EXPECT_EQ(m_loader.loadedCount(), 2);
+
+    loadRows(1);
+    EXPECT_TRUE(m_evicted.empty());
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,162 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/playlist/playlist.h>
+
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+namespace Fooyin::Testing {
+class PlaylistTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_playlist = Playlist::create(u"Test"_s, nullptr);
+    }
+
+    static Track makeTrack(int id, const QString& title = {})
+    {
+        Track track{u"/music/%1.flac"_s.arg(id)};
+        track.setId(id);
+        track.setTitle(title);
+        return track;
+    }
+
+    void replaceTracks(const TrackList& tracks)
+    {
+        m_playlist->replaceTracks(tracks);
+    }
+
+    void appendTracks(const TrackList& tracks)
+    {
+        m_playlist->appendTracks(tracks);
+    }
+
+    void updateTrackAtIndex(int index, const Track& track)
+    {
+        m_playlist->updateTrackAtIndex(index, track);
+    }
+
+    std::vector<int> updateTracks(const TrackList& tracks)
+    {
+        return m_playlist->updateTracks(tracks);
+    }
+
+    std::vector<int> removeTracks(const std::vector<int>& indexes)
+    {
+        return m_playlist->removeTracks(indexes);
+    }
+
+    [[nodiscard]] QString title(int index) const
+    {
+        return m_playlist->track(index).value_or(Track{}).title();
+    }
+
+    std::unique_ptr<Playlist> m_playlist;
+};
+
+TEST_F(PlaylistTest, UpdateDuplicateTracks)
+{
+    replaceTracks({makeTrack(1), makeTrack(2), makeTrack(1)});
+
+    const std::vector<int> expected{0, 2};
+    EXPECT_EQ(updateTracks({makeTrack(1, u"Updated"_s)}), expected);
+    EXPECT_EQ(title(0), u"Updated"_s);
+    EXPECT_TRUE(title(1).isEmpty());
+    EXPECT_EQ(title(2), u"Updated"_s);
+}
+
+TEST_F(PlaylistTest, UpdateIgnoresUnknownTracks)
+{
+    replaceTracks({makeTrack(1), makeTrack(2)});
+
+    Track notInDatabase{u"/music/1.flac"_s};
+    notInDatabase.setTitle(u"Updated"_s);
+
+    EXPECT_TRUE(updateTracks({makeTrack(3, u"Updated"_s), notInDatabase}).empty());
+    EXPECT_TRUE(title(0).isEmpty());
+}
+
+TEST_F(PlaylistTest, UpdateReturnsSortedIndexes)
+{
+    replaceTracks({makeTrack(2), makeTrack(1), makeTrack(2), makeTrack(1)});
+
+    const std::vector<int> expected{0, 1, 2, 3};
+    EXPECT_EQ(updateTracks({makeTrack(1, u"One"_s), makeTrack(2, u"Two"_s)}), expected);
+}
+
+TEST_F(PlaylistTest, UpdateAfterAppend)
+{
+    replaceTracks({makeTrack(1)});
+    // Builds the index, so the append below must extend it
+    EXPECT_EQ(updateTracks({makeTrack(1)}), std::vector<int>{0});
+
+    appendTracks({makeTrack(2), makeTrack(1)});
+
+    const std::vector<int> expected{0, 1, 2};
+    EXPECT_EQ(updateTracks({makeTrack(1, u"One"_s), makeTrack(2, u"Two"_s)}), expected);
+    EXPECT_EQ(title(1), u"Two"_s);
+    EXPECT_EQ(title(2), u"One"_s);
+}
+
+TEST_F(PlaylistTest, UpdateAfterRemove)
+{
+    replaceTracks({makeTrack(1), makeTrack(2), makeTrack(3), makeTrack(1)});
+    EXPECT_EQ(updateTracks({makeTrack(3)}), std::vector<int>{2});
+
+    EXPECT_EQ(removeTracks({0}), std::vector<int>{0});
+
+    EXPECT_EQ(updateTracks({makeTrack(1, u"One"_s)}), std::vector<int>{2});
+    EXPECT_EQ(updateTracks({makeTrack(3, u"Three"_s)}), std::vector<int>{1});
+    EXPECT_EQ(title(1), u"Three"_s);
+    EXPECT_EQ(title(2), u"One"_s);
+}
+
+TEST_F(PlaylistTest, UpdateAfterReplace)
+{
+    replaceTracks({makeTrack(1), makeTrack(2)});
+    EXPECT_EQ(updateTracks({makeTrack(1)}), std::vector<int>{0});
+
+    replaceTracks({makeTrack(3), makeTrack(1)});
+
+    EXPECT_TRUE(updateTracks({makeTrack(2, u"Two"_s)}).empty());
+    EXPECT_EQ(updateTracks({makeTrack(1, u"One"_s)}), std::vector<int>{1});
+    EXPECT_EQ(title(1), u"One"_s);
+}
+
+TEST_F(PlaylistTest, UpdateAfterIdChange)
+{
+    replaceTracks({makeTrack(1), makeTrack(2)});
+    EXPECT_EQ(updateTracks({makeTrack(1)}), std::vector<int>{0});
+
+    // Same file, now stored under a different id
+    Track moved{makeTrack(1)};
+    moved.setId(5);
+    updateTrackAtIndex(0, moved);
+
+    EXPECT_TRUE(updateTracks({makeTrack(1, u"Old"_s)}).empty());
+
+    Track updated{moved};
+    updated.setTitle(u"New"_s);
+    EXPECT_EQ(updateTracks({updated}), std::vector<int>{0});
+    EXPECT_EQ(title(0), u"New"_s);
+}
+} // namespace Fooyin::Testing
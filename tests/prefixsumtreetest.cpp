@@ -0,0 +1,96 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/prefixsumtree.h>
+
+#include <gtest/gtest.h>
+
+#include <utility>
+
+namespace Fooyin::Testing {
+namespace {
+int linearIndexAt(const std::vector<int>& heights, int position)
+{
+    int y{0};
+    for(int i{0}; std::cmp_less(i, heights.size()); ++i) {
+        y += heights[i];
+        if(y > position) {
+            return i;
+        }
+    }
+    return -1;
+}
+} // namespace
+
+TEST(PrefixSumTreeTest, MatchesLinearScan)
+{
+    // Mix of header, subheader and track rows, including zero height rows
+    std::vector<int> heights;
+    for(int i{0}; i < 500; ++i) {
+        heights.push_back(i % 50 == 0 ? 60 : (i % 10 == 0 ? 0 : 22));
+    }
+
+    PrefixSumTree tree{heights};
+    heights[3]  = 40;
+    heights[10] = 22;
+    tree.set(3, 40);
+    tree.set(10, 22);
+
+    int total{0};
+    for(int i{0}; std::cmp_less(i, heights.size()); ++i) {
+        EXPECT_EQ(total, tree.prefix(i));
+        total += heights[i];
+    }
+    EXPECT_EQ(total, tree.total());
+
+    for(int position{-5}; position < total + 5; ++position) {
+        EXPECT_EQ(linearIndexAt(heights, position), tree.indexAt(position));
+    }
+}
+
+TEST(PrefixSumTreeTest, LargeViewport)
+{
+    constexpr int Count = 100000;
+
+    std::vector<int> heights(Count);
+    for(int i{0}; i < Count; ++i) {
+        heights[i] = i % 12 == 0 ? 48 : 20;
+    }
+
+    const PrefixSumTree tree{heights};
+    const int total = tree.total();
+
+    // The rows found for the top and bottom of a viewport at each scroll step from top to bottom
+    for(int value{0}; value < total; value += 20) {
+        const int first = tree.indexAt(value);
+        ASSERT_GE(first, 0);
+        ASSERT_LE(tree.prefix(first), value);
+        ASSERT_GT(tree.prefix(first) + heights[first], value);
+
+        const int last = tree.indexAt(value + 800);
+        if(last >= 0) {
+            ASSERT_GE(last, first);
+            ASSERT_LE(tree.prefix(last), value + 800);
+        }
+        else {
+            ASSERT_GE(value + 800, total);
+        }
+    }
+}
+} // namespace Fooyin::Testing
@@ -20,6 +20,9 @@
 #include <gui/scripting/scriptformatter.h>
 #include <gui/scripting/scriptformatterregistry.h>
 
+#include <QApplication>
+#include <QPalette>
+
 #include <gtest/gtest.h>
 
 namespace Fooyin::Testing {
@@ -55,4 +58,52 @@ TEST_F(ScriptFormatterTest, Rgb)
     ASSERT_EQ(1, result.size());
     EXPECT_EQ(255, result.front().format.colour.red());
 }
+
+TEST_F(ScriptFormatterTest, SharedCacheAcrossInstances)
+{
+    ScriptFormatter other;
+
+    const auto first  = m_formattter.evaluate(QStringLiteral("<b>Shared</b> between formatters."));
+    const auto second = other.evaluate(QStringLiteral("<b>Shared</b> between formatters."));
+
+    ASSERT_EQ(2, first.size());
+    EXPECT_EQ(first, second);
+    // A cached result is returned as a copy, so the block text is shared rather than reformatted
+    EXPECT_EQ(first.front().text.constData(), second.front().text.constData());
+}
+
+TEST_F(ScriptFormatterTest, SharedCacheFontChange)
+{
+    const auto input = QStringLiteral("Font change.");
+    const auto first = m_formattter.evaluate(input);
+
+    QFont font{first.front().format.font};
+    font.setPointSize(31);
+
+    ScriptFormatter other;
+    other.setBaseFont(font);
+    const auto second = other.evaluate(input);
+
+    ASSERT_EQ(1, second.size());
+    EXPECT_EQ(31, second.front().format.font.pointSize());
+    EXPECT_NE(first.front().text.constData(), second.front().text.constData());
+}
+
+TEST_F(ScriptFormatterTest, SharedCachePaletteChange)
+{
+    const auto input = QStringLiteral("Palette change.");
+
+    const QPalette oldPalette = QApplication::palette();
+    QPalette palette{oldPalette};
+    palette.setColor(QPalette::Text, QColor{1, 2, 3});
+
+    const auto first = m_formattter.evaluate(input);
+    QApplication::setPalette(palette);
+    const auto second = m_formattter.evaluate(input);
+    QApplication::setPalette(oldPalette);
+
+    ASSERT_EQ(1, second.size());
+    EXPECT_EQ(QColor(1, 2, 3), second.front().format.colour);
+    EXPECT_NE(first.front().format.colour, second.front().format.colour);
+}
 } // namespace Fooyin::Testing
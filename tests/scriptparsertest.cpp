@@ -154,6 +154,55 @@ TEST_F(ScriptParserTest, InfoTest)
     EXPECT_EQ(u"2", m_parser.evaluate(QStringLiteral("$info(channels)"), track));
 }
 
+TEST_F(ScriptParserTest, MemoTest)
+{
+    Track track{QStringLiteral("/music/track.flac")};
+    track.setArtists({QStringLiteral("The Verve")});
+
+    m_parser.setMemoiseFunctions(true);
+
+    EXPECT_EQ(u"THE VERVE", m_parser.evaluate(QStringLiteral("$upper(%artist%)"), track));
+    EXPECT_EQ(u"the verve", m_parser.evaluate(QStringLiteral("$lower($upper(%artist%))"), track));
+    EXPECT_EQ(u"THE VERVE - the verve",
+              m_parser.evaluate(QStringLiteral("$upper(%artist%) - $lower($upper(%artist%))"), track));
+    EXPECT_EQ(3U, m_parser.memoStats().hits);
+    EXPECT_EQ(2U, m_parser.memoStats().misses);
+
+    Track otherTrack{QStringLiteral("/music/other.flac")};
+    otherTrack.setArtists({QStringLiteral("Blur")});
+
+    EXPECT_EQ(u"BLUR", m_parser.evaluate(QStringLiteral("$upper(%artist%)"), otherTrack));
+    EXPECT_EQ(3U, m_parser.memoStats().misses);
+}
+
+TEST_F(ScriptParserTest, MemoSkipsStateTest)
+{
+    const Track track{QStringLiteral("/music/track.flac")};
+
+    m_parser.setMemoiseFunctions(true);
+
+    // Playback state changes between evaluations of the same track, so is never memoised
+    EXPECT_EQ(u"0", m_parser.evaluate(QStringLiteral("$upper(%playback_time_s%)"), track));
+    EXPECT_EQ(u"0", m_parser.evaluate(QStringLiteral("$upper(%playback_time_s%)"), track));
+    EXPECT_EQ(0U, m_parser.memoStats().hits);
+}
+
+TEST_F(ScriptParserTest, SharedCacheTest)
+{
+    const QString script = QStringLiteral("$upper(%title%) shared cache test");
+
+    m_parser.parse(script);
+    const ScriptCacheStats before = ScriptParser::sharedCacheStats();
+
+    ScriptParser otherParser;
+    const ParsedScript parsed = otherParser.parse(script);
+    const ScriptCacheStats after = ScriptParser::sharedCacheStats();
+
+    EXPECT_TRUE(parsed.isValid());
+    EXPECT_EQ(before.hits + 1, after.hits);
+    EXPECT_EQ(before.misses, after.misses);
+}
+
 TEST_F(ScriptParserTest, QueryTest)
 {
     TrackList tracks;
@@ -0,0 +1,95 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/sequencediff.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <utility>
+
+namespace Fooyin::Testing {
+namespace {
+std::vector<int> applyDiff(const std::vector<int>& oldKeys, const std::vector<int>& newKeys, const SequenceDiff& diff)
+{
+    std::vector<int> result;
+    for(int i{0}; std::cmp_less(i, oldKeys.size()); ++i) {
+        if(!std::ranges::binary_search(diff.removed, i)) {
+            result.push_back(oldKeys.at(i));
+        }
+    }
+    for(const int index : diff.inserted) {
+        result.insert(result.begin() + index, newKeys.at(index));
+    }
+    return result;
+}
+} // namespace
+
+TEST(SequenceDiffTest, Identical)
+{
+    const std::vector<int> keys{1, 2, 3, 4};
+    EXPECT_TRUE(diffSequences(keys, keys).empty());
+}
+
+TEST(SequenceDiffTest, InsertAndRemove)
+{
+    const std::vector<int> oldKeys{1, 2, 3, 4, 5};
+    const std::vector<int> newKeys{1, 3, 6, 7, 4, 5};
+
+    const auto diff = diffSequences(oldKeys, newKeys);
+
+    EXPECT_EQ(diff.removed, std::vector<int>{1});
+    EXPECT_EQ(diff.inserted, (std::vector<int>{2, 3}));
+    EXPECT_EQ(applyDiff(oldKeys, newKeys, diff), newKeys);
+}
+
+TEST(SequenceDiffTest, MoveIsMinimal)
+{
+    const std::vector<int> oldKeys{1, 2, 3, 4, 5, 6};
+    const std::vector<int> newKeys{2, 3, 4, 5, 6, 1};
+
+    const auto diff = diffSequences(oldKeys, newKeys);
+
+    EXPECT_EQ(diff.removed, std::vector<int>{0});
+    EXPECT_EQ(diff.inserted, std::vector<int>{5});
+    EXPECT_EQ(SequenceDiff::rangeCount(diff.inserted), 1);
+}
+
+TEST(SequenceDiffTest, RandomEdits)
+{
+    std::mt19937 rng{42};
+
+    for(int run{0}; run < 50; ++run) {
+        std::vector<int> oldKeys(200);
+        std::iota(oldKeys.begin(), oldKeys.end(), 0);
+
+        std::vector<int> newKeys;
+        std::ranges::copy_if(oldKeys, std::back_inserter(newKeys), [&rng](int) { return rng() % 5 != 0; });
+        for(int i{0}; i < 20; ++i) {
+            newKeys.insert(newKeys.begin() + static_cast<int>(rng() % (newKeys.size() + 1)), 1000 + i);
+        }
+        std::swap(newKeys[rng() % newKeys.size()], newKeys[rng() % newKeys.size()]);
+
+        const auto diff = diffSequences(oldKeys, newKeys);
+        EXPECT_EQ(applyDiff(oldKeys, newKeys, diff), newKeys);
+    }
+}
+} // namespace Fooyin::Testing
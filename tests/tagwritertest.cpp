@@ -22,10 +22,51 @@
 #include <core/engine/taglibparser.h>
 #include <core/track.h>
 
+#include <QBuffer>
+
 #include <gtest/gtest.h>
 
 // clazy:excludeall=returning-void-expression
 
+namespace {
+// Records where the writer touches the device
+class RecordingBuffer : public QBuffer
+{
+public:
+    using QBuffer::QBuffer;
+
+    std::vector<std::pair<qint64, qint64>> writes;
+    bool readAfterWrite{false};
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override
+    {
+        readAfterWrite |= !writes.empty();
+        return QBuffer::readData(data, maxSize);
+    }
+
+    qint64 writeData(const char* data, qint64 len) override
+    {
+        writes.emplace_back(pos(), len);
+        return QBuffer::writeData(data, len);
+    }
+};
+
+qint64 id3v2TagSize(const QByteArray& data)
+{
+    if(data.size() < 10 || !data.startsWith("ID3")) {
+        return -1;
+    }
+
+    // Header followed by a 28 bit syncsafe size
+    qint64 size{0};
+    for(int i{6}; i < 10; ++i) {
+        size = (size << 7) | (static_cast<quint8>(data.at(i)) & 0x7F);
+    }
+    return size + 10;
+}
+} // namespace
+
 namespace Fooyin::Testing {
 class TagWriterTest : public ::testing::Test
 {
@@ -277,6 +318,53 @@ TEST_F(TagWriterTest, Mp3Write)
     }
 }
 
+TEST_F(TagWriterTest, Mp3WriteInPlace)
+{
+    const QString filepath = QStringLiteral(":/audio/audiotest.mp3");
+    TempResource file{filepath};
+    file.checkValid();
+
+    AudioSource source;
+    source.filepath = file.fileName();
+    source.device   = &file;
+
+    Track track{file.fileName()};
+    ASSERT_TRUE(m_parser.readTrack(source, track));
+
+    track.setTitle(QStringLiteral("A Much Longer Test Title"));
+    ASSERT_TRUE(m_parser.writeTrack(source, track, {}));
+
+    ASSERT_TRUE(file.seek(0));
+    const QByteArray original = file.readAll();
+    const qint64 tagSize      = id3v2TagSize(original);
+    ASSERT_GT(tagSize, 0);
+    ASSERT_LT(tagSize, original.size());
+
+    RecordingBuffer buffer;
+    buffer.setData(original);
+    ASSERT_TRUE(buffer.open(QIODevice::ReadWrite | QIODevice::Unbuffered));
+    source.device = &buffer;
+
+    // A shorter tag fits in the padding left by the previous write
+    track.setTitle(QStringLiteral("Short"));
+    ASSERT_TRUE(m_parser.writeTrack(source, track, {}));
+
+    const QByteArray written = buffer.data();
+    ASSERT_EQ(written.size(), original.size());
+
+    // Only the tag was written, and only once the new tag had been fully built
+    ASSERT_FALSE(buffer.writes.empty());
+    for(const auto& [pos, length] : buffer.writes) {
+        EXPECT_LE(pos + length, tagSize);
+    }
+    EXPECT_FALSE(buffer.readAfterWrite);
+    EXPECT_EQ(written.sliced(tagSize), original.sliced(tagSize));
+
+    Track readTrack{file.fileName()};
+    ASSERT_TRUE(m_parser.readTrack(source, readTrack));
+    EXPECT_EQ(readTrack.title(), QStringLiteral("Short"));
+}
+
 TEST_F(TagWriterTest, OggWrite)
 {
     const QString filepath = QStringLiteral(":/audio/audiotest.ogg");
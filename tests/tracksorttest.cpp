@@ -0,0 +1,77 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/library/tracksort.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace Qt::StringLiterals;
+
+namespace Fooyin::Testing {
+TEST(TrackSortTest, NumericOrder)
+{
+    const std::vector<QString> fields{u"10"_s, u"2"_s, u"1"_s, u"b"_s, u"a"_s};
+
+    EXPECT_EQ((std::vector<int>{2, 1, 0, 4, 3}), TrackSorter::sortPermutation(fields));
+    EXPECT_EQ((std::vector<int>{3, 4, 0, 1, 2}), TrackSorter::sortPermutation(fields, Qt::DescendingOrder));
+}
+
+TEST(TrackSortTest, StableOrder)
+{
+    const std::vector<QString> fields{u"b"_s, u"a"_s, u"b"_s, u"a"_s};
+
+    EXPECT_EQ((std::vector<int>{1, 3, 0, 2}), TrackSorter::sortPermutation(fields));
+    EXPECT_EQ((std::vector<int>{0, 2, 1, 3}), TrackSorter::sortPermutation(fields, Qt::DescendingOrder));
+}
+
+TEST(TrackSortTest, ParallelMatchesSerial)
+{
+    constexpr int Count = 50000;
+
+    std::vector<QString> fields;
+    fields.reserve(Count);
+    for(int i{0}; i < Count; ++i) {
+        fields.push_back(QString::number(i % 97));
+    }
+
+    std::vector<int> expected(Count);
+    std::iota(expected.begin(), expected.end(), 0);
+    std::ranges::stable_sort(expected, [](int lhs, int rhs) { return lhs % 97 < rhs % 97; });
+
+    EXPECT_EQ(expected, TrackSorter::sortPermutation(fields));
+}
+
+TEST(TrackSortTest, TracksUntouched)
+{
+    Track first{u"/music/b.flac"_s};
+    first.setTitle(u"B"_s);
+    Track second{u"/music/a.flac"_s};
+    second.setTitle(u"A"_s);
+
+    const TrackList tracks{first, second};
+
+    TrackSorter sorter;
+    EXPECT_EQ((std::vector<int>{1, 0}), sorter.sortPermutation(u"%title%"_s, tracks));
+    EXPECT_TRUE(tracks.front().sort().isEmpty());
+    EXPECT_TRUE(tracks.back().sort().isEmpty());
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,98 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/audioutils.h>
+
+#include <QElapsedTimer>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+constexpr auto SampleRate   = 44100;
+constexpr auto TrackSeconds = 240;
+constexpr auto Iterations   = 10;
+// Matches the blocks the waveform generator accumulates each decoded buffer in
+constexpr auto BlockFrames = 16384;
+
+namespace Fooyin::Testing {
+namespace {
+std::vector<float> generateFrames(int channels)
+{
+    std::vector<float> samples(static_cast<size_t>(channels) * SampleRate * TrackSeconds);
+    for(size_t i{0}; i < samples.size(); ++i) {
+        const auto channel = static_cast<float>((i % channels) + 1);
+        samples[i]         = std::sin(static_cast<float>(i) * 0.013F) / channel;
+    }
+    return samples;
+}
+
+double throughputMBps(int channels)
+{
+    const auto samples = generateFrames(channels);
+    const auto frames  = static_cast<int>(samples.size() / channels);
+
+    double sumSquares{0.0};
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for(int i{0}; i < Iterations; ++i) {
+        std::vector<Audio::ChannelStats> stats(channels, {.min = 1.0F, .max = -1.0F});
+
+        for(int frame{0}; frame < frames; frame += BlockFrames) {
+            const int blockFrames = std::min(BlockFrames, frames - frame);
+            const std::span<const float> block{samples.data() + (static_cast<ptrdiff_t>(frame) * channels),
+                                               static_cast<size_t>(blockFrames) * channels};
+            Audio::accumulateFrames(block, channels, stats);
+        }
+
+        sumSquares += stats.front().sumSquares;
+    }
+
+    const auto elapsed = static_cast<double>(std::max<qint64>(1, timer.nsecsElapsed())) / 1e9;
+
+    EXPECT_GT(sumSquares, 0.0);
+
+    const double megabytes = static_cast<double>(samples.size() * sizeof(float)) * Iterations / (1024.0 * 1024.0);
+    return megabytes / elapsed;
+}
+
+void report(const char* name, int channels)
+{
+    const double mbps = throughputMBps(channels);
+
+    std::cout << name << ": " << static_cast<int>(mbps) << " MB/s\n";
+    ::testing::Test::RecordProperty(std::string{name} + "MBps", static_cast<int>(mbps));
+}
+} // namespace
+
+TEST(WaveformBenchmark, Stereo)
+{
+    report("Stereo", 2);
+}
+
+TEST(WaveformBenchmark, Surround51)
+{
+    report("Surround51", 6);
+}
+} // namespace Fooyin::Testing